@@ -175,6 +175,44 @@ namespace embree
   void os_advise(void *ptr, size_t bytes)
   {
   }
+
+  void os_bind_numa(void* ptr, size_t bytes, unsigned int node)
+  {
+  }
+
+  void* os_map_file(const char* fileName, size_t& bytes)
+  {
+    HANDLE file = CreateFileA(fileName,GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+      return nullptr;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file,&size) || size.QuadPart == 0) {
+      CloseHandle(file);
+      return nullptr;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file,nullptr,PAGE_WRITECOPY,0,0,nullptr);
+    CloseHandle(file);
+    if (mapping == nullptr)
+      return nullptr;
+
+    void* ptr = MapViewOfFile(mapping,FILE_MAP_COPY,0,0,0);
+    CloseHandle(mapping);
+    if (ptr == nullptr)
+      return nullptr;
+
+    bytes = (size_t) size.QuadPart;
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes)
+  {
+    if (ptr == nullptr)
+      return;
+
+    UnmapViewOfFile(ptr);
+  }
 }
 
 #endif
@@ -186,6 +224,9 @@ namespace embree
 #if defined(__UNIX__)
 
 #include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <errno.h>
 #include <stdlib.h>
 #include <string.h>
@@ -195,6 +236,10 @@ namespace embree
 #include <mach/vm_statistics.h>
 #endif
 
+#if defined(__LINUX__)
+#include <sys/syscall.h>
+#endif
+
 namespace embree
 {
   bool os_init(bool hugepages, bool verbose) 
@@ -314,6 +359,52 @@ namespace embree
     madvise(pptr,bytes,MADV_HUGEPAGE); 
 #endif
   }
+
+  /* prefers the given NUMA node for pages that get touched the first time */
+  void os_bind_numa(void* ptr, size_t bytes, unsigned int node)
+  {
+#if defined(__LINUX__) && defined(SYS_mbind)
+    if (node >= 8*sizeof(unsigned long)) return;
+    const unsigned long MPOL_PREFERRED = 1;
+    const unsigned long nodeMask = 1ul << node;
+
+    /* mbind requires a page aligned range */
+    const size_t begin = ((size_t)ptr + PAGE_SIZE_4K-1) & ~(PAGE_SIZE_4K-1);
+    const size_t end = ((size_t)ptr + bytes) & ~(PAGE_SIZE_4K-1);
+    if (begin >= end) return;
+    syscall(SYS_mbind,begin,end-begin,MPOL_PREFERRED,&nodeMask,8*sizeof(nodeMask),0); // on purpose only a hint
+#endif
+  }
+
+  void* os_map_file(const char* fileName, size_t& bytes)
+  {
+    int fd = open(fileName,O_RDONLY);
+    if (fd == -1)
+      return nullptr;
+
+    struct stat st;
+    if (fstat(fd,&st) == -1 || st.st_size == 0) {
+      close(fd);
+      return nullptr;
+    }
+
+    /* private mapping, pages that get written to are copied */
+    void* ptr = mmap(nullptr,st.st_size,PROT_READ|PROT_WRITE,MAP_PRIVATE,fd,0);
+    close(fd);
+    if (ptr == MAP_FAILED)
+      return nullptr;
+
+    bytes = (size_t) st.st_size;
+    return ptr;
+  }
+
+  void os_unmap_file(void* ptr, size_t bytes)
+  {
+    if (ptr == nullptr)
+      return;
+
+    munmap(ptr,bytes);
+  }
 }
 
 #endif
@@ -73,6 +73,11 @@ namespace embree
   size_t os_shrink (void* ptr, size_t bytesNew, size_t bytesOld, bool hugepages);
   void  os_free   (void* ptr, size_t bytes, bool hugepages);
   void  os_advise (void* ptr, size_t bytes);
+  void  os_bind_numa (void* ptr, size_t bytes, unsigned int node);
+
+  /*! maps a file copy-on-write into memory, returns nullptr on failure */
+  void* os_map_file (const char* fileName, size_t& bytes);
+  void  os_unmap_file (void* ptr, size_t bytes);
 
   /*! allocator that performs OS allocations */
   template<typename T>
@@ -0,0 +1,93 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "platform.h"
+#include "intrinsics.h"
+#include <atomic>
+
+namespace embree
+{
+  /*! Vector that grows without moving its items. The items are stored
+   *  in segments of exponentially increasing size that get published
+   *  through atomic pointers, thus threads can access items while other
+   *  threads grow the vector, and growing never invalidates references
+   *  to items. The vector never shrinks. */
+  template<typename T>
+    class segmented_vector
+    {
+      enum { LOG_FIRST_SEGMENT_SIZE = 6, MAX_SEGMENTS = 32 };
+
+    public:
+      typedef T value_type;
+
+      segmented_vector ()
+        : size_active(0)
+      {
+        for (size_t s=0; s<MAX_SEGMENTS; s++)
+          segments[s].store(nullptr,std::memory_order_relaxed);
+      }
+
+      ~segmented_vector ()
+      {
+        for (size_t s=0; s<MAX_SEGMENTS; s++)
+          delete[] segments[s].load();
+      }
+
+      segmented_vector (const segmented_vector& other) DELETED; // do not implement
+      segmented_vector& operator= (const segmented_vector& other) DELETED; // do not implement
+
+      /*! returns the number of items, all items below are accessible */
+      __forceinline size_t size() const { return size_active.load(std::memory_order_acquire); }
+      __forceinline bool empty() const { return size() == 0; }
+
+      __forceinline T& operator[] (size_t i)
+      {
+        const size_t j = i + (size_t(1) << LOG_FIRST_SEGMENT_SIZE);
+        const size_t k = bsr(j);
+        return segments[k-LOG_FIRST_SEGMENT_SIZE].load(std::memory_order_relaxed)[j-(size_t(1) << k)];
+      }
+
+      __forceinline const T& operator[] (size_t i) const
+      {
+        const size_t j = i + (size_t(1) << LOG_FIRST_SEGMENT_SIZE);
+        const size_t k = bsr(j);
+        return segments[k-LOG_FIRST_SEGMENT_SIZE].load(std::memory_order_relaxed)[j-(size_t(1) << k)];
+      }
+
+      /*! grows the vector to at least N value initialized items, multiple threads may grow the vector concurrently */
+      void grow(size_t N)
+      {
+        for (size_t s=0; ((size_t(1) << s)-1) << LOG_FIRST_SEGMENT_SIZE < N; s++)
+        {
+          assert(s < MAX_SEGMENTS);
+          if (segments[s].load() != nullptr) continue;
+          T* segment = new T[size_t(1) << (s+LOG_FIRST_SEGMENT_SIZE)]();
+          T* expected = nullptr;
+          if (!segments[s].compare_exchange_strong(expected,segment))
+            delete[] segment;
+        }
+
+        size_t n = size_active.load();
+        while (n < N && !size_active.compare_exchange_weak(n,N));
+      }
+
+    private:
+      std::atomic<size_t> size_active;
+      std::atomic<T*> segments[MAX_SEGMENTS]; //!< segment s stores the 2^s*64 items starting at item (2^s-1)*64
+    };
+}
@@ -348,6 +348,24 @@ namespace embree
     if (hasISA(features,AVX512SKX)) v += "AVX512SKX ";
     return v;
   }
+
+  static __thread int threadNumaNode = -1;
+
+  unsigned int getThreadNumaNode()
+  {
+    if (unlikely(threadNumaNode < 0))
+      threadNumaNode = (int) getNumaNode();
+    return (unsigned int) threadNumaNode;
+  }
+
+  static __thread int threadCacheDomain = -1;
+
+  unsigned int getThreadCacheDomain()
+  {
+    if (unlikely(threadCacheDomain < 0))
+      threadCacheDomain = (int) getCacheDomain();
+    return (unsigned int) threadCacheDomain;
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -398,6 +416,22 @@ namespace embree
     return nThreads;
   }
 
+  unsigned int getNumberOfNumaNodes()
+  {
+    ULONG highestNode = 0;
+    if (!GetNumaHighestNodeNumber(&highestNode)) return 1;
+    return (unsigned int) highestNode+1;
+  }
+
+  unsigned int getNumaNode()
+  {
+    PROCESSOR_NUMBER processor;
+    GetCurrentProcessorNumberEx(&processor);
+    USHORT node = 0;
+    if (!GetNumaProcessorNodeEx(&processor,&node) || node >= getNumberOfNumaNodes()) return 0;
+    return node;
+  }
+
   int getTerminalWidth() 
   {
     HANDLE handle = GetStdHandle(STD_OUTPUT_HANDLE);
@@ -444,6 +478,9 @@ namespace embree
 
 #include <stdio.h>
 #include <unistd.h>
+#include <sched.h>
+#include <sstream>
+#include <algorithm>
 
 namespace embree
 {
@@ -457,6 +494,105 @@ namespace embree
     return std::string(buf);
   }
 
+  /*! parses a list of the form 0-3,8,10-11 as used by sysfs */
+  static std::vector<unsigned int> parseSysfsList(const std::string& fileName)
+  {
+    std::vector<unsigned int> list;
+    std::ifstream file(fileName);
+    std::string str;
+    if (!std::getline(file,str)) return list;
+
+    std::stringstream stream(str);
+    std::string range;
+    while (std::getline(stream,range,','))
+    {
+      unsigned int first = 0, last = 0;
+      const int n = sscanf(range.c_str(),"%u-%u",&first,&last);
+      if (n < 1) continue;
+      if (n == 1) last = first;
+      for (unsigned int i=first; i<=last; i++)
+        list.push_back(i);
+    }
+    return list;
+  }
+
+  /*! maps each logical CPU to its NUMA node */
+  static const std::vector<unsigned int>& getCPUToNumaNodeTable()
+  {
+    static const std::vector<unsigned int> table = [] ()
+    {
+      std::vector<unsigned int> table;
+      for (unsigned int node : parseSysfsList("/sys/devices/system/node/online"))
+      {
+        for (unsigned int cpu : parseSysfsList("/sys/devices/system/node/node"+toString(node)+"/cpulist"))
+        {
+          if (cpu >= table.size()) table.resize(cpu+1,0);
+          table[cpu] = node;
+        }
+      }
+      return table;
+    } ();
+    return table;
+  }
+
+  unsigned int getNumberOfNumaNodes()
+  {
+    static const unsigned int numNodes = [] () {
+      unsigned int numNodes = 1;
+      for (unsigned int node : parseSysfsList("/sys/devices/system/node/online"))
+        numNodes = max(numNodes,node+1);
+      return numNodes;
+    } ();
+    return numNodes;
+  }
+
+  unsigned int getNumaNode()
+  {
+    const std::vector<unsigned int>& table = getCPUToNumaNodeTable();
+    const int cpu = sched_getcpu();
+    if (cpu < 0 || size_t(cpu) >= table.size()) return 0;
+    return table[cpu];
+  }
+
+  /*! maps each logical CPU to the lowest CPU sharing its last level cache */
+  static const std::vector<unsigned int>& getCPUToCacheDomainTable()
+  {
+    static const std::vector<unsigned int> table = [] ()
+    {
+      std::vector<unsigned int> table;
+      for (unsigned int cpu : parseSysfsList("/sys/devices/system/cpu/online"))
+      {
+        const std::string path = "/sys/devices/system/cpu/cpu"+toString(cpu)+"/cache/index";
+        unsigned int maxLevel = 0;
+        std::vector<unsigned int> shared;
+        for (unsigned int index=0; ; index++)
+        {
+          std::ifstream file(path+toString(index)+"/level");
+          unsigned int level = 0;
+          if (!(file >> level)) break;
+          if (level < maxLevel) continue;
+          std::vector<unsigned int> list = parseSysfsList(path+toString(index)+"/shared_cpu_list");
+          if (list.empty()) continue;
+          maxLevel = level;
+          shared = list;
+        }
+        if (shared.empty()) return std::vector<unsigned int>();
+        if (cpu >= table.size()) table.resize(cpu+1,0);
+        table[cpu] = *std::min_element(shared.begin(),shared.end());
+      }
+      return table;
+    } ();
+    return table;
+  }
+
+  unsigned int getCacheDomain()
+  {
+    const std::vector<unsigned int>& table = getCPUToCacheDomainTable();
+    const int cpu = sched_getcpu();
+    if (cpu < 0 || size_t(cpu) >= table.size()) return getNumaNode();
+    return table[cpu];
+  }
+
   size_t getVirtualMemoryBytes()
   {
     size_t virt, resident, shared;
@@ -476,6 +612,36 @@ namespace embree
 
 #endif
 
+////////////////////////////////////////////////////////////////////////////////
+/// Platforms without NUMA support
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(__WIN32__) && !defined(__LINUX__)
+
+namespace embree
+{
+  unsigned int getNumberOfNumaNodes() {
+    return 1;
+  }
+
+  unsigned int getNumaNode() {
+    return 0;
+  }
+}
+
+#endif
+
+#if !defined(__LINUX__)
+
+namespace embree
+{
+  unsigned int getCacheDomain() {
+    return getNumaNode();
+  }
+}
+
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 /// FreeBSD Platform
 ////////////////////////////////////////////////////////////////////////////////
@@ -586,4 +752,3 @@ namespace embree
   }
 }
 #endif
-
@@ -168,6 +168,21 @@ namespace embree
 
   /*! return the number of logical threads of the system */
   unsigned int getNumberOfLogicalThreads();
+
+  /*! returns the number of NUMA nodes of the system, one if NUMA is not supported */
+  unsigned int getNumberOfNumaNodes();
+
+  /*! returns the NUMA node of the hardware thread the caller runs on */
+  unsigned int getNumaNode();
+
+  /*! returns the NUMA node the calling thread ran on at its first call, cached per thread */
+  unsigned int getThreadNumaNode();
+
+  /*! returns an ID of the last level cache shared by the hardware thread the caller runs on, the NUMA node where this is unknown */
+  unsigned int getCacheDomain();
+
+  /*! returns the cache domain the calling thread ran on at its first call, cached per thread */
+  unsigned int getThreadCacheDomain();
   
   /*! returns the size of the terminal window in characters */
   int getTerminalWidth();
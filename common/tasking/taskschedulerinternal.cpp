@@ -38,15 +38,19 @@ namespace embree
       /*! some rounds that yield */
       for (size_t i=0; i<32; i++)
       {
-        /*! some spinning rounds */
-        const size_t threadCount = thread.threadCount();
-        for (size_t j=0; j<1024; j+=threadCount)
+        /*! some spinning rounds with exponential back-off */
+        size_t backoff = MIN_STEAL_BACKOFF;
+        while (backoff <= MAX_STEAL_BACKOFF)
         {
           if (!pred()) return;
           if (thread.scheduler->steal_from_other_threads(thread)) {
-            i=j=0;
+            i=0; backoff = MIN_STEAL_BACKOFF;
             body();
           }
+          else {
+            pause_cpu(backoff);
+            backoff *= 2;
+          }
         }
         yield();
       }
@@ -119,20 +123,37 @@ namespace embree
   {
     size_t l = left;
     size_t r = right;
-    if (l < r)
+    if (l >= r)
+      return false;
+
+    /* estimate the work waiting in this queue, tasks on the left are the largest ones */
+    size_t work = 0;
+    for (size_t i=l; i<min(r,l+MAX_STEAL_SCAN); i++)
+      if (tasks[i].state == Task::INITIALIZED) work += tasks[i].N;
+
+    /* steal tasks from the left until we got half of the work, all but
+     * the last stolen task stay available for stealing by other threads */
+    const size_t first = thread.tasks.right;
+    size_t stolen = 0;
+    size_t numStolen = 0;
+    while ((numStolen == 0 || 2*stolen < work) && thread.tasks.right < TASK_STACK_SIZE)
     {
       l = left++;
-       if (l >= r)
-         return false;
+      if (l >= right) break;
+      const size_t N = tasks[l].N;
+      if (!tasks[l].try_steal(thread.tasks.tasks[thread.tasks.right], 2*(stolen+N) < work))
+        break;
+
+      thread.tasks.right++;
+      stolen += N;
+      numStolen++;
     }
-    else
-      return false;
 
-    if (!tasks[l].try_steal(thread.tasks.tasks[thread.tasks.right]))
-      return false;
+    /* make the tasks we stole available to other threads */
+    if (numStolen > 1 && thread.tasks.left > first)
+      thread.tasks.left = first;
 
-    thread.tasks.right++;
-    return true;
+    return numStolen != 0;
   }
 
   /* we steal from the left */
@@ -214,13 +235,29 @@ namespace embree
 
   dll_export void TaskScheduler::ThreadPool::remove(const Ref<TaskScheduler>& scheduler)
   {
-    Lock<MutexSys> lock(mutex);
-    for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++) {
-      if (scheduler == *it) {
-        schedulers.erase(it);
-        return;
+    {
+      Lock<MutexSys> lock(mutex);
+      for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++) {
+        if (scheduler == *it) {
+          schedulers.erase(it);
+          break;
+        }
       }
     }
+    /* threads waiting for a scheduler with free thread slots may find one now */
+    condition.notify_all();
+  }
+
+  TaskScheduler* TaskScheduler::ThreadPool::select()
+  {
+    TaskScheduler* best = nullptr;
+    for (std::list<Ref<TaskScheduler> >::iterator it = schedulers.begin(); it != schedulers.end(); it++)
+    {
+      TaskScheduler* scheduler = it->ptr;
+      if (!scheduler->acceptsThreads()) continue;
+      if (!best || scheduler->priority > best->priority) best = scheduler;
+    }
+    return best;
   }
 
   void TaskScheduler::ThreadPool::thread_loop(size_t globalThreadIndex)
@@ -231,17 +268,17 @@ namespace embree
       ssize_t threadIndex = -1;
       {
         Lock<MutexSys> lock(mutex);
-        condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || !schedulers.empty(); });
+        condition.wait(mutex, [&] () { return globalThreadIndex >= numThreadsRunning || select() != nullptr; });
         if (globalThreadIndex >= numThreadsRunning) break;
-        scheduler = schedulers.front();
+        scheduler = select();
         threadIndex = scheduler->allocThreadIndex();
       }
       scheduler->thread_loop(threadIndex);
     }
   }
 
-  TaskScheduler::TaskScheduler()
-    : threadCounter(0), anyTasksRunning(0), hasRootTask(false)
+  TaskScheduler::TaskScheduler(size_t maxThreads, int priority)
+    : maxThreads(maxThreads), priority(priority), threadCounter(0), anyTasksRunning(0), hasRootTask(false)
   {
     threadLocal.resize(2*getNumberOfLogicalThreads()); // FIXME: this has to be 2x as in the compatibility join mode with rtcCommitScene the worker threads also join. When disallowing rtcCommitScene to join a build we can remove the 2x.
     for (size_t i=0; i<threadLocal.size(); i++)
@@ -267,7 +304,12 @@ namespace embree
     else        return 0;
   }
 
-  dll_export size_t TaskScheduler::threadCount() {
+  dll_export size_t TaskScheduler::threadCount()
+  {
+    /* threads of a scheduler with a thread budget see only the budget */
+    Thread* thread = TaskScheduler::thread();
+    if (thread && thread->scheduler->maxThreads)
+      return min(thread->scheduler->maxThreads,threadPool->size());
     return threadPool->size();
   }
 
@@ -387,19 +429,27 @@ namespace embree
   {
     const size_t threadIndex = thread.threadIndex;
     const size_t threadCount = this->threadCounter;
+    if (threadCount <= 1) return false;
 
-    for (size_t i=1; i<threadCount; i++)
+    /* visit victims starting at a random thread, first the threads
+     * sharing our last level cache, then the threads of our NUMA
+     * node, and finally all other threads */
+    const size_t start = thread.random() % threadCount;
+    for (size_t distance=0; distance<3; distance++)
     {
-      pause_cpu(32);
-      size_t otherThreadIndex = threadIndex+i;
-      if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
+      for (size_t i=0; i<threadCount; i++)
+      {
+        size_t otherThreadIndex = start+i;
+        if (otherThreadIndex >= threadCount) otherThreadIndex -= threadCount;
+        if (otherThreadIndex == threadIndex) continue;
 
-      Thread* othread = threadLocal[otherThreadIndex].load();
-      if (!othread)
-        continue;
+        Thread* othread = threadLocal[otherThreadIndex].load();
+        if (!othread || thread.distance(*othread) != distance)
+          continue;
 
-      if (othread->tasks.steal(thread))
-        return true;
+        if (othread->tasks.steal(thread))
+          return true;
+      }
     }
 
     return false;
@@ -24,6 +24,7 @@
 #include "../sys/condition.h"
 #include "../sys/ref.h"
 #include "../sys/atomic.h"
+#include "../sys/sysinfo.h"
 #include "../math/range.h"
 #include "../../include/embree3/rtcore.h"
 
@@ -43,6 +44,9 @@ namespace embree
 
     static const size_t TASK_STACK_SIZE = 4*1024;           //!< task structure stack
     static const size_t CLOSURE_STACK_SIZE = 512*1024;    //!< stack for task closures
+    static const size_t MIN_STEAL_BACKOFF = 32;           //!< pause cycles after the first failed steal attempt
+    static const size_t MAX_STEAL_BACKOFF = 1024;         //!< pause cycles the back-off between steal attempts is limited to
+    static const size_t MAX_STEAL_SCAN = 64;              //!< number of queued tasks considered to estimate the work of a victim
 
     struct Thread;
 
@@ -97,18 +101,18 @@ namespace embree
       }
 
       /*! construction of stolen task, stealing thread will decrement initial dependency */
-      __forceinline Task (TaskFunction* closure, Task* parent)
-        : dependencies(1), stealable(false), closure(closure), parent(parent), stackPtr(-1), N(1)
+      __forceinline Task (TaskFunction* closure, Task* parent, size_t N, bool stealable)
+        : dependencies(1), stealable(stealable), closure(closure), parent(parent), stackPtr(-1), N(N)
       {
 	switch_state(DONE,INITIALIZED);
       }
 
-      /*! try to steal this task */
-      bool try_steal(Task& child)
+      /*! try to steal this task, the stolen task may get stolen again if it is not executed right away */
+      bool try_steal(Task& child, bool restealable = false)
       {
         if (!stealable) return false;
 	if (!try_switch_state(INITIALIZED,DONE)) return false;
-	new (&child) Task(closure, this);
+	new (&child) Task(closure, this, N, restealable);
         return true;
       }
 
@@ -182,16 +186,37 @@ namespace embree
       ALIGNED_STRUCT_(64);
 
       Thread (size_t threadIndex, const Ref<TaskScheduler>& scheduler)
-      : threadIndex(threadIndex), task(nullptr), scheduler(scheduler) {}
+      : threadIndex(threadIndex), numaNode(getThreadNumaNode()), cacheDomain(getThreadCacheDomain()),
+        task(nullptr), scheduler(scheduler), randomState(0x9E3779B97F4A7C15ull*(threadIndex+1)) {}
 
       __forceinline size_t threadCount() {
         return scheduler->threadCounter;
       }
 
+      /*! returns 0 for threads sharing the last level cache, 1 for threads on the same NUMA node, and 2 otherwise */
+      __forceinline size_t distance(const Thread& other) const
+      {
+        if (cacheDomain == other.cacheDomain) return 0;
+        if (numaNode == other.numaNode) return 1;
+        return 2;
+      }
+
+      /*! xorshift random number generator used for victim selection */
+      __forceinline size_t random()
+      {
+        randomState ^= randomState << 13;
+        randomState ^= randomState >> 7;
+        randomState ^= randomState << 17;
+        return size_t(randomState);
+      }
+
       size_t threadIndex;              //!< ID of this thread
+      unsigned int numaNode;           //!< NUMA node this thread runs on
+      unsigned int cacheDomain;        //!< last level cache this thread runs on
       TaskQueue tasks;                 //!< local task queue
       Task* task;                      //!< current active task
       Ref<TaskScheduler> scheduler;     //!< pointer to task scheduler
+      unsigned long long randomState;  //!< state of the victim selection random number generator
     };
 
     /*! pool of worker threads */
@@ -218,6 +243,10 @@ namespace embree
       /*! main loop for all threads */
       void thread_loop(size_t threadIndex);
 
+    private:
+      /*! returns the scheduler of highest priority that can take another thread */
+      TaskScheduler* select();
+
     private:
       std::atomic<size_t> numThreads;
       std::atomic<size_t> numThreadsRunning;
@@ -231,9 +260,14 @@ namespace embree
       std::list<Ref<TaskScheduler> > schedulers;
     };
 
-    TaskScheduler ();
+    TaskScheduler (size_t maxThreads = 0, int priority = 0);
     ~TaskScheduler ();
 
+    /*! returns true if another thread of the pool may join this scheduler */
+    __forceinline bool acceptsThreads() const {
+      return maxThreads == 0 || threadCounter < maxThreads;
+    }
+
     /*! initializes the task scheduler */
     static void create(size_t numThreads, bool set_affinity, bool start_threads);
 
@@ -367,6 +401,8 @@ namespace embree
 
   private:
     std::vector<atomic<Thread*>> threadLocal;
+    size_t maxThreads;                     //!< maximal number of threads working on this scheduler, zero for no limit
+    int priority;                          //!< idle threads join the schedulers of highest priority first
     std::atomic<size_t> threadCounter;
     std::atomic<size_t> anyTasksRunning;
     std::atomic<bool> hasRootTask;
@@ -166,6 +166,14 @@ enum RTCBuildQuality
   RTC_BUILD_QUALITY_REFIT  = 3,
 };
 
+/* Build priorities of scene commits */
+enum RTCBuildPriority
+{
+  RTC_BUILD_PRIORITY_LOW    = 0,
+  RTC_BUILD_PRIORITY_NORMAL = 1,
+  RTC_BUILD_PRIORITY_HIGH   = 2,
+};
+
 /* Axis-aligned bounding box representation */
 struct RTC_ALIGN(16) RTCBounds
 {
@@ -185,7 +193,8 @@ enum RTCIntersectContextFlags
 {
   RTC_INTERSECT_CONTEXT_FLAG_NONE       = 0,
   RTC_INTERSECT_CONTEXT_FLAG_INCOHERENT = (0 << 0), // optimize for incoherent rays
-  RTC_INTERSECT_CONTEXT_FLAG_COHERENT   = (1 << 0)  // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_COHERENT   = (1 << 0), // optimize for coherent rays
+  RTC_INTERSECT_CONTEXT_FLAG_TRAVERSAL_STATISTICS = (1 << 1) // count traversal steps of every single ray traced with this context
 };
 
 /* Arguments for RTCFilterFunctionN */
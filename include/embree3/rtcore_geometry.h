@@ -142,6 +142,15 @@ struct RTCDisplacementFunctionNArguments
 /* Displacement mapping callback function */
 typedef void (*RTCDisplacementFunctionN)(const struct RTCDisplacementFunctionNArguments* args);
 
+/* Camera description for view dependent tessellation */
+struct RTCTessellationCamera
+{
+  float viewProjection[16]; // column major transformation from world space to clip space
+  unsigned int width;       // horizontal resolution in pixels
+  unsigned int height;      // vertical resolution in pixels
+  float edgeLength;         // target length of tessellated edges in pixels
+};
+
 /* Creates a new geometry of specified type. */
 RTC_API RTCGeometry rtcNewGeometry(RTCDevice device, enum RTCGeometryType type);
 
@@ -193,6 +202,9 @@ RTC_API void* rtcGetGeometryBufferData(RTCGeometry geometry, enum RTCBufferType
 /* Updates a geometry buffer. */
 RTC_API void rtcUpdateGeometryBuffer(RTCGeometry geometry, enum RTCBufferType type, unsigned int slot);
 
+/* Updates a range of items of a geometry buffer. */
+RTC_API void rtcUpdateGeometryBufferRange(RTCGeometry geometry, enum RTCBufferType type, unsigned int slot, size_t itemOffset, size_t itemCount);
+
 
 /* Sets the intersection filter callback function of the geometry. */
 RTC_API void rtcSetGeometryIntersectFilterFunction(RTCGeometry geometry, RTCFilterFunctionN filter);
@@ -244,6 +256,9 @@ RTC_API void rtcGetGeometryTransform(RTCGeometry geometry, float time, enum RTCF
 /* Sets the uniform tessellation rate of the geometry. */
 RTC_API void rtcSetGeometryTessellationRate(RTCGeometry geometry, float tessellationRate);
 
+/* Sets the camera used to calculate view dependent tessellation rates of the geometry. */
+RTC_API void rtcSetGeometryTessellationCamera(RTCGeometry geometry, const struct RTCTessellationCamera* camera);
+
 /* Sets the number of topologies of a subdivision surface. */
 RTC_API void rtcSetGeometryTopologyCount(RTCGeometry geometry, unsigned int topologyCount);
 
@@ -39,7 +39,8 @@ enum RTCSceneFlags
   RTC_SCENE_FLAG_DYNAMIC                 = (1 << 0),
   RTC_SCENE_FLAG_COMPACT                 = (1 << 1),
   RTC_SCENE_FLAG_ROBUST                  = (1 << 2),
-  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3)
+  RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION = (1 << 3),
+  RTC_SCENE_FLAG_ASYNC_COMMIT            = (1 << 4)
 };
 
 /* Creates a new scene. */
@@ -71,6 +72,12 @@ RTC_API void rtcCommitScene(RTCScene scene);
 /* Commits the scene from multiple threads. */
 RTC_API void rtcJoinCommitScene(RTCScene scene);
 
+/* Commits the scene in the background, ray queries keep using the previously committed scene. */
+RTC_API void rtcCommitSceneAsync(RTCScene scene);
+
+/* Waits for a background commit of the scene to finish. */
+RTC_API void rtcWaitCommitScene(RTCScene scene);
+
 
 /* Progress monitor callback function */
 typedef bool (*RTCProgressMonitorFunction)(void* ptr, double n);
@@ -81,6 +88,12 @@ RTC_API void rtcSetSceneProgressMonitorFunction(RTCScene scene, RTCProgressMonit
 /* Sets the build quality of the scene. */
 RTC_API void rtcSetSceneBuildQuality(RTCScene scene, enum RTCBuildQuality quality);
 
+/* Sets the maximal number of threads used to commit the scene, zero uses all threads. */
+RTC_API void rtcSetSceneBuildThreads(RTCScene scene, unsigned int maxThreads);
+
+/* Sets the priority of commits of the scene. */
+RTC_API void rtcSetSceneBuildPriority(RTCScene scene, enum RTCBuildPriority priority);
+
 /* Sets the scene flags. */
 RTC_API void rtcSetSceneFlags(RTCScene scene, enum RTCSceneFlags flags);
 
@@ -90,6 +103,77 @@ RTC_API void rtc_AT_SetNextBVHArguments(RTCScene hscene,const struct RTCBuildArg
 /* Returns the scene next argumets for BVH. */
 RTC_API struct RTCBuildArguments rtc_AT_GetNextBVHArguments(RTCScene hscene);
 
+/* Arguments for the BVH autotuner. */
+struct RTCAutotuneArguments
+{
+  size_t byteSize;
+
+  unsigned int numRays;        // number of rays of the workload
+  unsigned int numRepetitions; // trace measurements per candidate, the fastest one is used
+  unsigned int numPasses;      // coordinate descent passes over the search space
+  unsigned int seed;           // seed for sampling rays inside the scene bounds
+  struct RTCRayHit* rays;      // optional application rays, sampled rays are used if NULL
+};
+
+/* Returns the default autotuner arguments. */
+RTC_FORCEINLINE struct RTCAutotuneArguments rtc_AT_DefaultAutotuneArguments()
+{
+  struct RTCAutotuneArguments args;
+  args.byteSize = sizeof(args);
+  args.numRays = 16*1024;
+  args.numRepetitions = 3;
+  args.numPasses = 1;
+  args.seed = 0;
+  args.rays = NULL;
+  return args;
+}
+
+/* Searches the build arguments with the lowest trace cost for the scene, stores them as next BVH arguments, and commits the scene. */
+RTC_API void rtc_AT_AutotuneScene(RTCScene hscene, const struct RTCAutotuneArguments* args);
+
+
+/* Statistics of the last scene commit, gathered when the device got created with build_statistics=1. */
+struct RTCSceneBuildStatistics
+{
+  double buildTime;         // time of the entire commit in seconds
+  double primRefTime;       // time spent creating primitive references
+  double binningTime;       // time spent building hierarchies using object binning
+  double spatialSplitTime;  // time spent pre-splitting primitives and building hierarchies using spatial splits
+  double leafTime;          // time spent creating leaves, summed over all build threads
+  double layoutTime;        // time spent in the layout optimization of large nodes
+  double allocatorTime;     // time spent setting up node allocators
+
+  size_t numPrimitives;     // number of primitives in all acceleration structures
+  size_t numInnerNodes;     // number of inner nodes of all acceleration structures
+  size_t numLeaves;         // number of leaves of all acceleration structures
+  double sahCost;           // SAH cost summed over all acceleration structures
+
+  size_t allocatedBytes;    // bytes allocated by the node allocators
+  size_t usedBytes;         // bytes used for nodes and leaves
+  size_t wastedBytes;       // bytes wasted by the node allocators
+};
+
+/* Returns statistics of the last commit of the scene. */
+RTC_API void rtcGetSceneBuildStatistics(RTCScene scene, struct RTCSceneBuildStatistics* statistics);
+
+/* Traversal statistics of sampled rays, gathered without rebuilding Embree with statistics counters. */
+struct RTCTraversalStatistics
+{
+  size_t numRays;            // number of sampled rays
+  size_t numNodes;           // number of inner nodes visited by sampled rays
+  size_t numLeaves;          // number of leaves visited by sampled rays
+  size_t numPrimitiveTests;  // number of primitive blocks tested by sampled rays
+  size_t numFilterCalls;     // number of filter function invocations of sampled rays
+};
+
+/* Samples every sampleRate'th single ray of each thread for the traversal statistics of the scene, a rate of 0 disables sampling. */
+RTC_API void rtcSetSceneTraversalStatisticsRate(RTCScene scene, unsigned int sampleRate);
+
+/* Returns the traversal statistics gathered since the last reset. */
+RTC_API void rtcGetSceneTraversalStatistics(RTCScene scene, struct RTCTraversalStatistics* statistics);
+
+/* Resets the traversal statistics of the scene. */
+RTC_API void rtcResetSceneTraversalStatistics(RTCScene scene);
 
 /* Returns the scene flags. */
 RTC_API enum RTCSceneFlags rtcGetSceneFlags(RTCScene scene);
@@ -112,6 +196,17 @@ RTC_API bool rtcPointQuery8(const int* valid, RTCScene scene, struct RTCPointQue
 /* Perform a closest point query with a packet of 4 points with the scene. */
 RTC_API bool rtcPointQuery16(const int* valid, RTCScene scene, struct RTCPointQuery16* query, struct RTCPointQueryContext* context, RTCPointQueryFunction queryFunc, void** userPtr);
 
+/* Neighbor returned by a k-nearest neighbor point query */
+struct RTCPointQueryNeighbor
+{
+  unsigned int geomID; // geometry ID of the point
+  unsigned int primID; // primitive ID of the point
+  float distance;      // distance of the point center to the query position
+};
+
+/* Finds the k points of the scene closest to the query position within the query radius. */
+RTC_API unsigned int rtcPointQueryKNN(RTCScene scene, struct RTCPointQuery* query, unsigned int k, struct RTCPointQueryNeighbor* neighbors);
+
 /* Intersects a single ray with the scene. */
 RTC_API void rtcIntersect1(RTCScene scene, struct RTCIntersectContext* context, struct RTCRayHit* rayhit);
 
@@ -166,6 +261,13 @@ typedef void (*RTCCollideFunc) (void* userPtr, struct RTCCollision* collisions,
 
 /*! Performs collision detection of two scenes */
 RTC_API void rtcCollide (RTCScene scene0, RTCScene scene1, RTCCollideFunc callback, void* userPtr);
+
+/*! continuous collision callback */
+struct RTCContinuousCollision { unsigned int geomID0; unsigned int primID0; unsigned int geomID1; unsigned int primID1; float time; };
+typedef void (*RTCContinuousCollideFunc) (void* userPtr, struct RTCContinuousCollision* collisions, unsigned int num_collisions);
+
+/*! Performs continuous collision detection of two scenes over a time interval */
+RTC_API void rtcCollideContinuous (RTCScene scene0, RTCScene scene1, float time0, float time1, RTCContinuousCollideFunc callback, void* userPtr);
  
 #if defined(__cplusplus)
 
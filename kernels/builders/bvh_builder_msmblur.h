@@ -510,8 +510,8 @@ namespace embree
             for (size_t i=0; i<children.size(); i++) {
               values[i] = createLargeLeaf(children[i],alloc);
               gbounds.extend(values[i].lbounds);
-              setNode(node,i,values[i]);
             }
+            setNode(node,values,children.size());
 
             /* calculate geometry bounds of this node */
             if (hasTimeSplits)
@@ -602,7 +602,6 @@ namespace embree
               parallel_for(size_t(0), children.size(), [&] (const range<size_t>& r) {
                   for (size_t i=r.begin(); i<r.end(); i++) {
                     values[i] = recurse(children[i],nullptr,true);
-                    setNode(node,i,values[i]);
                     _mm_mfence(); // to allow non-temporal stores during build
                   }
                 });
@@ -618,10 +617,12 @@ namespace embree
               for (ssize_t i=children.size()-1; i>=0; i--) {
                 values[i] = recurse(children[i],alloc,false);
                 gbounds.extend(values[i].lbounds);
-                setNode(node,i,values[i]);
               }
             }
 
+            /* children are set after recursion as quantized nodes require the bounds of all children */
+            setNode(node,values,children.size());
+
             /* calculate geometry bounds of this node */
             if (unlikely(hasTimeSplits))
               return NodeRecordMB4D(node,current.prims.linearBounds(recalculatePrimRef),current.prims.time_range);
@@ -242,11 +242,12 @@ namespace embree
             NodeRef node = createAlignedNodeMB(alloc,timesplit);
 
             LBBox3fa bounds = empty;
+            NodeRecordMB4D values[MAX_BRANCHING_FACTOR];
             for (size_t i=0; i<children.size(); i++) {
-              const auto child = createLargeLeaf(children[i],alloc);
-              setAlignedNodeMB(node,i,child);
-              bounds.extend(child.lbounds);
+              values[i] = createLargeLeaf(children[i],alloc);
+              bounds.extend(values[i].lbounds);
             }
+            setAlignedNodeMB(node,values,children.size());
 
             if (timesplit)
               bounds = current.prims.linearBounds(recalculatePrimRef);
@@ -375,25 +376,24 @@ namespace embree
             if (timesplit)
             {
               const NodeRef node = createAlignedNodeMB(alloc,true);
+              NodeRecordMB4D values[MAX_BRANCHING_FACTOR];
 
               /* spawn tasks or ... */
               if (current.size() > SINGLE_THREADED_THRESHOLD)
               {
                 parallel_for(size_t(0), children.size(), [&] (const range<size_t>& r) {
                     for (size_t i=r.begin(); i<r.end(); i++) {
-                      const auto child = recurse(children[i],nullptr,true);
-                      setAlignedNodeMB(node,i,child);
+                      values[i] = recurse(children[i],nullptr,true);
                       _mm_mfence(); // to allow non-temporal stores during build
                     }
                   });
               }
               /* ... continue sequential */
               else {
-                for (size_t i=0; i<children.size(); i++) {
-                  const auto child = recurse(children[i],alloc,false);
-                  setAlignedNodeMB(node,i,child);
-                }
+                for (size_t i=0; i<children.size(); i++)
+                  values[i] = recurse(children[i],alloc,false);
               }
+              setAlignedNodeMB(node,values,children.size());
 
               const LBBox3fa bounds = current.prims.linearBounds(recalculatePrimRef);
               return NodeRecordMB4D(node,bounds,current.prims.time_range);
@@ -403,37 +403,33 @@ namespace embree
             else if (aligned)
             {
               const NodeRef node = createAlignedNodeMB(alloc,false);
+              NodeRecordMB4D values[MAX_BRANCHING_FACTOR];
 
               /* spawn tasks or ... */
               if (current.size() > SINGLE_THREADED_THRESHOLD)
               {
-                LBBox3fa cbounds[MAX_BRANCHING_FACTOR];
                 parallel_for(size_t(0), children.size(), [&] (const range<size_t>& r) {
                     for (size_t i=r.begin(); i<r.end(); i++) {
-                      const auto child = recurse(children[i],nullptr,true);
-                      setAlignedNodeMB(node,i,child);
-                      cbounds[i] = child.lbounds;
+                      values[i] = recurse(children[i],nullptr,true);
                       _mm_mfence(); // to allow non-temporal stores during build
                     }
                   });
-
-                LBBox3fa bounds = empty;
-                for (size_t i=0; i<children.size(); i++)
-                  bounds.extend(cbounds[i]);
-
-                return NodeRecordMB4D(node,bounds,current.prims.time_range);
               }
               /* ... continue sequentially */
               else
               {
-                LBBox3fa bounds = empty;
-                for (size_t i=0; i<children.size(); i++) {
-                  const auto child = recurse(children[i],alloc,false);
-                  setAlignedNodeMB(node,i,child);
-                  bounds.extend(child.lbounds);
-                }
-                return NodeRecordMB4D(node,bounds,current.prims.time_range);
+                for (size_t i=0; i<children.size(); i++)
+                  values[i] = recurse(children[i],alloc,false);
               }
+
+              /* children are set after recursion as quantized nodes require the bounds of all children */
+              setAlignedNodeMB(node,values,children.size());
+
+              LBBox3fa bounds = empty;
+              for (size_t i=0; i<children.size(); i++)
+                bounds.extend(values[i].lbounds);
+
+              return NodeRecordMB4D(node,bounds,current.prims.time_range);
             }
 
             /* create unaligned node */
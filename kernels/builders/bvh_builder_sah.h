@@ -38,7 +38,7 @@ namespace embree
 
     struct GeneralBVHBuilder
     {
-      static const size_t MAX_BRANCHING_FACTOR = 8;        //!< maximum supported BVH branching factor
+      static const size_t MAX_BRANCHING_FACTOR = 16;       //!< maximum supported BVH branching factor
       static const size_t MIN_LARGE_LEAF_LEVELS = 8;        //!< create balanced tree of we are that many levels before the maximum tree depth
 
       /*! settings for SAH builder */
@@ -16,6 +16,8 @@
 
 #include "bvh.h"
 #include "bvh_statistics.h"
+#include "../geometry/instance.h"
+#include "../geometry/object.h"
 
 namespace embree
 {
@@ -23,8 +25,9 @@ namespace embree
   BVHN<N>::BVHN (const PrimitiveType& primTy, Scene* scene)
     : AccelData((N==4) ? AccelData::TY_BVH4 : (N==8) ? AccelData::TY_BVH8 : AccelData::TY_UNKNOWN),
       primTy(&primTy), device(scene->device), scene(scene),
-      root(emptyNode), alloc(scene->device,scene->isStaticAccel()), numPrimitives(0), numVertices(0)
+      root(emptyNode), alloc(scene->device,scene->isStaticAccel()), mappedPtr(nullptr), mappedBytes(0), numaRoots(nullptr), numPrimitives(0), numVertices(0), leafNanoSeconds(0)
   {
+    memset(&buildStatistics,0,sizeof(buildStatistics));
   }
 
   template<int N>
@@ -32,13 +35,18 @@ namespace embree
   {
     for (size_t i=0; i<objects.size(); i++) 
       delete objects[i];
+    clearReplicas();
+    os_unmap_file(mappedPtr,mappedBytes);
   }
 
   template<int N>
   void BVHN<N>::clear()
   {
     set(BVHN::emptyNode,empty,0);
+    clearReplicas();
     alloc.clear();
+    os_unmap_file(mappedPtr,mappedBytes);
+    mappedPtr = nullptr; mappedBytes = 0;
   }
 
   template<int N>
@@ -122,9 +130,156 @@ namespace embree
     else return node;
   }
 
+  /*! number of BVH levels replicated per NUMA node */
+  static const size_t numaReplicationDepth = 3;
+
+  template<int N>
+  void BVHN<N>::replicate()
+  {
+    clearReplicas();
+    if (!device->numa || !root.isAlignedNode())
+      return;
+
+    const size_t numNodes = getNumberOfNumaNodes();
+    if (numNodes < 2)
+      return;
+
+    /* copy the top levels into memory bound to each node, lower levels are shared */
+    const size_t bytes = countReplicatedNodes(root,0)*sizeof(AlignedNode);
+    numaRoots = new NodeRef[numNodes];
+    for (size_t i=0; i<numNodes; i++)
+    {
+      NumaReplica replica;
+      replica.bytes = bytes;
+      replica.ptr = os_malloc(bytes,replica.hugepages);
+      os_bind_numa(replica.ptr,bytes,(unsigned int)i);
+      numaReplicas.push_back(replica);
+
+      AlignedNode* nodes = (AlignedNode*) replica.ptr;
+      numaRoots[i] = replicateRecursion(root,nodes,0);
+    }
+  }
+
+  template<int N>
+  size_t BVHN<N>::countReplicatedNodes(NodeRef node, size_t depth)
+  {
+    if (depth >= numaReplicationDepth || !node.isAlignedNode())
+      return 0;
+
+    size_t num = 1;
+    for (size_t c=0; c<N; c++)
+      num += countReplicatedNodes(node.alignedNode()->child(c),depth+1);
+    return num;
+  }
+
+  template<int N>
+  typename BVHN<N>::NodeRef BVHN<N>::replicateRecursion(NodeRef node, AlignedNode*& nodes, size_t depth)
+  {
+    if (depth >= numaReplicationDepth || !node.isAlignedNode())
+      return node;
+
+    AlignedNode* oldnode = node.alignedNode();
+    AlignedNode* newnode = nodes++;
+    *newnode = *oldnode;
+    for (size_t c=0; c<N; c++)
+      newnode->child(c) = replicateRecursion(oldnode->child(c),nodes,depth+1);
+    return encodeNode(newnode);
+  }
+
+  template<int N>
+  void BVHN<N>::clearReplicas()
+  {
+    delete[] numaRoots; numaRoots = nullptr;
+    for (size_t i=0; i<numaReplicas.size(); i++)
+      os_free(numaReplicas[i].ptr,numaReplicas[i].bytes,numaReplicas[i].hugepages);
+    numaReplicas.clear();
+  }
+
+  template<int N>
+  void BVHN<N>::hideGeometry(size_t geomID)
+  {
+    /* only leaves storing a geometry ID per primitive can be patched in place */
+    if (primTy != &InstancePrimitive::type && primTy != &Object::type)
+      return;
+
+    hideGeometryRecursion(root,geomID);
+    for (size_t i=0; i<numaReplicas.size(); i++)
+      hideGeometryRecursion(numaRoots[i],geomID);
+  }
+
+  template<int N>
+  void BVHN<N>::hideGeometryRecursion(NodeRef node, size_t geomID)
+  {
+    if (node.isAlignedNode())
+    {
+      AlignedNode* n = node.alignedNode();
+      for (size_t c=0; c<N; c++) {
+        if (isLeafOfGeometry(n->child(c),geomID)) n->setBounds(c,BBox3fa(empty));
+        else hideGeometryRecursion(n->child(c),geomID);
+      }
+    }
+    else if (node.isAlignedNodeMB() || node.isAlignedNodeMB4D())
+    {
+      AlignedNodeMB* n = node.alignedNodeMB();
+      for (size_t c=0; c<N; c++)
+      {
+        if (isLeafOfGeometry(n->child(c),geomID)) {
+          n->lower_x[c] = n->lower_y[c] = n->lower_z[c] = pos_inf;
+          n->upper_x[c] = n->upper_y[c] = n->upper_z[c] = neg_inf;
+          n->lower_dx[c] = n->lower_dy[c] = n->lower_dz[c] = 0.0f;
+          n->upper_dx[c] = n->upper_dy[c] = n->upper_dz[c] = 0.0f;
+        }
+        else hideGeometryRecursion(n->child(c),geomID);
+      }
+    }
+  }
+
+  template<int N>
+  bool BVHN<N>::isLeafOfGeometry(NodeRef node, size_t geomID) const
+  {
+    if (!node.isLeaf() || node == BVHN::emptyNode)
+      return false;
+
+    /* leaves shared with other geometries stay reachable */
+    size_t num; const char* leaf = node.leaf(num);
+    for (size_t i=0; i<num; i++)
+    {
+      if (primTy == &InstancePrimitive::type) {
+        if (((const InstancePrimitive*)leaf)[i].instID_ != geomID) return false;
+      } else {
+        if (((const Object*)leaf)[i].geomID() != geomID) return false;
+      }
+    }
+    return true;
+  }
+
+  template<int N>
+  void BVHN<N>::hideSubtree(const unsigned int* path, size_t depth)
+  {
+    /* an empty path hides the entire BVH */
+    if (depth == 0) {
+      root = emptyNode;
+      for (size_t i=0; i<numaReplicas.size(); i++)
+        numaRoots[i] = emptyNode;
+      return;
+    }
+
+    /* the replicas store the top levels in the same order as the BVH */
+    for (size_t r=0; r<=numaReplicas.size(); r++)
+    {
+      NodeRef node = r == 0 ? root : numaRoots[r-1];
+      for (size_t i=0; i+1<depth; i++)
+        node = node.alignedNode()->child(path[i]);
+      node.alignedNode()->setBounds(path[depth-1],BBox3fa(empty));
+    }
+  }
+
   template<int N>
   double BVHN<N>::preBuild(const std::string& builderName)
   {
+    memset(&buildStatistics,0,sizeof(buildStatistics));
+    leafNanoSeconds = 0;
+
     if (builderName == "") 
       return inf;
 
@@ -146,11 +301,32 @@ namespace embree
       return;
     
     double dt = 0.0;
-    if (device->benchmark || device->verbosity(2)) 
+    if (device->benchmark || device->verbosity(2) || device->build_statistics) 
       dt = getSeconds()-t0;
 
     std::unique_ptr<BVHNStatistics<N>> stat;
 
+    /* report build statistics to the scene */
+    if (device->build_statistics)
+    {
+      if (!stat) stat.reset(new BVHNStatistics<N>(this));
+      FastAllocator::Statistics astat = alloc.getStatistics(FastAllocator::ANY_TYPE);
+      for (size_t i=0; i<objects.size(); i++)
+        if (objects[i])
+          astat = astat + objects[i]->alloc.getStatistics(FastAllocator::ANY_TYPE);
+
+      buildStatistics.buildTime = dt;
+      buildStatistics.leafTime += 1E-9*double(leafNanoSeconds);
+      buildStatistics.numPrimitives = numPrimitives;
+      buildStatistics.numInnerNodes = stat->numInnerNodes();
+      buildStatistics.numLeaves = stat->numLeaves();
+      buildStatistics.sahCost = stat->sah();
+      buildStatistics.allocatedBytes = astat.bytesAllocatedTotal();
+      buildStatistics.usedBytes = astat.bytesUsed;
+      buildStatistics.wastedBytes = astat.bytesWasted;
+      scene->addBuildStatistics(buildStatistics);
+    }
+
     /* print statistics */
     if (device->verbosity(2))
     {
@@ -192,12 +368,16 @@ namespace embree
     }
   }
 
-#if defined(__AVX__)
+#if defined(__AVX__) && (!defined(__AVX512VL__) || !defined(EMBREE_TARGET_AVX))
   template class BVHN<8>;
 #endif
 
-#if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)
+#if (!defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)) && (!defined(__AVX512VL__) || !defined(EMBREE_TARGET_AVX))
   template class BVHN<4>;
 #endif
+
+#if defined(__AVX512VL__)
+  template class BVHN<16>;
+#endif
 }
 
@@ -35,6 +35,7 @@ namespace embree
     BVH_FLAG_UNALIGNED_NODE_MB = 0x01000,
     BVH_FLAG_QUANTIZED_NODE = 0x100000,
     BVH_FLAG_ALIGNED_NODE_MB4D = 0x1000000,
+    BVH_FLAG_QUANTIZED_NODE_MB = 0x10000000,
 
     /* short versions */
     BVH_AN1 = BVH_FLAG_ALIGNED_NODE,
@@ -42,11 +43,13 @@ namespace embree
     BVH_AN2_AN4D = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_ALIGNED_NODE_MB4D,
     BVH_UN1 = BVH_FLAG_UNALIGNED_NODE,
     BVH_UN2 = BVH_FLAG_UNALIGNED_NODE_MB,
-    BVH_MB = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB | BVH_FLAG_ALIGNED_NODE_MB4D,
+    BVH_MB = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB | BVH_FLAG_ALIGNED_NODE_MB4D | BVH_FLAG_QUANTIZED_NODE_MB,
     BVH_AN1_UN1 = BVH_FLAG_ALIGNED_NODE | BVH_FLAG_UNALIGNED_NODE,
     BVH_AN2_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_UNALIGNED_NODE_MB,
     BVH_AN2_AN4D_UN2 = BVH_FLAG_ALIGNED_NODE_MB | BVH_FLAG_ALIGNED_NODE_MB4D | BVH_FLAG_UNALIGNED_NODE_MB,
-    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE
+    BVH_QN1 = BVH_FLAG_QUANTIZED_NODE,
+    BVH_QN2_AN4D = BVH_FLAG_QUANTIZED_NODE_MB | BVH_FLAG_ALIGNED_NODE_MB4D,
+    BVH_QN2_AN4D_UN2 = BVH_FLAG_QUANTIZED_NODE_MB | BVH_FLAG_ALIGNED_NODE_MB4D | BVH_FLAG_UNALIGNED_NODE_MB
   };
 
   /* BVH node reference with bounds */
@@ -98,6 +101,7 @@ namespace embree
     struct UnalignedNode;
     struct UnalignedNodeMB;
     struct QuantizedNode;
+    struct QuantizedNodeMB;
 
     /*! Number of bytes the nodes and primitives are minimally aligned to.*/
     static const size_t byteAlignment = 16;
@@ -117,6 +121,7 @@ namespace embree
     static const size_t tyUnalignedNode = 2;
     static const size_t tyUnalignedNodeMB = 3;
     static const size_t tyQuantizedNode = 5;
+    static const size_t tyQuantizedNodeMB = 4;
     static const size_t tyLeaf = 8;
 
     /*! Empty node */
@@ -317,6 +322,9 @@ namespace embree
       /*! checks if this is a quantized node */
       __forceinline int isQuantizedNode() const { return (ptr & (size_t)align_mask) == tyQuantizedNode; }
 
+      /*! checks if this is a quantized motion blur node */
+      __forceinline int isQuantizedNodeMB() const { return (ptr & (size_t)align_mask) == tyQuantizedNodeMB; }
+
       /*! returns base node pointer */
       __forceinline BaseNode* baseNode()
       {
@@ -353,6 +361,10 @@ namespace embree
       __forceinline       QuantizedNode* quantizedNode()       { assert(isQuantizedNode()); return (      QuantizedNode*)(ptr  & ~(size_t)align_mask ); }
       __forceinline const QuantizedNode* quantizedNode() const { assert(isQuantizedNode()); return (const QuantizedNode*)(ptr  & ~(size_t)align_mask ); }
 
+      /*! returns quantized motion blur node pointer */
+      __forceinline       QuantizedNodeMB* quantizedNodeMB()       { assert(isQuantizedNodeMB()); return (      QuantizedNodeMB*)(ptr  & ~(size_t)align_mask ); }
+      __forceinline const QuantizedNodeMB* quantizedNodeMB() const { assert(isQuantizedNodeMB()); return (const QuantizedNodeMB*)(ptr  & ~(size_t)align_mask ); }
+
       /*! returns leaf pointer */
       __forceinline char* leaf(size_t& num) const {
         assert(isLeaf());
@@ -843,12 +855,15 @@ namespace embree
 
       struct Set
       {
-        __forceinline void operator() (NodeRef ref, size_t i, const NodeRecordMB4D& child) const
+        __forceinline void operator() (NodeRef ref, const NodeRecordMB4D* children, const size_t num) const
         {
-          if (likely(ref.isAlignedNodeMB())) {
-            ref.alignedNodeMB()->set(i, child);
-          } else {
-            ref.alignedNodeMB4D()->set(i, child);
+          for (size_t i=0; i<num; i++)
+          {
+            if (likely(ref.isAlignedNodeMB())) {
+              ref.alignedNodeMB()->set(i, children[i]);
+            } else {
+              ref.alignedNodeMB4D()->set(i, children[i]);
+            }
           }
         }
       };
@@ -1331,7 +1346,8 @@ namespace embree
         return bounds(i).size();
       }
 
-      __forceinline vbool<N> validMask() const { return node0.validMask(); }
+      /*! bounds extrapolated to the [0,1] time range may be inverted at one end, thus a child is valid if valid at either end */
+      __forceinline vbool<N> validMask() const { return node0.validMask() | node1.validMask(); }
 
       template<typename T>
       __forceinline vfloat<N> dequantizeLowerX(const T t) const { return lerp(node0.dequantizeLowerX(),node1.dequantizeLowerX(),t); }
@@ -1365,6 +1381,68 @@ namespace embree
     };
 
 
+    /*! BVHN Quantized Motion Blur Node */
+    struct __aligned(8) QuantizedNodeMB : public BaseNode, QuantizedBaseNodeMB
+    {
+      using BaseNode::children;
+      using QuantizedBaseNodeMB::node0;
+      using QuantizedBaseNodeMB::node1;
+
+      /*! creates a quantized node, nodes with time splits fall back to 4D motion blur nodes */
+      struct Create
+      {
+        __forceinline NodeRef operator() (const FastAllocator::CachedAllocator& alloc, bool hasTimeSplits = true) const
+        {
+          if (hasTimeSplits)
+          {
+            AlignedNodeMB4D* node = (AlignedNodeMB4D*) alloc.malloc0(sizeof(AlignedNodeMB4D),byteNodeAlignment); node->clear();
+            return encodeNode(node);
+          }
+          else
+          {
+            QuantizedNodeMB* node = (QuantizedNodeMB*) alloc.malloc0(sizeof(QuantizedNodeMB),byteAlignment); node->clear();
+            return encodeNode(node);
+          }
+        }
+      };
+
+      struct Set
+      {
+        __forceinline void operator() (NodeRef ref, const NodeRecordMB4D* children, const size_t num) const
+        {
+          if (likely(ref.isQuantizedNodeMB())) {
+            ref.quantizedNodeMB()->set(children,num);
+          } else {
+            for (size_t i=0; i<num; i++)
+              ref.alignedNodeMB4D()->set(i,children[i]);
+          }
+        }
+      };
+
+      /*! Clears the node. */
+      __forceinline void clear() {
+        QuantizedBaseNodeMB::clear();
+        BaseNode::clear();
+      }
+
+      /*! Sets IDs and quantized bounds of all children, the quantization grid depends on the bounds of all children. */
+      __forceinline void set(const NodeRecordMB4D* records, const size_t num)
+      {
+        __aligned(64) AlignedNode bounds0; bounds0.clear();
+        __aligned(64) AlignedNode bounds1; bounds1.clear();
+        for (size_t i=0; i<num; i++)
+        {
+          children[i] = records[i].ref;
+          if (records[i].ref == emptyNode) continue;
+          const LBBox3fa lbounds = records[i].lbounds.global(records[i].dt);
+          bounds0.setBounds(i,lbounds.bounds0.enlarge_by(4.0f*float(ulp)));
+          bounds1.setBounds(i,lbounds.bounds1.enlarge_by(4.0f*float(ulp)));
+        }
+        node0.init_dim(bounds0);
+        node1.init_dim(bounds1);
+      }
+    };
+
     /*! swap the children of two nodes */
     __forceinline static void swap(AlignedNode* a, size_t i, AlignedNode* b, size_t j)
     {
@@ -1439,12 +1517,50 @@ namespace embree
     void layoutLargeNodes(size_t num);
     NodeRef layoutLargeNodesRecursion(NodeRef& node, const FastAllocator::CachedAllocator& allocator);
 
+    /*! replicates the top levels of the BVH per NUMA node if enabled through the device */
+    void replicate();
+    size_t countReplicatedNodes(NodeRef node, size_t depth);
+    NodeRef replicateRecursion(NodeRef node, AlignedNode*& nodes, size_t depth);
+
+    /*! frees the NUMA node replicas */
+    void clearReplicas();
+
+    /*! empties the bounds of all instance and user geometry leaves of some geometry, thus rays cannot reach them anymore */
+    void hideGeometry(size_t geomID);
+    void hideGeometryRecursion(NodeRef node, size_t geomID);
+    bool isLeafOfGeometry(NodeRef node, size_t geomID) const;
+
+    /*! empties the bounds of the child reached from the root through the specified child slots of aligned nodes */
+    void hideSubtree(const unsigned int* path, size_t depth);
+
+    /*! returns the root node to start traversal at, in NUMA mode that of the replica of the calling thread's node */
+    __forceinline NodeRef getRoot() const
+    {
+      if (likely(numaRoots == nullptr)) return root;
+      return numaRoots[getThreadNumaNode()];
+    }
+
     /*! called by all builders before build starts */
     double preBuild(const std::string& builderName);
 
     /*! called by all builders after build ended */
     void postBuild(double t0);
 
+    /*! starts timing a build phase, returns zero if build statistics are disabled */
+    __forceinline double startPhase() const {
+      return device->build_statistics ? getSeconds() : 0.0;
+    }
+
+    /*! adds the time since startPhase to some phase of the build statistics */
+    __forceinline void endPhase(double& phaseTime, double t0) const {
+      if (t0 != 0.0) phaseTime += getSeconds()-t0;
+    }
+
+    /*! adds the time since startPhase to the leaf creation time, called by all build threads */
+    __forceinline void endLeafPhase(double t0) {
+      if (t0 != 0.0) leafNanoSeconds += size_t(1E9*(getSeconds()-t0));
+    }
+
     /*! allocator class */
     struct Allocator {
       BVHN* bvh;
@@ -1495,6 +1611,12 @@ namespace embree
       return NodeRef((size_t) node | tyAlignedNodeMB4D);
     }
 
+    /*! Encodes a quantized motion blur node */
+    static __forceinline NodeRef encodeNode(QuantizedNodeMB* node) {
+      assert(!((size_t)node & align_mask));
+      return NodeRef((size_t) node | tyQuantizedNodeMB);
+    }
+
     /*! Encodes an unaligned node */
     static __forceinline NodeRef encodeNode(UnalignedNode* node) {
       return NodeRef((size_t) node | tyUnalignedNode);
@@ -1528,11 +1650,25 @@ namespace embree
     Scene* scene;                      //!< scene pointer
     NodeRef root;                      //!< root node
     FastAllocator alloc;               //!< allocator used to allocate nodes
+    void* mappedPtr;                   //!< BVH cache file the nodes got mapped from
+    size_t mappedBytes;                //!< size of the mapped BVH cache file
+
+    /*! top levels of the BVH replicated per NUMA node */
+    struct NumaReplica
+    {
+      void* ptr;
+      size_t bytes;
+      bool hugepages;
+    };
+    std::vector<NumaReplica> numaReplicas;
+    NodeRef* numaRoots;                //!< root of the replica of each NUMA node, nullptr if not replicated
 
     /*! statistics data */
   public:
     size_t numPrimitives;              //!< number of primitives the BVH is build over
     size_t numVertices;                //!< number of vertices the BVH references
+    RTCSceneBuildStatistics buildStatistics; //!< phase timings of the last build
+    std::atomic<size_t> leafNanoSeconds;     //!< leaf creation time of the last build summed over all threads
 
     /*! data arrays for special builders */
   public:
@@ -1548,4 +1684,5 @@ namespace embree
 
   typedef BVHN<4> BVH4;
   typedef BVHN<8> BVH8;
+  typedef BVHN<16> BVH16;
 }
@@ -0,0 +1,151 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "../common/isa.h" // to define EMBREE_TARGET_AVX512SKX
+
+#if defined (EMBREE_TARGET_AVX512SKX)
+
+#include "bvh16_factory.h"
+#include "../bvh/bvh.h"
+
+#include "../geometry/triangle.h"
+#include "../geometry/trianglev.h"
+#include "../common/accelinstance.h"
+
+namespace embree
+{
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH16Triangle4Intersector1Moeller);
+  DECLARE_SYMBOL2(Accel::Intersector1,BVH16Triangle4vIntersector1Pluecker);
+
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH16Triangle4Intersector4HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH16Triangle4Intersector4HybridMoellerNoFilter);
+  DECLARE_SYMBOL2(Accel::Intersector4,BVH16Triangle4vIntersector4HybridPluecker);
+
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH16Triangle4Intersector8HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH16Triangle4Intersector8HybridMoellerNoFilter);
+  DECLARE_SYMBOL2(Accel::Intersector8,BVH16Triangle4vIntersector8HybridPluecker);
+
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH16Triangle4Intersector16HybridMoeller);
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH16Triangle4Intersector16HybridMoellerNoFilter);
+  DECLARE_SYMBOL2(Accel::Intersector16,BVH16Triangle4vIntersector16HybridPluecker);
+
+  DECLARE_SYMBOL2(Accel::IntersectorN,BVH16IntersectorStreamPacketFallback);
+
+  DECLARE_ISA_FUNCTION(Builder*,BVH16Triangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+  DECLARE_ISA_FUNCTION(Builder*,BVH16Triangle4vSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+
+  BVH16Factory::BVH16Factory(int bfeatures, int ifeatures)
+  {
+    selectBuilders(bfeatures);
+    selectIntersectors(ifeatures);
+  }
+
+  void BVH16Factory::selectBuilders(int features)
+  {
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4SceneBuilderSAH));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4vSceneBuilderSAH));
+  }
+
+  void BVH16Factory::selectIntersectors(int features)
+  {
+    /* select intersectors1 */
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4Intersector1Moeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4vIntersector1Pluecker));
+
+#if defined (EMBREE_RAY_PACKETS)
+
+    /* select intersectors4 */
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4Intersector4HybridMoeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4Intersector4HybridMoellerNoFilter));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4vIntersector4HybridPluecker));
+
+    /* select intersectors8 */
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4Intersector8HybridMoeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4Intersector8HybridMoellerNoFilter));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4vIntersector8HybridPluecker));
+
+    /* select intersectors16 */
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4Intersector16HybridMoeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4Intersector16HybridMoellerNoFilter));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16Triangle4vIntersector16HybridPluecker));
+
+    /* select stream intersectors */
+    SELECT_SYMBOL_INIT_AVX512SKX(features,BVH16IntersectorStreamPacketFallback);
+
+#endif
+  }
+
+  Accel::Intersectors BVH16Factory::BVH16Triangle4Intersectors(BVH16* bvh, IntersectVariant ivariant)
+  {
+    assert(ivariant == IntersectVariant::FAST);
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.intersector1           = BVH16Triangle4Intersector1Moeller();
+#if defined (EMBREE_RAY_PACKETS)
+    intersectors.intersector4_filter    = BVH16Triangle4Intersector4HybridMoeller();
+    intersectors.intersector4_nofilter  = BVH16Triangle4Intersector4HybridMoellerNoFilter();
+    intersectors.intersector8_filter    = BVH16Triangle4Intersector8HybridMoeller();
+    intersectors.intersector8_nofilter  = BVH16Triangle4Intersector8HybridMoellerNoFilter();
+    intersectors.intersector16_filter   = BVH16Triangle4Intersector16HybridMoeller();
+    intersectors.intersector16_nofilter = BVH16Triangle4Intersector16HybridMoellerNoFilter();
+    intersectors.intersectorN           = BVH16IntersectorStreamPacketFallback();
+#endif
+    return intersectors;
+  }
+
+  Accel::Intersectors BVH16Factory::BVH16Triangle4vIntersectors(BVH16* bvh, IntersectVariant ivariant)
+  {
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.intersector1  = BVH16Triangle4vIntersector1Pluecker();
+#if defined (EMBREE_RAY_PACKETS)
+    intersectors.intersector4  = BVH16Triangle4vIntersector4HybridPluecker();
+    intersectors.intersector8  = BVH16Triangle4vIntersector8HybridPluecker();
+    intersectors.intersector16 = BVH16Triangle4vIntersector16HybridPluecker();
+    intersectors.intersectorN  = BVH16IntersectorStreamPacketFallback();
+#endif
+    return intersectors;
+  }
+
+  Accel* BVH16Factory::BVH16Triangle4(Scene* scene, BuildVariant bvariant, IntersectVariant ivariant)
+  {
+    BVH16* accel = new BVH16(Triangle4::type,scene);
+    Accel::Intersectors intersectors = BVH16Triangle4Intersectors(accel,ivariant);
+
+    /* only the binned SAH builder supports 16-wide nodes, thus dynamic scenes get fully rebuilt */
+    Builder* builder = nullptr;
+    if      (scene->device->tri_builder == "default") builder = BVH16Triangle4SceneBuilderSAH(accel,scene,0);
+    else if (scene->device->tri_builder == "sah"    ) builder = BVH16Triangle4SceneBuilderSAH(accel,scene,0);
+    else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH16<Triangle4>");
+
+    return new AccelInstance(accel,builder,intersectors);
+  }
+
+  Accel* BVH16Factory::BVH16Triangle4v(Scene* scene, BuildVariant bvariant, IntersectVariant ivariant)
+  {
+    BVH16* accel = new BVH16(Triangle4v::type,scene);
+    Accel::Intersectors intersectors = BVH16Triangle4vIntersectors(accel,ivariant);
+
+    Builder* builder = nullptr;
+    if      (scene->device->tri_builder == "default") builder = BVH16Triangle4vSceneBuilderSAH(accel,scene,0);
+    else if (scene->device->tri_builder == "sah"    ) builder = BVH16Triangle4vSceneBuilderSAH(accel,scene,0);
+    else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH16<Triangle4v>");
+
+    return new AccelInstance(accel,builder,intersectors);
+  }
+}
+
+#endif
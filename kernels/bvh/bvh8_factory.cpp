@@ -40,6 +40,10 @@
 namespace embree
 {
   DECLARE_SYMBOL2(Accel::Collider,BVH8ColliderUserGeom);
+  DECLARE_SYMBOL2(Accel::Collider,BVH8ColliderMesh);
+  DECLARE_SYMBOL2(Accel::ContinuousCollider,BVH8ColliderContinuous);
+  DECLARE_SYMBOL2(Accel::KNNQuery,BVH8KNNQuery8i);
+  DECLARE_SYMBOL2(Accel::KNNQuery,BVH8KNNQuery8iMB);
   
   DECLARE_ISA_FUNCTION(VirtualCurveIntersector*,VirtualCurveIntersector8v,void);
   DECLARE_ISA_FUNCTION(VirtualCurveIntersector*,VirtualCurveIntersector8iMB,void);
@@ -72,6 +76,9 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector1,QBVH8Triangle4iIntersector1Pluecker);
   DECLARE_SYMBOL2(Accel::Intersector1,QBVH8Triangle4Intersector1Moeller);
   DECLARE_SYMBOL2(Accel::Intersector1,QBVH8Quad4iIntersector1Pluecker);
+  DECLARE_SYMBOL2(Accel::Intersector1,QBVH8Triangle4iMBIntersector1Pluecker);
+  DECLARE_SYMBOL2(Accel::Intersector1,QBVH8Quad4iMBIntersector1Pluecker);
+  DECLARE_SYMBOL2(Accel::Intersector1,QBVH8OBBVirtualCurveIntersector1MB);
 
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8VirtualIntersector1);
   DECLARE_SYMBOL2(Accel::Intersector1,BVH8VirtualMBIntersector1);
@@ -108,6 +115,10 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Quad4iMBIntersector4HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8Quad4iMBIntersector4HybridPluecker);
 
+  DECLARE_SYMBOL2(Accel::Intersector4,QBVH8Triangle4iMBIntersector4HybridPluecker);
+  DECLARE_SYMBOL2(Accel::Intersector4,QBVH8Quad4iMBIntersector4HybridPluecker);
+  DECLARE_SYMBOL2(Accel::Intersector4,QBVH8OBBVirtualCurveIntersector4HybridMB);
+
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8VirtualIntersector4Chunk);
   DECLARE_SYMBOL2(Accel::Intersector4,BVH8VirtualMBIntersector4Chunk);
 
@@ -142,6 +153,10 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8Quad4iMBIntersector8HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8Quad4iMBIntersector8HybridPluecker);
 
+  DECLARE_SYMBOL2(Accel::Intersector8,QBVH8Triangle4iMBIntersector8HybridPluecker);
+  DECLARE_SYMBOL2(Accel::Intersector8,QBVH8Quad4iMBIntersector8HybridPluecker);
+  DECLARE_SYMBOL2(Accel::Intersector8,QBVH8OBBVirtualCurveIntersector8HybridMB);
+
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8VirtualIntersector8Chunk);
   DECLARE_SYMBOL2(Accel::Intersector8,BVH8VirtualMBIntersector8Chunk);
 
@@ -176,6 +191,10 @@ namespace embree
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Quad4iMBIntersector16HybridMoeller);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8Quad4iMBIntersector16HybridPluecker);
 
+  DECLARE_SYMBOL2(Accel::Intersector16,QBVH8Triangle4iMBIntersector16HybridPluecker);
+  DECLARE_SYMBOL2(Accel::Intersector16,QBVH8Quad4iMBIntersector16HybridPluecker);
+  DECLARE_SYMBOL2(Accel::Intersector16,QBVH8OBBVirtualCurveIntersector16HybridMB);
+
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8VirtualIntersector16Chunk);
   DECLARE_SYMBOL2(Accel::Intersector16,BVH8VirtualMBIntersector16Chunk);
 
@@ -190,12 +209,14 @@ namespace embree
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Triangle4IntersectorStreamMoeller);
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Triangle4IntersectorStreamMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Triangle4iIntersectorStreamMoeller);
+  DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Triangle4iIntersectorStreamMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Triangle4vIntersectorStreamPluecker);
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Triangle4iIntersectorStreamPluecker);
 
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Quad4vIntersectorStreamMoeller);
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Quad4vIntersectorStreamMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Quad4iIntersectorStreamMoeller);
+  DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Quad4iIntersectorStreamMoellerNoFilter);
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Quad4vIntersectorStreamPluecker);
   DECLARE_SYMBOL2(Accel::IntersectorN,BVH8Quad4iIntersectorStreamPluecker);
 
@@ -205,11 +226,13 @@ namespace embree
 
   DECLARE_ISA_FUNCTION(Builder*,BVH8Curve8vBuilder_OBB_New,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8OBBCurve8iMBBuilder_OBB,void* COMMA Scene* COMMA size_t);
+  DECLARE_ISA_FUNCTION(Builder*,BVH8QuantizedOBBCurve8iMBBuilder_OBB,void* COMMA Scene* COMMA size_t);
 
   DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4vSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4iSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4iMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+  DECLARE_ISA_FUNCTION(Builder*,BVH8QuantizedTriangle4iMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4vMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8QuantizedTriangle4iSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8QuantizedTriangle4SceneBuilderSAH,void* COMMA Scene* COMMA size_t);
@@ -217,6 +240,7 @@ namespace embree
   DECLARE_ISA_FUNCTION(Builder*,BVH8Quad4vSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8Quad4iSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8Quad4iMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
+  DECLARE_ISA_FUNCTION(Builder*,BVH8QuantizedQuad4iMBSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8QuantizedQuad4iSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
 
   DECLARE_ISA_FUNCTION(Builder*,BVH8VirtualSceneBuilderSAH,void* COMMA Scene* COMMA size_t);
@@ -248,6 +272,8 @@ namespace embree
   DECLARE_ISA_FUNCTION(Builder*,BVH8Quad4vMeshRefitSAH,void* COMMA QuadMesh* COMMA unsigned int COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8VirtualMeshRefitSAH,void* COMMA UserGeometry* COMMA unsigned int COMMA size_t);
 
+  DECLARE_ISA_FUNCTION(Builder*,BVH8CachedBuilder,void* COMMA Scene* COMMA Builder* COMMA const char*);
+
   DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4MeshBuilderMortonGeneral,void* COMMA TriangleMesh* COMMA unsigned int COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4vMeshBuilderMortonGeneral,void* COMMA TriangleMesh* COMMA unsigned int COMMA size_t);
   DECLARE_ISA_FUNCTION(Builder*,BVH8Triangle4iMeshBuilderMortonGeneral,void* COMMA TriangleMesh* COMMA unsigned int COMMA size_t);
@@ -257,6 +283,10 @@ namespace embree
   BVH8Factory::BVH8Factory(int bfeatures, int ifeatures)
   {
     SELECT_SYMBOL_INIT_AVX(ifeatures,BVH8ColliderUserGeom);
+    SELECT_SYMBOL_INIT_AVX(ifeatures,BVH8ColliderMesh);
+    SELECT_SYMBOL_INIT_AVX(ifeatures,BVH8ColliderContinuous);
+    IF_ENABLED_CURVES(SELECT_SYMBOL_INIT_AVX_AVX2(ifeatures,BVH8KNNQuery8i));
+    IF_ENABLED_CURVES(SELECT_SYMBOL_INIT_AVX_AVX2(ifeatures,BVH8KNNQuery8iMB));
     
     selectBuilders(bfeatures);
     selectIntersectors(ifeatures);
@@ -266,11 +296,13 @@ namespace embree
   {
     IF_ENABLED_CURVES(SELECT_SYMBOL_INIT_AVX(features,BVH8Curve8vBuilder_OBB_New));
     IF_ENABLED_CURVES(SELECT_SYMBOL_INIT_AVX(features,BVH8OBBCurve8iMBBuilder_OBB));
+    IF_ENABLED_CURVES(SELECT_SYMBOL_INIT_AVX(features,BVH8QuantizedOBBCurve8iMBBuilder_OBB));
 
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8Triangle4SceneBuilderSAH));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8Triangle4vSceneBuilderSAH));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8Triangle4iSceneBuilderSAH));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8Triangle4iMBSceneBuilderSAH));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8QuantizedTriangle4iMBSceneBuilderSAH));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8Triangle4vMBSceneBuilderSAH));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX(features,BVH8QuantizedTriangle4iSceneBuilderSAH));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX(features,BVH8QuantizedTriangle4SceneBuilderSAH));
@@ -278,6 +310,7 @@ namespace embree
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8Quad4vSceneBuilderSAH));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8Quad4iSceneBuilderSAH));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8Quad4iMBSceneBuilderSAH));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8QuantizedQuad4iMBSceneBuilderSAH));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX(features,BVH8QuantizedQuad4iSceneBuilderSAH));
 
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX(features,BVH8VirtualSceneBuilderSAH));
@@ -309,6 +342,7 @@ namespace embree
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8Triangle4iMeshRefitSAH));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8Quad4vMeshRefitSAH));
     IF_ENABLED_USER (SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8VirtualMeshRefitSAH));
+    SELECT_SYMBOL_INIT_AVX_AVX512KNL(features,BVH8CachedBuilder);
 
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Triangle4MeshBuilderMortonGeneral));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL(features,BVH8Triangle4vMeshBuilderMortonGeneral));
@@ -351,6 +385,9 @@ namespace embree
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,QBVH8Triangle4iIntersector1Pluecker));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,QBVH8Triangle4Intersector1Moeller));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,QBVH8Quad4iIntersector1Pluecker));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,QBVH8Triangle4iMBIntersector1Pluecker));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,QBVH8Quad4iMBIntersector1Pluecker));
+    IF_ENABLED_CURVES(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,QBVH8OBBVirtualCurveIntersector1MB));
 
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8VirtualIntersector1));
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8VirtualMBIntersector1));
@@ -389,6 +426,9 @@ namespace embree
 
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Quad4iMBIntersector4HybridMoeller));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Quad4iMBIntersector4HybridPluecker));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,QBVH8Triangle4iMBIntersector4HybridPluecker));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2(features,QBVH8Quad4iMBIntersector4HybridPluecker));
+    IF_ENABLED_CURVES(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,QBVH8OBBVirtualCurveIntersector4HybridMB));
 
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8VirtualIntersector4Chunk));
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8VirtualMBIntersector4Chunk));
@@ -424,6 +464,9 @@ namespace embree
 
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Quad4iMBIntersector8HybridMoeller));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2(features,BVH8Quad4iMBIntersector8HybridPluecker));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,QBVH8Triangle4iMBIntersector8HybridPluecker));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2(features,QBVH8Quad4iMBIntersector8HybridPluecker));
+    IF_ENABLED_CURVES(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,QBVH8OBBVirtualCurveIntersector8HybridMB));
 
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8VirtualIntersector8Chunk));
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512SKX(features,BVH8VirtualMBIntersector8Chunk));
@@ -459,6 +502,9 @@ namespace embree
 
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH8Quad4iMBIntersector16HybridMoeller));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH8Quad4iMBIntersector16HybridPluecker));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,QBVH8Triangle4iMBIntersector16HybridPluecker));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,QBVH8Quad4iMBIntersector16HybridPluecker));
+    IF_ENABLED_CURVES(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,QBVH8OBBVirtualCurveIntersector16HybridMB));
 
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH8VirtualIntersector16Chunk));
     IF_ENABLED_USER(SELECT_SYMBOL_INIT_AVX512KNL_AVX512SKX(features,BVH8VirtualMBIntersector16Chunk));
@@ -476,12 +522,14 @@ namespace embree
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4IntersectorStreamMoeller));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4IntersectorStreamMoellerNoFilter));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4iIntersectorStreamMoeller));
+    IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4iIntersectorStreamMoellerNoFilter));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4vIntersectorStreamPluecker));
     IF_ENABLED_TRIS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Triangle4iIntersectorStreamPluecker));
 
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Quad4vIntersectorStreamMoeller));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Quad4vIntersectorStreamMoellerNoFilter));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Quad4iIntersectorStreamMoeller));
+    IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Quad4iIntersectorStreamMoellerNoFilter));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Quad4vIntersectorStreamPluecker));
     IF_ENABLED_QUADS(SELECT_SYMBOL_INIT_AVX_AVX2_AVX512KNL_AVX512SKX(features,BVH8Quad4iIntersectorStreamPluecker));
 
@@ -687,6 +735,8 @@ namespace embree
     assert(ivariant == IntersectVariant::FAST);
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
+    intersectors.continuousCollider = BVH8ColliderContinuous();
+    intersectors.collider = BVH8ColliderMesh();
     intersectors.intersector1           = BVH8Triangle4Intersector1Moeller();
 #if defined (EMBREE_RAY_PACKETS)
     intersectors.intersector4_filter    = BVH8Triangle4Intersector4HybridMoeller();
@@ -705,6 +755,8 @@ namespace embree
   {
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
+    intersectors.continuousCollider = BVH8ColliderContinuous();
+    intersectors.collider = BVH8ColliderMesh();
 #define ENABLE_WOOP_TEST 0
 #if ENABLE_WOOP_TEST == 0
     //assert(ivariant == IntersectVariant::ROBUST);
@@ -729,12 +781,15 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
+      intersectors.collider = BVH8ColliderMesh();
       intersectors.intersector1  = BVH8Triangle4iIntersector1Moeller();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Triangle4iIntersector4HybridMoeller();
       intersectors.intersector8  = BVH8Triangle4iIntersector8HybridMoeller();
       intersectors.intersector16 = BVH8Triangle4iIntersector16HybridMoeller();
-      intersectors.intersectorN  = BVH8Triangle4iIntersectorStreamMoeller();
+      intersectors.intersectorN_filter   = BVH8Triangle4iIntersectorStreamMoeller();
+      intersectors.intersectorN_nofilter = BVH8Triangle4iIntersectorStreamMoellerNoFilter();
 #endif
       return intersectors;
     }
@@ -742,6 +797,8 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
+      intersectors.collider = BVH8ColliderMesh();
       intersectors.intersector1  = BVH8Triangle4iIntersector1Pluecker();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Triangle4iIntersector4HybridPluecker();
@@ -762,6 +819,7 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
       intersectors.intersector1  = BVH8Triangle4vMBIntersector1Moeller();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Triangle4vMBIntersector4HybridMoeller();
@@ -775,6 +833,7 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
       intersectors.intersector1  = BVH8Triangle4vMBIntersector1Pluecker();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Triangle4vMBIntersector4HybridPluecker();
@@ -795,6 +854,7 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
       intersectors.intersector1  = BVH8Triangle4iMBIntersector1Moeller();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Triangle4iMBIntersector4HybridMoeller();
@@ -808,6 +868,7 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
       intersectors.intersector1  = BVH8Triangle4iMBIntersector1Pluecker();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Triangle4iMBIntersector4HybridPluecker();
@@ -828,6 +889,8 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
+      intersectors.collider = BVH8ColliderMesh();
       intersectors.intersector1           = BVH8Quad4vIntersector1Moeller();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4_filter    = BVH8Quad4vIntersector4HybridMoeller();
@@ -845,6 +908,8 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
+      intersectors.collider = BVH8ColliderMesh();
       intersectors.intersector1  = BVH8Quad4vIntersector1Pluecker();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Quad4vIntersector4HybridPluecker();
@@ -865,12 +930,15 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
+      intersectors.collider = BVH8ColliderMesh();
       intersectors.intersector1  = BVH8Quad4iIntersector1Moeller();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Quad4iIntersector4HybridMoeller();
       intersectors.intersector8  = BVH8Quad4iIntersector8HybridMoeller();
       intersectors.intersector16 = BVH8Quad4iIntersector16HybridMoeller();
-      intersectors.intersectorN  = BVH8Quad4iIntersectorStreamMoeller();
+      intersectors.intersectorN_filter   = BVH8Quad4iIntersectorStreamMoeller();
+      intersectors.intersectorN_nofilter = BVH8Quad4iIntersectorStreamMoellerNoFilter();
 #endif
       return intersectors;
     }
@@ -878,6 +946,8 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
+      intersectors.collider = BVH8ColliderMesh();
       intersectors.intersector1  = BVH8Quad4iIntersector1Pluecker();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Quad4iIntersector4HybridPluecker();
@@ -898,6 +968,7 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
       intersectors.intersector1  = BVH8Quad4iMBIntersector1Moeller();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Quad4iMBIntersector4HybridMoeller();
@@ -911,6 +982,7 @@ namespace embree
     {
       Accel::Intersectors intersectors;
       intersectors.ptr = bvh;
+      intersectors.continuousCollider = BVH8ColliderContinuous();
       intersectors.intersector1  = BVH8Quad4iMBIntersector1Pluecker();
 #if defined (EMBREE_RAY_PACKETS)
       intersectors.intersector4  = BVH8Quad4iMBIntersector4HybridPluecker();
@@ -948,6 +1020,49 @@ namespace embree
     return intersectors;
   }
 
+  Accel::Intersectors BVH8Factory::QBVH8Triangle4iMBIntersectors(BVH8* bvh)
+  {
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.intersector1  = QBVH8Triangle4iMBIntersector1Pluecker();
+#if defined (EMBREE_RAY_PACKETS)
+    intersectors.intersector4  = QBVH8Triangle4iMBIntersector4HybridPluecker();
+    intersectors.intersector8  = QBVH8Triangle4iMBIntersector8HybridPluecker();
+    intersectors.intersector16 = QBVH8Triangle4iMBIntersector16HybridPluecker();
+    intersectors.intersectorN  = BVH8IntersectorStreamPacketFallback();
+#endif
+    return intersectors;
+  }
+
+  Accel::Intersectors BVH8Factory::QBVH8Quad4iMBIntersectors(BVH8* bvh)
+  {
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.intersector1  = QBVH8Quad4iMBIntersector1Pluecker();
+#if defined (EMBREE_RAY_PACKETS)
+    intersectors.intersector4  = QBVH8Quad4iMBIntersector4HybridPluecker();
+    intersectors.intersector8  = QBVH8Quad4iMBIntersector8HybridPluecker();
+    intersectors.intersector16 = QBVH8Quad4iMBIntersector16HybridPluecker();
+    intersectors.intersectorN  = BVH8IntersectorStreamPacketFallback();
+#endif
+    return intersectors;
+  }
+
+  Accel::Intersectors BVH8Factory::QBVH8OBBVirtualCurveIntersectorsMB(BVH8* bvh, VirtualCurveIntersector* leafIntersector)
+  {
+    Accel::Intersectors intersectors;
+    intersectors.ptr = bvh;
+    intersectors.leafIntersector = leafIntersector;
+    intersectors.intersector1  = QBVH8OBBVirtualCurveIntersector1MB();
+#if defined (EMBREE_RAY_PACKETS)
+    intersectors.intersector4  = QBVH8OBBVirtualCurveIntersector4HybridMB();
+    intersectors.intersector8  = QBVH8OBBVirtualCurveIntersector8HybridMB();
+    intersectors.intersector16 = QBVH8OBBVirtualCurveIntersector16HybridMB();
+    intersectors.intersectorN  = BVH8IntersectorStreamPacketFallback();
+#endif
+    return intersectors;
+  }
+
   Accel::Intersectors BVH8Factory::BVH8UserGeometryIntersectors(BVH8* bvh)
   {
     Accel::Intersectors intersectors;
@@ -960,6 +1075,7 @@ namespace embree
     intersectors.intersectorN  = BVH8VirtualIntersectorStream();
 #endif
     intersectors.collider      = BVH8ColliderUserGeom();
+    intersectors.continuousCollider = BVH8ColliderContinuous();
     return intersectors;
   }
 
@@ -967,6 +1083,7 @@ namespace embree
   {
     Accel::Intersectors intersectors;
     intersectors.ptr = bvh;
+    intersectors.continuousCollider = BVH8ColliderContinuous();
     intersectors.intersector1  = BVH8VirtualMBIntersector1();
 #if defined (EMBREE_RAY_PACKETS)
     intersectors.intersector4  = BVH8VirtualMBIntersector4Chunk();
@@ -1009,6 +1126,7 @@ namespace embree
   {
     BVH8* accel = new BVH8(Curve8v::type,scene);
     Accel::Intersectors intersectors = BVH8OBBVirtualCurveIntersectors(accel,VirtualCurveIntersector8v(),ivariant);
+    intersectors.knn = BVH8KNNQuery8i();
     Builder* builder = BVH8Curve8vBuilder_OBB_New(accel,scene,0);
     return new AccelInstance(accel,builder,intersectors);
   }
@@ -1017,10 +1135,19 @@ namespace embree
   {
     BVH8* accel = new BVH8(Curve8iMB::type,scene);
     Accel::Intersectors intersectors = BVH8OBBVirtualCurveIntersectorsMB(accel,VirtualCurveIntersector8iMB(),ivariant);
+    intersectors.knn = BVH8KNNQuery8iMB();
     Builder* builder = BVH8OBBCurve8iMBBuilder_OBB(accel,scene,0);
     return new AccelInstance(accel,builder,intersectors);
   }
 
+  Accel* BVH8Factory::BVH8QuantizedOBBVirtualCurve8iMB(Scene* scene)
+  {
+    BVH8* accel = new BVH8(Curve8iMB::type,scene);
+    Accel::Intersectors intersectors = QBVH8OBBVirtualCurveIntersectorsMB(accel,VirtualCurveIntersector8iMB());
+    Builder* builder = BVH8QuantizedOBBCurve8iMBBuilder_OBB(accel,scene,0);
+    return new AccelInstance(accel,builder,intersectors);
+  }
+
   Accel* BVH8Factory::BVH8Triangle4(Scene* scene, BuildVariant bvariant, IntersectVariant ivariant)
   {
     BVH8* accel = new BVH8(Triangle4::type,scene);
@@ -1040,6 +1167,7 @@ namespace embree
     else if (scene->device->tri_builder == "morton"     ) builder = BVH8BuilderTwoLevelTriangleMeshSAH(accel,scene,&createTriangleMeshTriangle4Morton);
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH8<Triangle4>");
 
+    if (scene->device->bvh_cache != "" && scene->isStaticAccel()) builder = BVH8CachedBuilder(accel,scene,builder,"BVH8<Triangle4>");
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -1057,6 +1185,7 @@ namespace embree
     }
     else if (scene->device->tri_builder == "sah_fast_spatial")  builder = BVH8Triangle4SceneBuilderFastSpatialSAH(accel,scene,0);
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH8<Triangle4v>");
+    if (scene->device->bvh_cache != "" && scene->isStaticAccel()) builder = BVH8CachedBuilder(accel,scene,builder,"BVH8<Triangle4v>");
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -1075,6 +1204,7 @@ namespace embree
     }
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->tri_builder+" for BVH8<Triangle4i>");
 
+    if (scene->device->bvh_cache != "" && scene->isStaticAccel()) builder = BVH8CachedBuilder(accel,scene,builder,"BVH8<Triangle4i>");
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -1121,6 +1251,7 @@ namespace embree
     BVH8* accel = new BVH8(Triangle4i::type,scene);
     Accel::Intersectors intersectors = QBVH8Triangle4iIntersectors(accel);
     Builder* builder = BVH8QuantizedTriangle4iSceneBuilderSAH(accel,scene,0);
+    if (scene->device->bvh_cache != "" && scene->isStaticAccel()) builder = BVH8CachedBuilder(accel,scene,builder,"QBVH8<Triangle4i>");
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -1129,6 +1260,7 @@ namespace embree
     BVH8* accel = new BVH8(Triangle4::type,scene);
     Accel::Intersectors intersectors = QBVH8Triangle4Intersectors(accel);
     Builder* builder = BVH8QuantizedTriangle4SceneBuilderSAH(accel,scene,0);
+    if (scene->device->bvh_cache != "" && scene->isStaticAccel()) builder = BVH8CachedBuilder(accel,scene,builder,"QBVH8<Triangle4>");
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -1150,6 +1282,7 @@ namespace embree
     else if (scene->device->quad_builder == "sah_fast_spatial" ) builder = BVH8Quad4vSceneBuilderFastSpatialSAH(accel,scene,0);
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->quad_builder+" for BVH8<Quad4v>");
 
+    if (scene->device->bvh_cache != "" && scene->isStaticAccel()) builder = BVH8CachedBuilder(accel,scene,builder,"BVH8<Quad4v>");
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -1168,6 +1301,7 @@ namespace embree
     }
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->quad_builder+" for BVH8<Quad4i>");
 
+    if (scene->device->bvh_cache != "" && scene->isStaticAccel()) builder = BVH8CachedBuilder(accel,scene,builder,"BVH8<Quad4i>");
     return new AccelInstance(accel,builder,intersectors);
   }
 
@@ -1196,6 +1330,23 @@ namespace embree
     Builder* builder = nullptr;
     if      (scene->device->quad_builder == "default"     ) builder = BVH8QuantizedQuad4iSceneBuilderSAH(accel,scene,0);
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown builder "+scene->device->quad_builder+" for QBVH8<Quad4i>");
+    if (scene->device->bvh_cache != "" && scene->isStaticAccel()) builder = BVH8CachedBuilder(accel,scene,builder,"QBVH8<Quad4i>");
+    return new AccelInstance(accel,builder,intersectors);
+  }
+
+  Accel* BVH8Factory::BVH8QuantizedTriangle4iMB(Scene* scene)
+  {
+    BVH8* accel = new BVH8(Triangle4i::type,scene);
+    Accel::Intersectors intersectors = QBVH8Triangle4iMBIntersectors(accel);
+    Builder* builder = BVH8QuantizedTriangle4iMBSceneBuilderSAH(accel,scene,0);
+    return new AccelInstance(accel,builder,intersectors);
+  }
+
+  Accel* BVH8Factory::BVH8QuantizedQuad4iMB(Scene* scene)
+  {
+    BVH8* accel = new BVH8(Quad4i::type,scene);
+    Accel::Intersectors intersectors = QBVH8Quad4iMBIntersectors(accel);
+    Builder* builder = BVH8QuantizedQuad4iMBSceneBuilderSAH(accel,scene,0);
     return new AccelInstance(accel,builder,intersectors);
   }
 
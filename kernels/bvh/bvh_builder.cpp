@@ -27,7 +27,7 @@ namespace embree
         return createLeaf(prims,set,alloc);
       };
       
-      settings.branchingFactor = N;
+      settings.branchingFactor = min(settings.branchingFactor,size_t(N));
       settings.maxDepth = BVH::maxBuildDepthLeaf;
       return BVHBuilderBinnedSAH::build<NodeRef>
         (FastAllocator::Create(allocator),typename BVH::AlignedNode::Create2(),typename BVH::AlignedNode::Set3(allocator,prims),createLeafFunc,progressFunc,prims,pinfo,settings);
@@ -41,7 +41,7 @@ namespace embree
         return createLeaf(prims,set,alloc);
       };
             
-      settings.branchingFactor = N;
+      settings.branchingFactor = min(settings.branchingFactor,size_t(N));
       settings.maxDepth = BVH::maxBuildDepthLeaf;
       return BVHBuilderBinnedSAH::build<NodeRef>
         (FastAllocator::Create(allocator),typename BVH::QuantizedNode::Create2(),typename BVH::QuantizedNode::Set2(),createLeafFunc,progressFunc,prims,pinfo,settings);
@@ -54,7 +54,7 @@ namespace embree
         return createLeaf(prims,set,alloc);
       };
 
-      settings.branchingFactor = N;
+      settings.branchingFactor = min(settings.branchingFactor,size_t(N));
       settings.maxDepth = BVH::maxBuildDepthLeaf;
       return BVHBuilderBinnedSAH::build<NodeRecordMB>
         (FastAllocator::Create(allocator),typename BVH::AlignedNodeMB::Create2(),typename BVH::AlignedNodeMB::Set2TimeRange(timeRange),createLeafFunc,progressFunc,prims,pinfo,settings);
@@ -15,6 +15,7 @@
 // ======================================================================== //
 
 #include "bvh.h"
+#include "bvh_builder_arguments.h"
 #include "../builders/bvh_builder_sah.h"
 
 namespace embree
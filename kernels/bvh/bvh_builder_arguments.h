@@ -0,0 +1,73 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "../common/scene.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /* The helpers below override builder settings with the per scene
+     * build arguments set through rtc_AT_SetNextBVHArguments. Builders
+     * apply the parts their settings support and pass the largest leaf
+     * size their leaf encoding can represent. */
+
+    /*! overrides branching factor and leaf sizes */
+    template<int N, typename Settings>
+      __forceinline void applySceneBuildArgumentsLeaf(Settings& settings, const Scene* scene, const size_t maxLeafSize)
+    {
+      settings.branchingFactor = N;
+      if (scene == nullptr) return;
+
+      const RTCBuildArguments& args = scene->buildArguments;
+      if (RTC_BUILD_ARGUMENTS_HAS(args,maxBranchingFactor)) settings.branchingFactor = clamp(size_t(args.maxBranchingFactor),size_t(2),size_t(N));
+      if (RTC_BUILD_ARGUMENTS_HAS(args,minLeafSize       )) settings.minLeafSize     = max(size_t(args.minLeafSize),size_t(1));
+      if (RTC_BUILD_ARGUMENTS_HAS(args,maxLeafSize       )) settings.maxLeafSize     = clamp(size_t(args.maxLeafSize),size_t(1),maxLeafSize);
+      settings.minLeafSize = min(settings.minLeafSize,settings.maxLeafSize);
+    }
+
+    /*! overrides the block size of the SAH heuristic */
+    template<typename Settings>
+      __forceinline void applySceneBuildArgumentsBlockSize(Settings& settings, const Scene* scene)
+    {
+      if (scene == nullptr) return;
+      const RTCBuildArguments& args = scene->buildArguments;
+      if (RTC_BUILD_ARGUMENTS_HAS(args,sahBlockSize)) settings.logBlockSize = bsr(max(size_t(args.sahBlockSize),size_t(1)));
+    }
+
+    /*! overrides traversal and intersection cost of the SAH heuristic */
+    template<typename Settings>
+      __forceinline void applySceneBuildArgumentsCost(Settings& settings, const Scene* scene)
+    {
+      if (scene == nullptr) return;
+      const RTCBuildArguments& args = scene->buildArguments;
+      if (RTC_BUILD_ARGUMENTS_HAS(args,traversalCost   )) settings.travCost = args.traversalCost;
+      if (RTC_BUILD_ARGUMENTS_HAS(args,intersectionCost)) settings.intCost  = args.intersectionCost;
+    }
+
+    /*! overrides all settings of the SAH builders */
+    template<int N, typename Settings>
+      __forceinline void applySceneBuildArguments(Settings& settings, const Scene* scene, const size_t maxLeafSize)
+    {
+      applySceneBuildArgumentsLeaf<N>(settings,scene,maxLeafSize);
+      applySceneBuildArgumentsBlockSize(settings,scene);
+      applySceneBuildArgumentsCost(settings,scene);
+    }
+  }
+}
@@ -14,6 +14,7 @@
 // limitations under the License.                                           //
 // ======================================================================== //
 
+#include "bvh_builder_arguments.h"
 #include "../builders/bvh_builder_hair.h"
 #include "../builders/primrefgen.h"
 
@@ -73,6 +74,8 @@ namespace embree
         settings.logBlockSize = bsf(CurvePrimitive::max_size());
         settings.minLeafSize = CurvePrimitive::max_size();
         settings.maxLeafSize = CurvePrimitive::max_size();
+        applySceneBuildArgumentsLeaf<N>(settings,scene,CurvePrimitive::max_size());
+        applySceneBuildArgumentsBlockSize(settings,scene);
         settings.finished_range_threshold = numPrimitives/1000;
         if (settings.finished_range_threshold < 1000)
           settings.finished_range_threshold = inf;
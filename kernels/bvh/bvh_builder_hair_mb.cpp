@@ -14,6 +14,7 @@
 // limitations under the License.                                           //
 // ======================================================================== //
 
+#include "bvh_builder_arguments.h"
 #include "../builders/bvh_builder_msmblur_hair.h"
 #include "../builders/primrefgen.h"
 
@@ -28,7 +29,7 @@ namespace embree
   namespace isa
   {
     /* FIXME: add fast path for single-segment motion blur */
-    template<int N, typename CurvePrimitive, typename LinePrimitive, typename PointPrimitive>
+    template<int N, typename CurvePrimitive, typename LinePrimitive, typename PointPrimitive, typename Node = typename BVHN<N>::AlignedNodeMB4D>
     struct BVHNHairMBlurBuilderSAH : public Builder
     {
       typedef BVHN<N> BVH;
@@ -70,6 +71,8 @@ namespace embree
         settings.logBlockSize = bsf(CurvePrimitive::max_size());
         settings.minLeafSize = CurvePrimitive::max_size();
         settings.maxLeafSize = CurvePrimitive::max_size();
+        applySceneBuildArgumentsLeaf<N>(settings,scene,CurvePrimitive::max_size());
+        applySceneBuildArgumentsBlockSize(settings,scene);
 
         /* creates a leaf node */
         auto createLeaf = [&] (const SetMB& prims, const FastAllocator::CachedAllocator& alloc) -> NodeRecordMB4D {
@@ -91,8 +94,8 @@ namespace embree
           (scene, prims0, pinfo,
            VirtualRecalculatePrimRef(scene),
            typename BVH::CreateAlloc(bvh),
-           typename BVH::AlignedNodeMB4D::Create(),
-           typename BVH::AlignedNodeMB4D::Set(),
+           typename Node::Create(),
+           typename Node::Set(),
            typename BVH::UnalignedNodeMB::Create(),
            typename BVH::UnalignedNodeMB::Set(),
            createLeaf,
@@ -115,10 +118,12 @@ namespace embree
     
     /*! entry functions for the builder */
     Builder* BVH4OBBCurve4iMBBuilder_OBB (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBlurBuilderSAH<4,Curve4iMB,Line4i,Point4i>((BVH4*)bvh,scene); }
+    Builder* BVH4QuantizedOBBCurve4iMBBuilder_OBB (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBlurBuilderSAH<4,Curve4iMB,Line4i,Point4i,BVH4::QuantizedNodeMB>((BVH4*)bvh,scene); }
 
 #if defined(__AVX__)
     Builder* BVH4OBBCurve8iMBBuilder_OBB (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBlurBuilderSAH<4,Curve8iMB,Line8i,Point8i>((BVH4*)bvh,scene); }
     Builder* BVH8OBBCurve8iMBBuilder_OBB (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBlurBuilderSAH<8,Curve8iMB,Line8i,Point8i>((BVH8*)bvh,scene); }
+    Builder* BVH8QuantizedOBBCurve8iMBBuilder_OBB (void* bvh, Scene* scene, size_t mode) { return new BVHNHairMBlurBuilderSAH<8,Curve8iMB,Line8i,Point8i,BVH8::QuantizedNodeMB>((BVH8*)bvh,scene); }
 #endif
 
   }
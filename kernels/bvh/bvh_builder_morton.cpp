@@ -17,6 +17,7 @@
 #include "bvh.h"
 #include "bvh_statistics.h"
 #include "bvh_rotate.h"
+#include "bvh_builder_arguments.h"
 #include "../common/profile.h"
 #include "../../common/algorithms/parallel_prefix_sum.h"
 
@@ -391,7 +392,9 @@ namespace embree
     public:
       
       BVHNMeshBuilderMorton (BVH* bvh, Mesh* mesh, unsigned int geomID, const size_t minLeafSize, const size_t maxLeafSize, const size_t singleThreadThreshold = DEFAULT_SINGLE_THREAD_THRESHOLD)
-        : bvh(bvh), mesh(mesh), morton(bvh->device,0), settings(N,BVH::maxBuildDepth,minLeafSize,min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks),singleThreadThreshold), geomID_(geomID) {}
+        : bvh(bvh), mesh(mesh), morton(bvh->device,0), settings(N,BVH::maxBuildDepth,minLeafSize,min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks),singleThreadThreshold), geomID_(geomID) {
+        applySceneBuildArgumentsLeaf<N>(settings,bvh->scene,Primitive::max_size()*BVH::maxLeafBlocks);
+      }
       
       /* build function */
       void build() 
@@ -24,6 +24,7 @@
 #include "../geometry/trianglev.h"
 #include "../geometry/trianglev_mb.h"
 #include "../geometry/trianglei.h"
+#include "../geometry/trianglec.h"
 #include "../geometry/quadv.h"
 #include "../geometry/quadi.h"
 #include "../geometry/object.h"
@@ -51,6 +52,7 @@ namespace embree
 
       __forceinline NodeRef operator() (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) const
       {
+        const double t0 = bvh->startPhase();
         size_t n = set.size();
         size_t items = Primitive::blocks(n);
         size_t start = set.begin();
@@ -59,12 +61,62 @@ namespace embree
         for (size_t i=0; i<items; i++) {
           accel[i].fill(prims,start,set.end(),bvh->scene);
         }
+        bvh->endLeafPhase(t0);
         return node;
       }
 
       BVH* bvh;
     };
 
+    /* compressed triangles get encoded into a variable number of blocks */
+    template<int N>
+    struct CreateLeaf<N,Triangle4c>
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::AlignedNode AlignedNode;
+
+      __forceinline CreateLeaf (BVH* bvh) : bvh(bvh) {}
+
+      __forceinline NodeRef operator() (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) const
+      {
+        const double t0 = bvh->startPhase();
+        const NodeRef node = createLeaf(prims,set,alloc);
+        bvh->endLeafPhase(t0);
+        return node;
+      }
+
+      NodeRef createLeaf(const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) const
+      {
+        const size_t items = Triangle4c::blocks(prims,set.begin(),set.end(),bvh->scene);
+        if (likely(items <= BVH::maxLeafBlocks))
+        {
+          size_t start = set.begin();
+          Triangle4c* accel = (Triangle4c*) alloc.malloc1(items*sizeof(Triangle4c),BVH::byteAlignment);
+          for (size_t i=0; i<items; i++)
+            accel[i].fill(prims,start,set.end(),bvh->scene);
+          return BVH::encodeLeaf((char*)accel,items);
+        }
+
+        /* leaves that compress badly need too many blocks, thus get split in half */
+        const size_t center = (set.begin()+set.end())/2;
+        const range<size_t> sets[2] = { range<size_t>(set.begin(),center), range<size_t>(center,set.end()) };
+        AlignedNode* node = (AlignedNode*) alloc.malloc0(sizeof(AlignedNode),BVH::byteNodeAlignment);
+        node->clear();
+        for (size_t i=0; i<2; i++)
+        {
+          BBox3fa bounds = empty;
+          for (size_t j=sets[i].begin(); j<sets[i].end(); j++)
+            bounds.extend(prims[j].bounds());
+          node->setRef(i,createLeaf(prims,sets[i],alloc));
+          node->setBounds(i,bounds);
+        }
+        return BVH::encodeNode(node);
+      }
+
+      BVH* bvh;
+    };
+
 
     template<int N, typename Primitive>
     struct CreateLeafQuantized
@@ -76,6 +128,7 @@ namespace embree
 
       __forceinline NodeRef operator() (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) const
       {
+        const double t0 = bvh->startPhase();
         size_t n = set.size();
         size_t items = Primitive::blocks(n);
         size_t start = set.begin();
@@ -84,6 +137,7 @@ namespace embree
         for (size_t i=0; i<items; i++) {
           accel[i].fill(prims,start,set.end(),bvh->scene);
         }
+        bvh->endLeafPhase(t0);
         return node;
       }
 
@@ -115,12 +169,12 @@ namespace embree
                       const Geometry::GTypeMask gtype, bool primrefarrayalloc = false)
         : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0),
           settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), gtype_(gtype), primrefarrayalloc(primrefarrayalloc) {
-            settings = scene->buildArguments;
+            applySceneBuildArguments<N>(settings,scene,Primitive::max_size()*BVH::maxLeafBlocks);
           }
 
       BVHNBuilderSAH (BVH* bvh, Geometry* mesh, unsigned int geomID, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const Geometry::GTypeMask gtype)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), gtype_(gtype), geomID_(geomID), primrefarrayalloc(false) {
-          settings = scene->buildArguments;
+          applySceneBuildArguments<N>(settings,bvh->scene,Primitive::max_size()*BVH::maxLeafBlocks);
         }
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
@@ -163,15 +217,19 @@ namespace embree
               bvh->alloc.setOSallocation(true);
 
             /* initialize allocator */
+            double t1 = bvh->startPhase();
             const size_t node_bytes = numPrimitives*sizeof(typename BVH::AlignedNodeMB)/(4*N);
             const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
             bvh->alloc.init_estimate(node_bytes+leaf_bytes);
             settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+            bvh->endPhase(bvh->buildStatistics.allocatorTime,t1);
             prims.resize(numPrimitives); 
 
+            t1 = bvh->startPhase();
             PrimInfo pinfo = mesh ?
               createPrimRefArray(mesh,geomID_,prims,bvh->scene->progressInterface) :
               createPrimRefArray(scene,gtype_,false,prims,bvh->scene->progressInterface);
+            bvh->endPhase(bvh->buildStatistics.primRefTime,t1);
 
             /* pinfo might has zero size due to invalid geometry */
             if (unlikely(pinfo.size() == 0))
@@ -182,9 +240,14 @@ namespace embree
             }
 
             /* call BVH builder */
+            t1 = bvh->startPhase();
             NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeaf<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
             bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+            bvh->endPhase(bvh->buildStatistics.binningTime,t1);
+
+            t1 = bvh->startPhase();
             bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+            bvh->endPhase(bvh->buildStatistics.layoutTime,t1);
 
 #if PROFILE
           });
@@ -230,12 +293,12 @@ namespace embree
 
       BVHNBuilderSAHQuantized (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const Geometry::GTypeMask gtype)
         : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), gtype_(gtype) {
-          settings = scene->buildArguments;
+          applySceneBuildArguments<N>(settings,scene,Primitive::max_size()*BVH::maxLeafBlocks);
         }
 
       BVHNBuilderSAHQuantized (BVH* bvh, Geometry* mesh, unsigned int geomID, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const Geometry::GTypeMask gtype)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), gtype_(gtype), geomID_(geomID) {
-          settings = scene->buildArguments;
+          applySceneBuildArguments<N>(settings,bvh->scene,Primitive::max_size()*BVH::maxLeafBlocks);
         }
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
@@ -262,22 +325,29 @@ namespace embree
         profile(2,PROFILE_RUNS,numPrimitives,[&] (ProfileTimer& timer) {
 #endif
             /* create primref array */
+            double t1 = bvh->startPhase();
             prims.resize(numPrimitives);
             PrimInfo pinfo = mesh ?
               createPrimRefArray(mesh,geomID_,prims,bvh->scene->progressInterface) :
               createPrimRefArray(scene,gtype_,false,prims,bvh->scene->progressInterface);
+            bvh->endPhase(bvh->buildStatistics.primRefTime,t1);
 
             /* enable os_malloc for two level build */
             if (mesh)
               bvh->alloc.setOSallocation(true);
 
             /* call BVH builder */
+            t1 = bvh->startPhase();
             const size_t node_bytes = numPrimitives*sizeof(typename BVH::QuantizedNode)/(4*N);
             const size_t leaf_bytes = size_t(1.2*Primitive::blocks(numPrimitives)*sizeof(Primitive));
             bvh->alloc.init_estimate(node_bytes+leaf_bytes);
             settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+            bvh->endPhase(bvh->buildStatistics.allocatorTime,t1);
+
+            t1 = bvh->startPhase();
             NodeRef root = BVHNBuilderQuantizedVirtual<N>::build(&bvh->alloc,CreateLeafQuantized<N,Primitive>(bvh),bvh->scene->progressInterface,prims.data(),pinfo,settings);
             bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+            bvh->endPhase(bvh->buildStatistics.binningTime,t1);
             //bvh->layoutLargeNodes(pinfo.size()*0.005f); // FIXME: COPY LAYOUT FOR LARGE NODES !!!
 #if PROFILE
           });
@@ -313,6 +383,7 @@ namespace embree
 
       __forceinline NodeRef operator() (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) const
       {
+        const double t0 = bvh->startPhase();
         const size_t items = set.size(); //Primitive::blocks(n);
         const size_t start = set.begin();
 
@@ -358,6 +429,7 @@ namespace embree
           new (&accel[g]) SubGridQBVHN<N>(x,y,primID,bounds,geomIDs[g],pos);
         }
 
+        bvh->endLeafPhase(t0);
         return node;
       }
 
@@ -382,10 +454,14 @@ namespace embree
       unsigned int numPreviousPrimitives = 0;
 
       BVHNBuilderSAHGrid (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0), sgrids(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD) {}
+        : bvh(bvh), scene(scene), mesh(nullptr), prims(scene->device,0), sgrids(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD) {
+        applySceneBuildArguments<N>(settings,scene,BVH::maxLeafBlocks);
+      }
 
       BVHNBuilderSAHGrid (BVH* bvh, GridMesh* mesh, unsigned int geomID, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
-        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), sgrids(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), geomID_(geomID) {}
+        : bvh(bvh), scene(nullptr), mesh(mesh), prims(bvh->device,0), sgrids(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD), geomID_(geomID) {
+        applySceneBuildArguments<N>(settings,bvh->scene,BVH::maxLeafBlocks);
+      }
 
       void build()
       {
@@ -523,11 +599,13 @@ namespace embree
           bvh->alloc.setOSallocation(true);
 
         /* initialize allocator */
+        double t1 = bvh->startPhase();
         const size_t node_bytes = numPrimitives*sizeof(typename BVH::AlignedNodeMB)/(4*N);
         const size_t leaf_bytes = size_t(1.2*(float)numPrimitives/N * sizeof(SubGridQBVHN<N>));
 
         bvh->alloc.init_estimate(node_bytes+leaf_bytes);
         settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,numPrimitives,node_bytes+leaf_bytes);
+        bvh->endPhase(bvh->buildStatistics.allocatorTime,t1);
 
         /* pinfo might has zero size due to invalid geometry */
         if (unlikely(pinfo.size() == 0))
@@ -539,9 +617,14 @@ namespace embree
         }
 
         /* call BVH builder */
+        t1 = bvh->startPhase();
         NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafGrid<N,SubGridQBVHN<N>>(bvh,sgrids.data()),bvh->scene->progressInterface,prims.data(),pinfo,settings);
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+        bvh->endPhase(bvh->buildStatistics.binningTime,t1);
+
+        t1 = bvh->startPhase();
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+        bvh->endPhase(bvh->buildStatistics.layoutTime,t1);
 
         /* clear temporary array */
         sgrids.clear();
@@ -577,6 +660,7 @@ namespace embree
     Builder* BVH4Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH4Triangle4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4v>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
     Builder* BVH4Triangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type,true); }
+    Builder* BVH4Triangle4cSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<4,Triangle4c>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
 
 
     Builder* BVH4QuantizedTriangle4iSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<4,Triangle4i>((BVH4*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
@@ -592,6 +676,10 @@ namespace embree
     Builder* BVH8QuantizedTriangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAHQuantized<8,Triangle4>((BVH8*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
 
 #endif
+#if defined(__AVX512VL__)
+    Builder* BVH16Triangle4SceneBuilderSAH  (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<16,Triangle4>((BVH16*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+    Builder* BVH16Triangle4vSceneBuilderSAH (void* bvh, Scene* scene, size_t mode) { return new BVHNBuilderSAH<16,Triangle4v>((BVH16*)bvh,scene,4,1.0f,4,inf,TriangleMesh::geom_type); }
+#endif
 #endif
 
 #if defined(EMBREE_GEOMETRY_QUAD)
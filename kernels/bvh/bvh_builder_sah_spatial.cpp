@@ -48,6 +48,7 @@ namespace embree
 
       __forceinline NodeRef operator() (const PrimRef* prims, const range<size_t>& set, const FastAllocator::CachedAllocator& alloc) const
       {
+        const double t0 = bvh->startPhase();
         size_t n = set.size();
         size_t items = Primitive::blocks(n);
         size_t start = set.begin();
@@ -56,6 +57,7 @@ namespace embree
         for (size_t i=0; i<items; i++) {
           accel[i].fill(prims,start,set.end(),bvh->scene);
         }
+        bvh->endLeafPhase(t0);
         return node;
       }
 
@@ -78,11 +80,15 @@ namespace embree
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Scene* scene, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(scene), mesh(nullptr), prims0(scene->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD),
-          splitFactor(scene->device->max_spatial_split_replications) {}
+          splitFactor(scene->device->max_spatial_split_replications) {
+        applySceneBuildArguments<N>(settings,scene,Primitive::max_size()*BVH::maxLeafBlocks);
+      }
 
       BVHNBuilderFastSpatialSAH (BVH* bvh, Mesh* mesh, const unsigned int geomID, const size_t sahBlockSize, const float intCost, const size_t minLeafSize, const size_t maxLeafSize, const size_t mode)
         : bvh(bvh), scene(nullptr), mesh(mesh), prims0(bvh->device,0), settings(sahBlockSize, minLeafSize, min(maxLeafSize,Primitive::max_size()*BVH::maxLeafBlocks), travCost, intCost, DEFAULT_SINGLE_THREAD_THRESHOLD),
-          splitFactor(scene->device->max_spatial_split_replications), geomID_(geomID) {}
+          splitFactor(bvh->device->max_spatial_split_replications), geomID_(geomID) {
+        applySceneBuildArguments<N>(settings,bvh->scene,Primitive::max_size()*BVH::maxLeafBlocks);
+      }
 
       // FIXME: shrink bvh->alloc in destructor here and in other builders too
 
@@ -121,39 +127,48 @@ namespace embree
         if (likely(usePreSplits))
 	  {		     
             /* spatial presplit SAH BVH builder */
+            double t1 = bvh->startPhase();
 	    pinfo = mesh ?
 	      createPrimRefArray_presplit<Mesh,Splitter>(mesh,maxGeomID,numOriginalPrimitives,prims0,bvh->scene->progressInterface) :
 	      createPrimRefArray_presplit<Mesh,Splitter>(scene,Mesh::geom_type,false,numOriginalPrimitives,prims0,bvh->scene->progressInterface);
+            bvh->endPhase(bvh->buildStatistics.spatialSplitTime,t1);
 
+            t1 = bvh->startPhase();
 	    const size_t node_bytes = pinfo.size()*sizeof(typename BVH::AlignedNode)/(4*N);
 	    const size_t leaf_bytes = size_t(1.2*Primitive::blocks(pinfo.size())*sizeof(Primitive));
 	    bvh->alloc.init_estimate(node_bytes+leaf_bytes);
 	    settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),node_bytes+leaf_bytes);
+            bvh->endPhase(bvh->buildStatistics.allocatorTime,t1);
 
-	    settings.branchingFactor = N;
 	    settings.maxDepth = BVH::maxBuildDepthLeaf;
 
 	    /* call BVH builder */
+            t1 = bvh->startPhase();
 	    root = BVHNBuilderVirtual<N>::build(&bvh->alloc,CreateLeafSpatial<N,Primitive>(bvh),bvh->scene->progressInterface,prims0.data(),pinfo,settings);
+            bvh->endPhase(bvh->buildStatistics.binningTime,t1);
 	  }
 	else
 	  {
             /* standard spatial split SAH BVH builder */
+            double t1 = bvh->startPhase();
 	    pinfo = mesh ?
 	      createPrimRefArray(mesh,geomID_,/*numSplitPrimitives,*/prims0,bvh->scene->progressInterface) :
 	      createPrimRefArray(scene,Mesh::geom_type,false,/*numSplitPrimitives,*/prims0,bvh->scene->progressInterface);
+            bvh->endPhase(bvh->buildStatistics.primRefTime,t1);
 	
 	    Splitter splitter(scene);
 
+            t1 = bvh->startPhase();
 	    const size_t node_bytes = pinfo.size()*sizeof(typename BVH::AlignedNode)/(4*N);
 	    const size_t leaf_bytes = size_t(1.2*Primitive::blocks(pinfo.size())*sizeof(Primitive));
 	    bvh->alloc.init_estimate(node_bytes+leaf_bytes);
 	    settings.singleThreadThreshold = bvh->alloc.fixSingleThreadThreshold(N,DEFAULT_SINGLE_THREAD_THRESHOLD,pinfo.size(),node_bytes+leaf_bytes);
+            bvh->endPhase(bvh->buildStatistics.allocatorTime,t1);
 
-	    settings.branchingFactor = N;
 	    settings.maxDepth = BVH::maxBuildDepthLeaf;
 
-	    /* call BVH builder */
+	    /* call BVH builder, binning considers object and spatial splits */
+            t1 = bvh->startPhase();
 	    root = BVHBuilderBinnedFastSpatialSAH::build<NodeRef>(
 								  typename BVH::CreateAlloc(bvh),
 								  typename BVH::AlignedNode::Create2(),
@@ -164,12 +179,15 @@ namespace embree
 								  prims0.data(),
 								  numSplitPrimitives,
 								  pinfo,settings);
+            bvh->endPhase(bvh->buildStatistics.spatialSplitTime,t1);
 
 	    /* ==================== */
 	  }
 
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
+        const double t1 = bvh->startPhase();
         bvh->layoutLargeNodes(size_t(pinfo.size()*0.005f));
+        bvh->endPhase(bvh->buildStatistics.layoutTime,t1);
 
 	/* clear temporary data for static geometry */
 	if (scene && scene->isStaticAccel()) {
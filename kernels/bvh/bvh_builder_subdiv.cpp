@@ -51,9 +51,10 @@ namespace embree
       BVH* bvh;
       Scene* scene;
       mvector<PrimRef> prims;
+      bool lazy;
             
-      BVHNSubdivPatch1BuilderSAH (BVH* bvh, Scene* scene)
-        : bvh(bvh), scene(scene), prims(scene->device,0) {}
+      BVHNSubdivPatch1BuilderSAH (BVH* bvh, Scene* scene, bool lazy)
+        : bvh(bvh), scene(scene), prims(scene->device,0), lazy(lazy) {}
 
 #define SUBGRID 9
 
@@ -87,6 +88,46 @@ namespace embree
         return NN;
       }
 
+      /* tessellates a subgrid into temporary memory to calculate its bounds */
+      static BBox3fa evalSubGridBounds(const SubdivPatch1Base& patch, unsigned x0, unsigned x1, unsigned y0, unsigned y1, const SubdivMesh* mesh)
+      {
+        const unsigned num = (x1-x0+1)*(y1-y0+1);
+        const unsigned temp_size = num+VSIZEX;
+        dynamic_large_stack_array(float,grid_u,temp_size,32*32*sizeof(float));
+        dynamic_large_stack_array(float,grid_v,temp_size,32*32*sizeof(float));
+        dynamic_large_stack_array(float,grid_x,temp_size,32*32*sizeof(float));
+        dynamic_large_stack_array(float,grid_y,temp_size,32*32*sizeof(float));
+        dynamic_large_stack_array(float,grid_z,temp_size,32*32*sizeof(float));
+        evalGrid(patch,x0,x1,y0,y1,patch.grid_u_res,patch.grid_v_res,grid_x,grid_y,grid_z,grid_u,grid_v,mesh);
+
+        BBox3fa bounds(empty);
+        for (unsigned i=0; i<num; i++)
+          bounds.extend(Vec3fa(grid_x[i],grid_y[i],grid_z[i]));
+        return bounds;
+      }
+
+      /* creates the same subgrids as createEager, but only stores a reference to the patch for later tessellation */
+      __forceinline static unsigned createLazy(const SubdivPatch1* patch, SubdivMesh* mesh, Allocator& alloc, PrimRef* prims)
+      {
+        unsigned NN = 0;
+        const unsigned x0 = 0, x1 = patch->grid_u_res-1;
+        const unsigned y0 = 0, y1 = patch->grid_v_res-1;
+        
+        for (unsigned y=y0; y<y1; y+=SUBGRID-1)
+        {
+          for (unsigned x=x0; x<x1; x+=SUBGRID-1) 
+          {
+            const unsigned lx0 = x, lx1 = min(lx0+SUBGRID-1,x1);
+            const unsigned ly0 = y, ly1 = min(ly0+SUBGRID-1,y1);
+            const BBox3fa bounds = evalSubGridBounds(*patch,lx0,lx1,ly0,ly1,mesh);
+            SubdivPatch1Lazy* leaf = new (alloc(sizeof(SubdivPatch1Lazy))) SubdivPatch1Lazy(patch,lx0,lx1,ly0,ly1);
+            *prims = PrimRef(bounds,BVH4::encodeTypedLeaf(leaf,1)); prims++;
+            NN++;
+          }
+        }
+        return NN;
+      }
+
       void build() 
       {
         /* skip build for empty scene */
@@ -97,7 +138,7 @@ namespace embree
           return;
         }
  
-        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "SubdivPatch1BuilderSAH");
+        double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + (lazy ? "SubdivPatch1LazyBuilderSAH" : "SubdivPatch1BuilderSAH"));
 
         //bvh->alloc.reset();
         bvh->alloc.init_estimate(numPrimitives*sizeof(PrimRef));
@@ -140,6 +181,10 @@ namespace embree
           return;
         }
 
+        /* lazy leaves reference their patch, thus patches have to stay alive */
+        if (lazy) bvh->subdiv_patches.resize(sizeof(SubdivPatch1) * numSubPatches);
+        SubdivPatch1* const subdiv_patches = (SubdivPatch1*) bvh->subdiv_patches.data();
+
         PrimInfo pinfo3 = parallel_for_for_prefix_sum1( pstate, iter, PrimInfo(empty), [&](SubdivMesh* mesh, const range<size_t>& r, size_t k, size_t geomID, const PrimInfo& base) -> PrimInfo
         {
           Allocator alloc = bvh->alloc.getCachedAllocator();
@@ -150,9 +195,16 @@ namespace embree
             
             patch_eval_subdivision(mesh->getHalfEdge(0,f),[&](const Vec2f uv[4], const int subdiv[4], const float edge_level[4], int subPatch)
             {
-              SubdivPatch1Base patch(unsigned(geomID),unsigned(f),subPatch,mesh,0,uv,edge_level,subdiv,VSIZEX);
-              size_t num = createEager(patch,scene,mesh,unsigned(f),alloc,&prims[base.end+s.end]);
-              assert(num == getNumEagerLeaves(patch.grid_u_res,patch.grid_v_res));
+              size_t num = 0;
+              if (lazy) {
+                SubdivPatch1* patch = new (&subdiv_patches[base.begin+s.begin]) SubdivPatch1(unsigned(geomID),unsigned(f),subPatch,mesh,0,uv,edge_level,subdiv,VSIZEX);
+                num = createLazy(patch,mesh,alloc,&prims[base.end+s.end]);
+                assert(num == getNumEagerLeaves(patch->grid_u_res,patch->grid_v_res));
+              } else {
+                SubdivPatch1Base patch(unsigned(geomID),unsigned(f),subPatch,mesh,0,uv,edge_level,subdiv,VSIZEX);
+                num = createEager(patch,scene,mesh,unsigned(f),alloc,&prims[base.end+s.end]);
+                assert(num == getNumEagerLeaves(patch.grid_u_res,patch.grid_v_res));
+              }
               for (size_t i=0; i<num; i++)
                 s.add_center2(prims[base.end+s.end]);
               s.begin++;
@@ -171,12 +223,14 @@ namespace embree
 
         /* settings for BVH build */
         GeneralBVHBuilder::Settings settings;
+        settings.branchingFactor = N;
         settings.logBlockSize = bsr(N);
         settings.minLeafSize = 1;
         settings.maxLeafSize = 1;
         settings.travCost = 1.0f;
         settings.intCost = 1.0f;
         settings.singleThreadThreshold = DEFAULT_SINGLE_THREAD_THRESHOLD;
+        applySceneBuildArguments<N>(settings,scene,1);
 
         NodeRef root = BVHNBuilderVirtual<N>::build(&bvh->alloc,createLeaf,virtualprogress,prims.data(),pinfo,settings);
         bvh->set(root,LBBox3fa(pinfo.geomBounds),pinfo.size());
@@ -334,6 +388,7 @@ namespace embree
         settings.travCost = 1.0f;
         settings.intCost = 1.0f;
         settings.singleLeafTimeSegment = false;
+        applySceneBuildArguments<N>(settings,scene,1);
 
         /* build hierarchy */
         auto root =
@@ -400,7 +455,8 @@ namespace embree
     };
     
     /* entry functions for the scene builder */
-    Builder* BVH4SubdivPatch1BuilderSAH(void* bvh, Scene* scene, size_t mode) { return new BVHNSubdivPatch1BuilderSAH<4>((BVH4*)bvh,scene); }
+    Builder* BVH4SubdivPatch1BuilderSAH(void* bvh, Scene* scene, size_t mode) { return new BVHNSubdivPatch1BuilderSAH<4>((BVH4*)bvh,scene,false); }
+    Builder* BVH4SubdivPatch1LazyBuilderSAH(void* bvh, Scene* scene, size_t mode) { return new BVHNSubdivPatch1BuilderSAH<4>((BVH4*)bvh,scene,true); }
     Builder* BVH4SubdivPatch1MBBuilderSAH(void* bvh, Scene* scene, size_t mode) { return new BVHNSubdivPatch1MBlurBuilderSAH<4>((BVH4*)bvh,scene); }
   }
 }
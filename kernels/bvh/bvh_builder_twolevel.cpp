@@ -16,6 +16,7 @@
 
 #include "bvh_builder_twolevel.h"
 #include "bvh_statistics.h"
+#include "bvh_builder_arguments.h"
 #include "../builders/bvh_builder_sah.h"
 #include "../common/scene_line_segments.h"
 #include "../common/scene_triangle_mesh.h"
@@ -30,13 +31,19 @@
 #define SPLIT_MEMORY_RESERVE_SCALE 2
 #define SPLIT_MIN_EXT_SPACE 1000
 
+/* full toplevel rebuild once refitting increased the SAH cost by this factor */
+#define REFIT_MAX_SAH_DEGRADATION 1.3f
+#define INVALID_SLOT_OWNER 0xFFFFFFFF
+#define LEAF_SLOT_OWNER 0x80000000
+
 namespace embree
 {
   namespace isa
   {
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::BVHNBuilderTwoLevel (BVH* bvh, Scene* scene, const createMeshAccelTy createMeshAccel, const size_t singleThreadThreshold)
-      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold) {}
+      : bvh(bvh), objects(bvh->objects), scene(scene), createMeshAccel(createMeshAccel), refs(scene->device,0), prims(scene->device,0), singleThreadThreshold(singleThreadThreshold),
+        topNodes(scene->device,0), topLeaves(scene->device,0), objectLeaves(scene->device,0), topRoot(0), topSAH(0.0f), fullSAH(0.0f) {}
     
     template<int N, typename Mesh>
     BVHNBuilderTwoLevel<N,Mesh>::~BVHNBuilderTwoLevel () {
@@ -64,13 +71,12 @@ namespace embree
       while(1) 
 #endif
       {
-      /* reset memory allocator */
-      bvh->alloc.reset();
-      
       /* skip build for empty scene */
       const size_t numPrimitives = scene->getNumPrimitives(Mesh::geom_type,false);
 
       if (numPrimitives == 0) {
+        bvh->alloc.reset();
+        objectLeafOffsets.clear();
         prims.resize(0);
         bvh->set(BVH::emptyNode,empty,0);
         return;
@@ -83,6 +89,9 @@ namespace embree
       if (builders.size() < num) builders.resize(num);
       if (refs.size()     < num) refs.resize(num);
       nextRef.store(0);
+
+      /* the toplevel BVH can only get refit if the same objects are present as in the last build */
+      std::atomic<bool> toplevelChanged(objectLeafOffsets.size() != num+1);
       
       /* create acceleration structures */
       parallel_for(size_t(0), num, [&] (const range<size_t>& r)
@@ -100,6 +109,7 @@ namespace embree
             Builder* builder = nullptr;
             createMeshAccel(scene, unsigned(objectID),(AccelData*&)objects[objectID],builder);
             builders[objectID] = BuilderState(builder,mesh->quality);
+            toplevelChanged = true;
           }
 
           /* re-create when build quality changed */
@@ -108,6 +118,7 @@ namespace embree
             delete objects[objectID]; 
             createMeshAccel(scene, unsigned(objectID),(AccelData*&)objects[objectID],builder);
             builders[objectID] = BuilderState(builder,mesh->quality);
+            toplevelChanged = true;
           }
         }
       });
@@ -119,8 +130,10 @@ namespace embree
         {
           /* ignore if no triangle mesh or not enabled */
           Mesh* mesh = scene->getSafe<Mesh>(objectID);
-          if (mesh == nullptr || !mesh->isEnabled() || mesh->numTimeSteps != 1) 
+          if (mesh == nullptr || !mesh->isEnabled() || mesh->numTimeSteps != 1) {
+            if (in_toplevel(objectID)) toplevelChanged = true;
             continue;
+          }
         
           BVH*     object  = objects [objectID]; assert(object);
           Ref<Builder>& builder = builders[objectID].builder; assert(builder);
@@ -138,9 +151,21 @@ namespace embree
             refs[nextRef++] = BVHNBuilderTwoLevel::BuildRef(object->getBounds(),object->root);
 #endif
           }
+
+          if (object->getBounds().empty() == in_toplevel(objectID))
+            toplevelChanged = true;
         }
       });
 
+      /* only refit the previous toplevel BVH if the set of objects did not change */
+      if (!toplevelChanged && nextRef > 1 && refit_toplevel(num)) {
+        bvh->postBuild(t0);
+        return;
+      }
+
+      /* reset memory allocator */
+      bvh->alloc.reset();
+      objectLeafOffsets.clear();
 
 #if PROFILE
       double d0 = getSeconds();
@@ -218,24 +243,51 @@ namespace embree
             settings.travCost = 1.0f;
             settings.intCost = 1.0f;
             settings.singleThreadThreshold = singleThreadThreshold;
+            applySceneBuildArguments<N>(settings,scene,1);
       
 #if ENABLE_DIRECT_SAH_MERGE_BUILDER
             refs.resize(extSize); 
+
+            /* record where nodes and leaves get stored to later refit the toplevel BVH */
+            topNodes.resize(extSize);
+            topLeaves.resize(extSize);
+            nextTopNode.store(0);
+            nextTopLeaf.store(0);
          
-            NodeRef root = BVHBuilderBinnedOpenMergeSAH::build<NodeRef,BuildRef>(
+            const TopLevelRef root = BVHBuilderBinnedOpenMergeSAH::build<TopLevelRef,BuildRef>(
               typename BVH::CreateAlloc(bvh),
               typename BVH::AlignedNode::Create2(),
-              typename BVH::AlignedNode::Set2(),
               
-              [&] (const BuildRef* refs, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> NodeRef  {
+              [&] (const BVHBuilderBinnedOpenMergeSAH::BuildRecord& precord, const BVHBuilderBinnedOpenMergeSAH::BuildRecord* crecords, NodeRef ref, TopLevelRef* children, const size_t num) -> TopLevelRef {
+                AlignedNode* node = ref.alignedNode();
+                const unsigned int nodeID = nextTopNode++;
+                topNodes[nodeID] = TopLevelNode(node,nodeID,0);
+                for (size_t i=0; i<num; i++) {
+                  node->setRef(i,children[i].ref);
+                  if (children[i].leaf) {
+                    topLeaves[nextTopLeaf++] = TopLevelLeaf(nodeID,(unsigned int)i,children[i].id);
+                  } else {
+                    topNodes[children[i].id].parent = nodeID;
+                    topNodes[children[i].id].slot = (unsigned int)i;
+                  }
+                }
+                return TopLevelRef(ref,nodeID,false);
+              },
+              [&] (const BuildRef* refs, const range<size_t>& range, const FastAllocator::CachedAllocator& alloc) -> TopLevelRef  {
                 assert(range.size() == 1);
-                return (NodeRef) refs[range.begin()].node;
+                return TopLevelRef(refs[range.begin()].node,refs[range.begin()].geomID(),true);
               },
               [&] (BuildRef &bref, BuildRef *refs) -> size_t { 
                 return openBuildRef(bref,refs);
               },              
               [&] (size_t dn) { bvh->scene->progressMonitor(0); },
               refs.data(),extSize,pinfo,settings);
+
+            if (!root.leaf) {
+              topRoot = root.id;
+              finish_toplevel(num);
+            }
+            bvh->set(root.ref,LBBox3fa(pinfo.geomBounds),numPrimitives);
 #else
             NodeRef root = BVHBuilderBinnedSAH::build<NodeRef>(
               typename BVH::CreateAlloc(bvh),
@@ -248,10 +300,9 @@ namespace embree
               },
               [&] (size_t dn) { bvh->scene->progressMonitor(0); },
               prims.data(),pinfo,settings);
-#endif
 
-            
             bvh->set(root,LBBox3fa(pinfo.geomBounds),numPrimitives);
+#endif
           }
         }
 #if defined(TASKING_TBB) && defined(__AVX512ER__) && USE_TASK_ARENA // KNL
@@ -278,6 +329,32 @@ namespace embree
       delete objects [geomID]; objects [geomID] = nullptr;
     }
 
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::hideGeometry(size_t geomID)
+    {
+      /* the BVH of a single object is used as toplevel BVH */
+      if (objectLeafOffsets.empty()) {
+        if (geomID < objects.size() && objects[geomID] && bvh->root == objects[geomID]->root)
+          bvh->hideSubtree(nullptr,0);
+        return;
+      }
+      if (!in_toplevel(geomID))
+        return;
+
+      /* empty the bounds of all toplevel leaves of the object, the child slots are located by walking up to the root */
+      std::vector<unsigned int> path;
+      for (unsigned int i=objectLeafOffsets[geomID+0]; i<objectLeafOffsets[geomID+1]; i++)
+      {
+        if (objectLeaves[i].node == INVALID_SLOT_OWNER) continue;
+        path.clear();
+        path.push_back(objectLeaves[i].slot);
+        for (unsigned int n=objectLeaves[i].node; n != topRoot; n=topNodes[n].parent)
+          path.push_back(topNodes[n].slot);
+        std::reverse(path.begin(),path.end());
+        bvh->hideSubtree(path.data(),path.size());
+      }
+    }
+
     template<int N, typename Mesh>
     void BVHNBuilderTwoLevel<N,Mesh>::clear()
     {
@@ -288,6 +365,123 @@ namespace embree
 	if (builders[i].builder) builders[i].builder->clear();
 
       refs.clear();
+      objectLeafOffsets.clear();
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::finish_toplevel(const size_t numObjects)
+    {
+      /* counting sort of the leaves by object */
+      const size_t numLeaves = nextTopLeaf;
+      objectLeafOffsets.assign(numObjects+1,0);
+      for (size_t i=0; i<numLeaves; i++)
+        objectLeafOffsets[topLeaves[i].geomID+1]++;
+      for (size_t i=0; i<numObjects; i++)
+        objectLeafOffsets[i+1] += objectLeafOffsets[i];
+
+      objectLeaves.resize(numLeaves);
+      std::vector<unsigned int> next(objectLeafOffsets.begin(),objectLeafOffsets.end()-1);
+      for (size_t i=0; i<numLeaves; i++)
+        objectLeaves[next[topLeaves[i].geomID]++] = topLeaves[i];
+
+      /* record which toplevel node or leaf occupies each child slot */
+      const size_t numNodes = nextTopNode;
+      slotOwners.resize(numNodes*N);
+      for (size_t i=0; i<numNodes*N; i++)
+        slotOwners[i] = INVALID_SLOT_OWNER;
+      for (size_t i=0; i<numNodes; i++)
+        if (i != topRoot) slotOwners[topNodes[i].parent*N+topNodes[i].slot] = (unsigned int)i;
+      for (size_t i=0; i<numLeaves; i++)
+        slotOwners[objectLeaves[i].node*N+objectLeaves[i].slot] = (unsigned int)i | LEAF_SLOT_OWNER;
+
+      /* SAH cost of the toplevel BVH relative to the root bounds */
+      topSAH = parallel_reduce(size_t(0), size_t(nextTopNode), 0.0f, [&] (const range<size_t>& r) -> float {
+          float sah = 0.0f;
+          for (size_t i=r.begin(); i<r.end(); i++)
+            for (size_t j=0; j<N; j++)
+              sah += childArea(topNodes[i].node->bounds(j));
+          return sah;
+        }, std::plus<float>());
+      fullSAH = topSAH / halfArea(topNodes[topRoot].node->bounds());
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::update_toplevel(unsigned int nodeID, size_t slot, NodeRef ref, BBox3fa bounds)
+    {
+      AlignedNode* node = topNodes[nodeID].node;
+      node->setRef(slot,ref);
+
+      while (true)
+      {
+        /* stop as soon as the bounds of some node do not change */
+        const BBox3fa old = node->bounds(slot);
+        if (old == bounds) break;
+        topSAH += childArea(bounds) - childArea(old);
+        node->setBounds(slot,bounds);
+
+        if (nodeID == topRoot) break;
+        bounds = node->bounds();
+        slot = topNodes[nodeID].slot;
+        nodeID = topNodes[nodeID].parent;
+        node = topNodes[nodeID].node;
+      }
+    }
+
+    template<int N, typename Mesh>
+    void BVHNBuilderTwoLevel<N,Mesh>::remove_toplevel(unsigned int nodeID, size_t slot)
+    {
+      update_toplevel(nodeID,slot,BVH::emptyNode,empty);
+
+      /* packet traversal stops at the first empty child, thus move the last valid child into the cleared slot */
+      AlignedNode* node = topNodes[nodeID].node;
+      size_t last = slot;
+      while (last+1 < N && node->child(last+1) != BVH::emptyNode) last++;
+
+      if (last != slot)
+      {
+        node->swap(slot,last);
+        const unsigned int owner = slotOwners[nodeID*N+last];
+        if (owner & LEAF_SLOT_OWNER) objectLeaves[owner & ~LEAF_SLOT_OWNER].slot = (unsigned int)slot;
+        else                         topNodes[owner].slot = (unsigned int)slot;
+        slotOwners[nodeID*N+slot] = owner;
+        slotOwners[nodeID*N+last] = INVALID_SLOT_OWNER;
+        return;
+      }
+      slotOwners[nodeID*N+slot] = INVALID_SLOT_OWNER;
+
+      /* remove nodes that lost all their children from their parent */
+      if (slot == 0 && nodeID != topRoot)
+        remove_toplevel(topNodes[nodeID].parent,topNodes[nodeID].slot);
+    }
+
+    template<int N, typename Mesh>
+    bool BVHNBuilderTwoLevel<N,Mesh>::refit_toplevel(const size_t numObjects)
+    {
+      for (size_t objectID=0; objectID<numObjects; objectID++)
+      {
+        if (!in_toplevel(objectID) || !scene->isGeometryModified(objectID))
+          continue;
+
+        /* the rebuilt object BVH replaces the first leaf of the object, further leaves pointed into the old object BVH and get removed */
+        const BVH* object = objects[objectID];
+        const unsigned int begin = objectLeafOffsets[objectID+0];
+        const unsigned int end   = objectLeafOffsets[objectID+1];
+        update_toplevel(objectLeaves[begin].node,objectLeaves[begin].slot,object->root,object->getBounds());
+        for (unsigned int i=begin+1; i<end; i++)
+        {
+          if (objectLeaves[i].node == INVALID_SLOT_OWNER) continue; // already removed by some earlier refit
+          remove_toplevel(objectLeaves[i].node,objectLeaves[i].slot);
+          objectLeaves[i].node = INVALID_SLOT_OWNER;
+        }
+      }
+
+      /* rebuild if the toplevel BVH degraded too much */
+      const BBox3fa bounds = topNodes[topRoot].node->bounds();
+      if (topSAH > REFIT_MAX_SAH_DEGRADATION*fullSAH*halfArea(bounds))
+        return false;
+
+      bvh->set(BVH::encodeNode(topNodes[topRoot].node),LBBox3fa(bounds),scene->getNumPrimitives(Mesh::geom_type,false));
+      return true;
     }
 
     template<int N, typename Mesh>
@@ -109,10 +109,34 @@ namespace embree
       /*! builder entry point */
       void build();
       void deleteGeometry(size_t geomID);
+      void hideGeometry(size_t geomID);
       void clear();
 
       void open_sequential(const size_t extSize);
 
+    private:
+
+      /*! updates the previous toplevel BVH for all modified objects, returns false if a full rebuild is required */
+      bool refit_toplevel(const size_t numObjects);
+
+      /*! sets the specified child of a toplevel node and updates the bounds of all parent nodes */
+      void update_toplevel(unsigned int nodeID, size_t slot, NodeRef ref, BBox3fa bounds);
+
+      /*! clears the specified child of a toplevel node and keeps the remaining children compact */
+      void remove_toplevel(unsigned int nodeID, size_t slot);
+
+      /*! groups the leaves of the new toplevel BVH by object and calculates its SAH cost */
+      void finish_toplevel(const size_t numObjects);
+
+      /*! returns true if the object is referenced by the previous toplevel BVH */
+      __forceinline bool in_toplevel(const size_t objectID) const {
+        return objectID+1 < objectLeafOffsets.size() && objectLeafOffsets[objectID] != objectLeafOffsets[objectID+1];
+      }
+
+      __forceinline static float childArea(const BBox3fa& bounds) {
+        return bounds.empty() ? 0.0f : halfArea(bounds);
+      }
+
     public:
       
       struct BuilderState
@@ -148,6 +172,56 @@ namespace embree
 
       typedef mvector<BuildRef> bvector;
 
+      /*! result of the toplevel build, either a node or a leaf pointing into some object BVH */
+      struct TopLevelRef
+      {
+        __forceinline TopLevelRef () {}
+
+        __forceinline TopLevelRef (NodeRef ref, unsigned int id, bool leaf)
+          : ref(ref), id(id), leaf(leaf) {}
+
+        NodeRef ref;
+        unsigned int id;  //!< index of the node or geomID of the leaf
+        bool leaf;
+      };
+
+      /*! node of the toplevel BVH and its location inside the parent node */
+      struct TopLevelNode
+      {
+        __forceinline TopLevelNode () {}
+
+        __forceinline TopLevelNode (AlignedNode* node, unsigned int parent, unsigned int slot)
+          : node(node), parent(parent), slot(slot) {}
+
+        AlignedNode* node;
+        unsigned int parent;  //!< the root node is its own parent
+        unsigned int slot;
+      };
+
+      /*! location of a toplevel leaf of some object inside its parent node */
+      struct TopLevelLeaf
+      {
+        __forceinline TopLevelLeaf () {}
+
+        __forceinline TopLevelLeaf (unsigned int node, unsigned int slot, unsigned int geomID)
+          : node(node), slot(slot), geomID(geomID) {}
+
+        unsigned int node;
+        unsigned int slot;
+        unsigned int geomID;
+      };
+
+      mvector<TopLevelNode> topNodes;
+      mvector<TopLevelLeaf> topLeaves;
+      mvector<TopLevelLeaf> objectLeaves;          //!< toplevel leaves sorted by object
+      std::vector<unsigned int> objectLeafOffsets; //!< start of the leaves of each object in objectLeaves
+      std::vector<unsigned int> slotOwners;        //!< toplevel node or leaf (marked with LEAF_SLOT_OWNER) stored in each child slot
+      std::atomic<unsigned int> nextTopNode;
+      std::atomic<unsigned int> nextTopLeaf;
+      unsigned int topRoot;                        //!< index of the root node
+      float topSAH;                                //!< sum of the surface areas of all toplevel children
+      float fullSAH;                               //!< normalized SAH cost after the last full rebuild
+
     };
   }
 }
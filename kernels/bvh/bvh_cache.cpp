@@ -0,0 +1,356 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#include "bvh_cache.h"
+#include "../common/scene_triangle_mesh.h"
+#include "../common/scene_quad_mesh.h"
+#include "../../common/algorithms/parallel_for.h"
+
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+
+namespace embree
+{
+  namespace isa
+  {
+    static const char bvhCacheMagic[8] = { 'e','m','b','r','e','e','b','c' };
+    static const unsigned int bvhCacheVersion = 1;
+
+    /*! 64 bit hash over geometry content and build settings */
+    struct BVHCacheHash
+    {
+      __forceinline BVHCacheHash () : h(0xcbf29ce484222325ull) {}
+
+      __forceinline void add(uint64_t v)
+      {
+        h ^= v + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+        h *= 0xff51afd7ed558ccdull;
+        h ^= h >> 33;
+      }
+
+      __forceinline void add(const void* ptr, size_t bytes)
+      {
+        const char* p = (const char*) ptr;
+        for (size_t i=0; i<bytes; i+=4) {
+          unsigned int v = 0;
+          memcpy(&v,p+i,min(bytes-i,size_t(4)));
+          add(uint64_t(v));
+        }
+      }
+
+      void add(const std::string& str)
+      {
+        add(uint64_t(str.size()));
+        add(str.data(),str.size());
+      }
+
+      /*! hashes blocks of items in parallel and combines the block hashes in order */
+      template<typename T>
+      void add(const BufferView<T>& buffer, size_t bytesPerItem)
+      {
+        static const size_t blockSize = 64*1024;
+        const size_t numItems = buffer.size();
+        const size_t numBlocks = (numItems+blockSize-1)/blockSize;
+        std::vector<uint64_t> blocks(numBlocks);
+        parallel_for(numBlocks, [&] (size_t b) {
+            BVHCacheHash hash;
+            const size_t end = min(numItems,(b+1)*blockSize);
+            for (size_t i=b*blockSize; i<end; i++)
+              hash.add(buffer.getPtr(i),bytesPerItem);
+            blocks[b] = hash.h;
+          });
+
+        add(uint64_t(numItems));
+        for (size_t b=0; b<numBlocks; b++)
+          add(blocks[b]);
+      }
+
+      uint64_t h;
+    };
+
+    template<int N>
+    BVHNCachedBuilder<N>::BVHNCachedBuilder (BVH* bvh, Scene* scene, Builder* builder, const std::string& name)
+      : bvh(bvh), scene(scene), builder(builder), name(name) {}
+
+    template<int N>
+    void BVHNCachedBuilder<N>::clear()
+    {
+      if (builder)
+        builder->clear();
+    }
+
+    template<int N>
+    void BVHNCachedBuilder<N>::build()
+    {
+      const uint64_t key = this->key();
+      const FileName fileName = this->fileName(key);
+      if (load(fileName,key))
+        return;
+
+      /* release a previously mapped BVH before building into the allocator */
+      if (bvh->mappedPtr)
+        bvh->clear();
+
+      builder->build();
+
+      if (!save(fileName,key) && scene->device->verbosity(2))
+        std::cout << name << " not stored to BVH cache" << std::endl;
+    }
+
+    template<int N>
+    uint64_t BVHNCachedBuilder<N>::key() const
+    {
+      BVHCacheHash hash;
+      hash.add(name);
+      hash.add(std::string(bvh->primTy->name()));
+
+      /* build settings */
+      hash.add(uint64_t(scene->scene_flags));
+      hash.add(uint64_t(scene->quality_flags));
+      const RTCBuildArguments& args = scene->buildArguments;
+      hash.add(uint64_t(args.byteSize));
+      if (args.byteSize)
+      {
+        hash.add(uint64_t(args.maxBranchingFactor));
+        hash.add(uint64_t(args.maxDepth));
+        hash.add(uint64_t(args.sahBlockSize));
+        hash.add(uint64_t(args.minLeafSize));
+        hash.add(uint64_t(args.maxLeafSize));
+        hash.add(&args.traversalCost,sizeof(float));
+        hash.add(&args.intersectionCost,sizeof(float));
+      }
+      Device* device = scene->device;
+      hash.add(device->tri_builder);
+      hash.add(device->quad_builder);
+      hash.add(&device->max_spatial_split_replications,sizeof(float));
+      hash.add(uint64_t(device->useSpatialPreSplits));
+
+      /* geometry content, geometry IDs are stored inside the leaves */
+      hash.add(uint64_t(scene->size()));
+      for (size_t geomID=0; geomID<scene->size(); geomID++)
+      {
+        Geometry* geom = scene->get(geomID);
+        if (geom == nullptr || scene->isGeometryHidden(geomID)) {
+          hash.add(uint64_t(-1));
+          continue;
+        }
+
+        hash.add(uint64_t(geom->getType()));
+        hash.add(uint64_t(geom->isEnabled()));
+        hash.add(uint64_t(geom->numTimeSteps));
+
+        if (geom->getType() == Geometry::GTY_TRIANGLE_MESH)
+        {
+          TriangleMesh* mesh = (TriangleMesh*) geom;
+          hash.add(mesh->triangles,sizeof(TriangleMesh::Triangle));
+          for (size_t t=0; t<mesh->vertices.size(); t++)
+            hash.add(mesh->vertices[t],3*sizeof(float));
+        }
+        else if (geom->getType() == Geometry::GTY_QUAD_MESH)
+        {
+          QuadMesh* mesh = (QuadMesh*) geom;
+          hash.add(mesh->quads,sizeof(QuadMesh::Quad));
+          for (size_t t=0; t<mesh->vertices.size(); t++)
+            hash.add(mesh->vertices[t],3*sizeof(float));
+        }
+        else
+          hash.add(uint64_t(geom->size()));
+      }
+      return hash.h;
+    }
+
+    template<int N>
+    FileName BVHNCachedBuilder<N>::fileName(uint64_t key) const
+    {
+      std::stringstream str;
+      str << "bvh" << N << "_" << bvh->primTy->name() << "_" << std::hex << std::setw(16) << std::setfill('0') << key << ".bvh";
+      return FileName(scene->device->bvh_cache) + str.str();
+    }
+
+    template<int N>
+    bool BVHNCachedBuilder<N>::load(const FileName& fileName, uint64_t key)
+    {
+      size_t bytes = 0;
+      char* ptr = (char*) os_map_file(fileName.c_str(),bytes);
+      if (ptr == nullptr)
+        return false;
+
+      const Header* header = (const Header*) ptr;
+      bool valid = bytes >= sizeof(Header)
+        && memcmp(header->magic,bvhCacheMagic,sizeof(bvhCacheMagic)) == 0
+        && header->version == bvhCacheVersion
+        && header->branchingFactor == N
+        && strncmp(header->primTy,bvh->primTy->name(),sizeof(header->primTy)) == 0
+        && header->key == key
+        && header->bytes == bytes;
+
+      NodeRef root = valid ? NodeRef(header->root) : NodeRef(BVH::emptyNode);
+      valid = valid && relocate(root,ptr,bytes,0);
+      if (!valid) {
+        os_unmap_file(ptr,bytes);
+        return false;
+      }
+
+      const double t0 = bvh->preBuild(TOSTRING(isa) "::BVH" + toString(N) + "Cache");
+      bvh->clear();
+      bvh->set(root,header->bounds,header->numPrimitives);
+      bvh->mappedPtr = ptr;
+      bvh->mappedBytes = bytes;
+      bvh->postBuild(t0);
+      return true;
+    }
+
+    template<int N>
+    bool BVHNCachedBuilder<N>::relocate(NodeRef& ref, char* base, size_t bytes, size_t depth)
+    {
+      if (ref == BVH::emptyNode)
+        return true;
+
+      /* never trust the file content */
+      const size_t ofs = size_t(ref) & ~BVH::align_mask;
+      const size_t ty  = size_t(ref) &  BVH::align_mask;
+      if (depth > BVH::maxDepth || ofs < sizeof(Header) || ofs >= bytes)
+        return false;
+
+      ref = NodeRef(size_t(base) + size_t(ref));
+
+      if (ref.isLeaf()) {
+        size_t num; char* prim = ref.leaf(num);
+        return ofs + num*bvh->primTy->getBytes(prim) <= bytes;
+      }
+
+      size_t nodeBytes = 0;
+      if      (ty == BVH::tyAlignedNode  ) nodeBytes = sizeof(AlignedNode);
+      else if (ty == BVH::tyQuantizedNode) nodeBytes = sizeof(QuantizedNode);
+      if (nodeBytes == 0 || ofs+nodeBytes > bytes)
+        return false;
+
+      BaseNode* node = ref.baseNode();
+      for (size_t i=0; i<N; i++)
+        if (!relocate(node->child(i),base,bytes,depth+1))
+          return false;
+
+      return true;
+    }
+
+    /*! appends a block to the file data, blocks are cache line aligned */
+    static size_t appendBlock(std::vector<char>& data, const void* ptr, size_t bytes, size_t alignment)
+    {
+      const size_t pos = (data.size()+alignment-1) & ~(alignment-1);
+      data.resize(pos+bytes);
+      memcpy(data.data()+pos,ptr,bytes);
+      return pos;
+    }
+
+    template<int N>
+    bool BVHNCachedBuilder<N>::serialize(NodeRef ref, std::vector<char>& data, uint64_t& ofs)
+    {
+      if (ref == BVH::emptyNode) {
+        ofs = BVH::emptyNode;
+        return true;
+      }
+
+      const size_t ty = size_t(ref) & BVH::align_mask;
+      if (ref.isLeaf())
+      {
+        size_t num; const char* prim = ref.leaf(num);
+        const size_t pos = appendBlock(data,prim,num*bvh->primTy->getBytes(prim),fileAlignment);
+        ofs = pos | ty;
+        return true;
+      }
+
+      /* nodes of other types may reference data outside the BVH */
+      size_t nodeBytes = 0;
+      if      (ty == BVH::tyAlignedNode  ) nodeBytes = sizeof(AlignedNode);
+      else if (ty == BVH::tyQuantizedNode) nodeBytes = sizeof(QuantizedNode);
+      if (nodeBytes == 0)
+        return false;
+
+      BaseNode* node = ref.baseNode();
+      const size_t pos = appendBlock(data,node,nodeBytes,fileAlignment);
+      for (size_t i=0; i<N; i++)
+      {
+        uint64_t child;
+        if (!serialize(node->child(i),data,child))
+          return false;
+
+        const size_t childOfs = (char*)&node->child(i) - (char*)node;
+        memcpy(data.data()+pos+childOfs,&child,sizeof(child));
+      }
+      ofs = pos | ty;
+      return true;
+    }
+
+    template<int N>
+    bool BVHNCachedBuilder<N>::save(const FileName& fileName, uint64_t key)
+    {
+      /* two level BVHs reference the BVHs of their objects */
+      if (bvh->root == BVH::emptyNode || !bvh->objects.empty())
+        return false;
+
+      std::vector<char> data((sizeof(Header)+fileAlignment-1) & ~(fileAlignment-1),0);
+      uint64_t root;
+      if (!serialize(bvh->root,data,root))
+        return false;
+
+      Header header;
+      memcpy(header.magic,bvhCacheMagic,sizeof(bvhCacheMagic));
+      header.version = bvhCacheVersion;
+      header.branchingFactor = N;
+      strncpy(header.primTy,bvh->primTy->name(),sizeof(header.primTy)-1);
+      header.primTy[sizeof(header.primTy)-1] = 0;
+      header.key = key;
+      header.bytes = data.size();
+      header.root = root;
+      header.numPrimitives = bvh->numPrimitives;
+      header.bounds = bvh->bounds;
+      memcpy(data.data(),&header,sizeof(Header));
+
+      /* write to a temporary file first such that readers never see partial files */
+      const std::string tmpName = fileName.str() + "." + toString(size_t(this)) + ".tmp";
+      {
+        std::ofstream file(tmpName.c_str(),std::ios::binary);
+        if (!file.is_open())
+          return false;
+        file.write(data.data(),data.size());
+        if (!file.good()) {
+          file.close();
+          std::remove(tmpName.c_str());
+          return false;
+        }
+      }
+
+      std::remove(fileName.c_str());
+      if (std::rename(tmpName.c_str(),fileName.c_str()) != 0) {
+        std::remove(tmpName.c_str());
+        return false;
+      }
+      return true;
+    }
+
+    Builder* BVH4CachedBuilder (void* bvh, Scene* scene, Builder* builder, const char* name) {
+      return new BVHNCachedBuilder<4>((BVH4*)bvh,scene,builder,name);
+    }
+
+#if defined(__AVX__)
+    Builder* BVH8CachedBuilder (void* bvh, Scene* scene, Builder* builder, const char* name) {
+      return new BVHNCachedBuilder<8>((BVH8*)bvh,scene,builder,name);
+    }
+#endif
+  }
+}
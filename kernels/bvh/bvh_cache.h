@@ -0,0 +1,90 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+
+#pragma once
+
+#include "../bvh/bvh.h"
+#include "../common/builder.h"
+#include "../../common/sys/filename.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! Builder that stores the BVH in a directory of cache files
+     *  keyed by a hash over the geometry content and build
+     *  settings. When a cache file matches, the BVH gets memory
+     *  mapped instead of built. Only BVHs of aligned and quantized
+     *  nodes over position independent leaves can get cached. */
+    template<int N>
+    class BVHNCachedBuilder : public Builder
+    {
+      /*! Type shortcuts */
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::BaseNode BaseNode;
+      typedef typename BVH::AlignedNode AlignedNode;
+      typedef typename BVH::QuantizedNode QuantizedNode;
+
+      /*! header at the start of each cache file */
+      struct Header
+      {
+        char magic[8];               //!< identifies embree BVH cache files
+        unsigned int version;        //!< version of the file layout
+        unsigned int branchingFactor;//!< N of the stored BVH
+        char primTy[48];             //!< name of the stored primitive type
+        uint64_t key;                //!< hash of geometry content and build settings
+        uint64_t bytes;              //!< size of the entire file
+        uint64_t root;               //!< relocatable root node
+        uint64_t numPrimitives;      //!< number of primitives in the BVH
+        LBBox3fa bounds;             //!< bounds of the BVH
+      };
+
+      /*! nodes and leaves are stored with this alignment */
+      static const size_t fileAlignment = 64;
+
+    public:
+      BVHNCachedBuilder (BVH* bvh, Scene* scene, Builder* builder, const std::string& name);
+
+      virtual void build();
+
+      virtual void clear();
+
+    private:
+
+      /*! hashes all geometry content and build settings the BVH depends on */
+      uint64_t key() const;
+
+      /*! returns the cache file name for some key */
+      FileName fileName(uint64_t key) const;
+
+      /*! maps a matching cache file into the BVH */
+      bool load(const FileName& fileName, uint64_t key);
+      bool relocate(NodeRef& ref, char* base, size_t bytes, size_t depth);
+
+      /*! stores the BVH to the cache */
+      bool save(const FileName& fileName, uint64_t key);
+      bool serialize(NodeRef ref, std::vector<char>& data, uint64_t& ofs);
+
+    private:
+      BVH* bvh;
+      Scene* scene;
+      std::unique_ptr<Builder> builder;
+      std::string name;  //!< distinguishes node layouts of BVHs over the same primitive type
+    };
+  }
+}
@@ -23,7 +23,6 @@ namespace embree
   {
 #define CSTAT(x)
 
-    size_t parallel_depth_threshold = 3;
     CSTAT(std::atomic<size_t> bvh_collide_traversal_steps(0));
     CSTAT(std::atomic<size_t> bvh_collide_leaf_pairs(0));
     CSTAT(std::atomic<size_t> bvh_collide_leaf_iterations(0));
@@ -34,19 +33,6 @@ namespace embree
     CSTAT(std::atomic<size_t> bvh_collide_prim_intersections5(0));
     CSTAT(std::atomic<size_t> bvh_collide_prim_intersections(0));
 
-    struct Collision
-    {
-      __forceinline Collision() {}
-
-      __forceinline Collision (unsigned geomID0, unsigned primID0, unsigned geomID1, unsigned primID1)
-        : geomID0(geomID0), primID0(primID0), geomID1(geomID1), primID1(primID1) {}
-
-      unsigned geomID0;
-      unsigned primID0;
-      unsigned geomID1;
-      unsigned primID1;
-    };
-    
     template<int N>
     __forceinline size_t overlap(const BBox3fa& box0, const typename BVHN<N>::AlignedNode& node1)
     {
@@ -121,11 +107,8 @@ namespace embree
     }
     
     template<int N>
-    __forceinline void BVHNColliderUserGeom<N>::processLeaf(NodeRef node0, NodeRef node1)
+    __forceinline void BVHNColliderUserGeom<N>::processLeaf(NodeRef node0, NodeRef node1, CollisionBuffer& buffer)
     {
-      Collision collisions[16];
-      size_t num_collisions = 0;
-
       size_t N0; Object* leaf0 = (Object*) node0.leaf(N0);
       size_t N1; Object* leaf1 = (Object*) node1.leaf(N1);
       for (size_t i=0; i<N0; i++) {
@@ -135,25 +118,208 @@ namespace embree
           const unsigned geomID1 = leaf1[j].geomID();
           const unsigned primID1 = leaf1[j].primID();
           if (this->scene0 == this->scene1 && geomID0 == geomID1 && primID0 == primID1) continue;
-          collisions[num_collisions++] = Collision(geomID0,primID0,geomID1,primID1);
-          if (num_collisions == 16) {
-            this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
-            num_collisions = 0;
+          buffer.add({geomID0,primID0,geomID1,primID1});
+        }
+      }
+    }
+
+    struct CollideTriangles
+    {
+      enum { MAX_PRIMS = 32, MAX_TRIANGLES = 2*MAX_PRIMS };
+
+      __forceinline CollideTriangles () : numTriangles(0), numPrims(0) {}
+
+      __forceinline void add(const Vec3fa& v0, const Vec3fa& v1, const Vec3fa& v2, const Vec3i& vi, unsigned geomID, unsigned primID)
+      {
+        assert(numTriangles < MAX_TRIANGLES);
+        const size_t i = numTriangles++;
+        v0x[i] = v0.x; v0y[i] = v0.y; v0z[i] = v0.z;
+        v1x[i] = v1.x; v1y[i] = v1.y; v1z[i] = v1.z;
+        v2x[i] = v2.x; v2y[i] = v2.y; v2z[i] = v2.z;
+        vi0[i] = vi.x; vi1[i] = vi.y; vi2[i] = vi.z;
+        geomIDs[i] = geomID;
+        primIDs[i] = primID;
+        prims[i] = (int) numPrims;
+      }
+
+      __forceinline void add(const TriangleMesh* mesh, unsigned geomID, unsigned primID)
+      {
+        const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+        add(mesh->vertex(tri.v[0]),mesh->vertex(tri.v[1]),mesh->vertex(tri.v[2]),Vec3i(tri.v[0],tri.v[1],tri.v[2]),geomID,primID);
+        numPrims++;
+      }
+
+      __forceinline void add(const QuadMesh* mesh, unsigned geomID, unsigned primID)
+      {
+        /* same triangle split as the quad intersectors use */
+        const QuadMesh::Quad& quad = mesh->quad(primID);
+        const Vec3fa p0 = mesh->vertex(quad.v[0]);
+        const Vec3fa p1 = mesh->vertex(quad.v[1]);
+        const Vec3fa p2 = mesh->vertex(quad.v[2]);
+        const Vec3fa p3 = mesh->vertex(quad.v[3]);
+        add(p0,p1,p3,Vec3i(quad.v[0],quad.v[1],quad.v[3]),geomID,primID);
+        add(p2,p3,p1,Vec3i(quad.v[2],quad.v[3],quad.v[1]),geomID,primID);
+        numPrims++;
+      }
+
+      __forceinline Vec3fa vertex0(size_t i) const { return Vec3fa(v0x[i],v0y[i],v0z[i]); }
+      __forceinline Vec3fa vertex1(size_t i) const { return Vec3fa(v1x[i],v1y[i],v1z[i]); }
+      __forceinline Vec3fa vertex2(size_t i) const { return Vec3fa(v2x[i],v2y[i],v2z[i]); }
+
+      size_t numTriangles;
+      size_t numPrims;
+      __aligned(16) float v0x[MAX_TRIANGLES], v0y[MAX_TRIANGLES], v0z[MAX_TRIANGLES];
+      __aligned(16) float v1x[MAX_TRIANGLES], v1y[MAX_TRIANGLES], v1z[MAX_TRIANGLES];
+      __aligned(16) float v2x[MAX_TRIANGLES], v2y[MAX_TRIANGLES], v2z[MAX_TRIANGLES];
+      __aligned(16) int vi0[MAX_TRIANGLES], vi1[MAX_TRIANGLES], vi2[MAX_TRIANGLES];
+      __aligned(16) int geomIDs[MAX_TRIANGLES];
+      __aligned(16) int primIDs[MAX_TRIANGLES];
+      __aligned(16) int prims[MAX_TRIANGLES];
+    };
+
+    template<int N, typename Primitive, typename Mesh>
+    static void gatherLeafTriangles(Scene* scene, typename BVHN<N>::NodeRef ref, CollideTriangles& tris)
+    {
+      size_t num; const Primitive* prims = (const Primitive*) ref.leaf(num);
+      for (size_t i=0; i<num; i++) {
+        for (size_t j=0; j<Primitive::max_size(); j++) {
+          if (!prims[i].valid(j)) continue;
+          const unsigned geomID = prims[i].geomID(j);
+          tris.add(scene->get<Mesh>(geomID),geomID,prims[i].primID(j));
+        }
+      }
+    }
+
+    template<int N>
+    typename BVHNColliderMesh<N>::GatherFunc BVHNColliderMesh<N>::selectGather(const BVH* bvh)
+    {
+      if (bvh->primTy == &Triangle4::type ) return gatherLeafTriangles<N,Triangle4, TriangleMesh>;
+      if (bvh->primTy == &Triangle4v::type) return gatherLeafTriangles<N,Triangle4v,TriangleMesh>;
+      if (bvh->primTy == &Triangle4i::type) return gatherLeafTriangles<N,Triangle4i,TriangleMesh>;
+      if (bvh->primTy == &Triangle4c::type) return gatherLeafTriangles<N,Triangle4c,TriangleMesh>;
+      if (bvh->primTy == &Quad4v::type    ) return gatherLeafTriangles<N,Quad4v,    QuadMesh>;
+      if (bvh->primTy == &Quad4i::type    ) return gatherLeafTriangles<N,Quad4i,    QuadMesh>;
+      return nullptr;
+    }
+
+    template<int N>
+    void BVHNColliderMesh<N>::processLeaf(NodeRef node0, NodeRef node1, CollisionBuffer& buffer)
+    {
+      const float eps = 1E-5f;
+
+      CollideTriangles tris0; gather0(this->scene0,node0,tris0);
+      CollideTriangles tris1; gather1(this->scene1,node1,tris1);
+      const bool sameScene = this->scene0 == this->scene1;
+
+      /* bitmask of primitives of leaf1 already reported for the current primitive of leaf0 */
+      size_t reported = 0;
+
+      for (size_t i=0; i<tris0.numTriangles; i++)
+      {
+        if (i == 0 || tris0.prims[i] != tris0.prims[i-1])
+          reported = 0;
+
+        const Vec3fa a0 = tris0.vertex0(i);
+        const Vec3fa a1 = tris0.vertex1(i);
+        const Vec3fa a2 = tris0.vertex2(i);
+        const Vec3fa alower = min(a0,a1,a2);
+        const Vec3fa aupper = max(a0,a1,a2);
+        const Vec3fa Na = cross(a1-a0,a2-a0);
+        const float Ca = dot(Na,a0);
+        const vint4 geomID0(tris0.geomIDs[i]);
+        const vint4 primID0(tris0.primIDs[i]);
+
+        for (size_t j=0; j<tris1.numTriangles; j+=4)
+        {
+          CSTAT(bvh_collide_leaf_iterations++);
+          vbool4 valid = vint4(int(j))+vint4(step) < vint4(int(tris1.numTriangles));
+
+          /* self collisions report every pair once and skip topological neighbors */
+          if (sameScene)
+          {
+            const vint4 geomID1 = vint4::load(&tris1.geomIDs[j]);
+            const vint4 primID1 = vint4::load(&tris1.primIDs[j]);
+            const vbool4 sameGeom = geomID0 == geomID1;
+            valid &= (geomID0 < geomID1) | (sameGeom & (primID0 < primID1));
+            const vint4 b0 = vint4::load(&tris1.vi0[j]);
+            const vint4 b1 = vint4::load(&tris1.vi1[j]);
+            const vint4 b2 = vint4::load(&tris1.vi2[j]);
+            vbool4 neighbor(false);
+            for (size_t k=0; k<3; k++) {
+              const vint4 a(k == 0 ? tris0.vi0[i] : k == 1 ? tris0.vi1[i] : tris0.vi2[i]);
+              neighbor |= (a == b0) | (a == b1) | (a == b2);
+            }
+            valid &= !(sameGeom & neighbor);
+            if (none(valid)) continue;
+          }
+
+          const Vec3vf4 b0(vfloat4::load(&tris1.v0x[j]),vfloat4::load(&tris1.v0y[j]),vfloat4::load(&tris1.v0z[j]));
+          const Vec3vf4 b1(vfloat4::load(&tris1.v1x[j]),vfloat4::load(&tris1.v1y[j]),vfloat4::load(&tris1.v1z[j]));
+          const Vec3vf4 b2(vfloat4::load(&tris1.v2x[j]),vfloat4::load(&tris1.v2y[j]),vfloat4::load(&tris1.v2z[j]));
+
+          /* bounding box test */
+          const Vec3vf4 blower = min(b0,b1,b2);
+          const Vec3vf4 bupper = max(b0,b1,b2);
+          valid &= (blower.x <= vfloat4(aupper.x)) & (vfloat4(alower.x) <= bupper.x);
+          valid &= (blower.y <= vfloat4(aupper.y)) & (vfloat4(alower.y) <= bupper.y);
+          valid &= (blower.z <= vfloat4(aupper.z)) & (vfloat4(alower.z) <= bupper.z);
+          if (none(valid)) continue;
+
+          /* conservative separating plane tests, the exact test below uses eps */
+          const vfloat4 db0 = dot(Vec3vf4(Na),b0)-vfloat4(Ca);
+          const vfloat4 db1 = dot(Vec3vf4(Na),b1)-vfloat4(Ca);
+          const vfloat4 db2 = dot(Vec3vf4(Na),b2)-vfloat4(Ca);
+          valid &= (max(db0,db1,db2) >= vfloat4(-2.0f*eps)) & (min(db0,db1,db2) <= vfloat4(2.0f*eps));
+          if (none(valid)) continue;
+
+          const Vec3vf4 Nb = cross(b1-b0,b2-b0);
+          const vfloat4 Cb = dot(Nb,b0);
+          const vfloat4 da0 = dot(Nb,Vec3vf4(a0))-Cb;
+          const vfloat4 da1 = dot(Nb,Vec3vf4(a1))-Cb;
+          const vfloat4 da2 = dot(Nb,Vec3vf4(a2))-Cb;
+          valid &= (max(da0,da1,da2) >= vfloat4(-2.0f*eps)) & (min(da0,da1,da2) <= vfloat4(2.0f*eps));
+
+          for (size_t m=movemask(valid), k=bsf(m); m!=0; m=btc(m,k), k=bsf(m))
+          {
+            const size_t t = j+k;
+            const size_t prim1 = tris1.prims[t];
+            if (reported & (size_t(1) << prim1)) continue;
+            CSTAT(bvh_collide_prim_intersections++);
+            if (!TriangleTriangleIntersector::intersect_triangle_triangle(a0,a1,a2,tris1.vertex0(t),tris1.vertex1(t),tris1.vertex2(t)))
+              continue;
+
+            reported |= size_t(1) << prim1;
+            buffer.add({(unsigned)tris0.geomIDs[i],(unsigned)tris0.primIDs[i],(unsigned)tris1.geomIDs[t],(unsigned)tris1.primIDs[t]});
           }
         }
       }
-      if (num_collisions)
-        this->callback(this->userPtr,(RTCCollision*)&collisions,num_collisions);
     }
 
     template<int N>
-    void BVHNCollider<N>::collide_recurse(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1, size_t depth0, size_t depth1)
+    template<typename Closure>
+    void BVHNCollider<N>::collide_children_parallel(size_t mask, const Closure& closure)
+    {
+      size_t children[N]; size_t numChildren = 0;
+      for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m))
+        children[numChildren++] = i;
+
+      /* every task collects its collisions in its own buffer */
+      parallel_for(size_t(0), numChildren, size_t(1), [&] (const range<size_t>& r) {
+          CollisionBuffer buffer(callback,userPtr);
+          for (size_t k=r.begin(); k<r.end(); k++)
+            closure(children[k],buffer);
+          buffer.flush();
+        });
+    }
+
+    template<int N>
+    void BVHNCollider<N>::collide_recurse(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1, CollisionBuffer& buffer)
     {
       CSTAT(bvh_collide_traversal_steps++);
       if (unlikely(ref0.isLeaf())) {
         if (unlikely(ref1.isLeaf())) {
           CSTAT(bvh_collide_leaf_pairs++);
-          processLeaf(ref0,ref1);
+          processLeaf(ref0,ref1,buffer);
           return;
         } else goto recurse_node1;
         
@@ -174,24 +340,17 @@ namespace embree
       recurse_node0:
         AlignedNode* node0 = ref0.alignedNode();
         size_t mask = overlap<N>(bounds1,*node0);
-        //for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-        //for (size_t i=0; i<N; i++) {
-#if 0
-        if (depth0 < parallel_depth_threshold) 
+        if (estimatedPrimitives(bounds0,bounds1) > float(PARALLEL_SPLIT_THRESHOLD) && (mask & (mask-1)))
         {
-          parallel_for(size_t(N), [&] ( size_t i ) {
-              if (mask & ( 1 << i)) {
-                node0->child(i).prefetch(BVH_FLAG_ALIGNED_NODE);
-                collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1);
-              }
+          collide_children_parallel(mask, [&] (size_t i, CollisionBuffer& buffer) {
+              collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,buffer);
             });
-        } 
+        }
         else
-#endif
         {
           for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
             node0->child(i).prefetch(BVH_FLAG_ALIGNED_NODE);
-            collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,depth0+1,depth1);
+            collide_recurse(node0->child(i),node0->bounds(i),ref1,bounds1,buffer);
           }
         }
         return;
@@ -201,24 +360,17 @@ namespace embree
       recurse_node1:
         AlignedNode* node1 = ref1.alignedNode();
         size_t mask = overlap<N>(bounds0,*node1);
-        //for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-        //for (size_t i=0; i<N; i++) {
-#if 0
-        if (depth1 < parallel_depth_threshold) 
+        if (estimatedPrimitives(bounds0,bounds1) > float(PARALLEL_SPLIT_THRESHOLD) && (mask & (mask-1)))
         {
-          parallel_for(size_t(N), [&] ( size_t i ) {
-              if (mask & ( 1 << i)) {
-                node1->child(i).prefetch(BVH_FLAG_ALIGNED_NODE);
-                collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1);
-              }
+          collide_children_parallel(mask, [&] (size_t i, CollisionBuffer& buffer) {
+              collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),buffer);
             });
         }
         else
-#endif
         {
           for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
             node1->child(i).prefetch(BVH_FLAG_ALIGNED_NODE);
-            collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),depth0,depth1+1);
+            collide_recurse(ref0,bounds0,node1->child(i),node1->bounds(i),buffer);
           }
         }
         return;
@@ -226,49 +378,7 @@ namespace embree
     }
 
     template<int N>
-    void BVHNCollider<N>::split(const CollideJob& job, jobvector& jobs)
-    {
-      if (unlikely(job.ref0.isLeaf())) {
-        if (unlikely(job.ref1.isLeaf())) {
-          jobs.push_back(job);
-          return;
-        } else goto recurse_node1;
-      } else {
-        if (unlikely(job.ref1.isLeaf())) {
-          goto recurse_node0;
-        } else {
-          if (area(job.bounds0) > area(job.bounds1)) {
-            goto recurse_node0;
-          }
-          else {
-            goto recurse_node1;
-          }
-        }
-      }
-      
-      {
-      recurse_node0:
-        const AlignedNode* node0 = job.ref0.alignedNode();
-        size_t mask = overlap<N>(job.bounds1,*node0);
-        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-          jobs.push_back(CollideJob(node0->child(i),node0->bounds(i),job.depth0+1,job.ref1,job.bounds1,job.depth1));
-        }
-        return;
-      }
-      
-      {
-      recurse_node1:
-        const AlignedNode* node1 = job.ref1.alignedNode();
-        size_t mask = overlap<N>(job.bounds0,*node1);
-        for (size_t m=mask, i=bsf(m); m!=0; m=btc(m,i), i=bsf(m)) {
-          jobs.push_back(CollideJob(job.ref0,job.bounds0,job.depth0,node1->child(i),node1->bounds(i),job.depth1+1));
-        }
-        return;
-      }
-    }
-    
-    template<int N>
-    void BVHNCollider<N>::collide_recurse_entry(NodeRef ref0, const BBox3fa& bounds0, NodeRef ref1, const BBox3fa& bounds1)
+    void BVHNCollider<N>::collide_recurse_entry(BVH* bvh0, BVH* bvh1)
     {
       CSTAT(bvh_collide_traversal_steps = 0);
       CSTAT(bvh_collide_leaf_pairs = 0);
@@ -279,47 +389,19 @@ namespace embree
       CSTAT(bvh_collide_prim_intersections4 = 0);
       CSTAT(bvh_collide_prim_intersections5 = 0);
       CSTAT(bvh_collide_prim_intersections = 0);
-#if 0
-      collide_recurse(ref0,bounds0,ref1,bounds1,0,0);
-#else
-      const int M = 2048;
-      jobvector jobs[2];
-      jobs[0].reserve(M);
-      jobs[1].reserve(M);
-      jobs[0].push_back(CollideJob(ref0,bounds0,0,ref1,bounds1,0));
-      int source = 0;
-      int target = 1;
-
-      /* try to split job until job list is full */
-      while (jobs[source].size()+8 <= M)
-      {
-        for (size_t i=0; i<jobs[source].size(); i++)
-        {
-          const CollideJob& job = jobs[source][i];
-          size_t remaining = jobs[source].size()-i;
-          if (jobs[target].size()+remaining+8 > M) {
-            jobs[target].push_back(job);
-          } else {
-            split(job,jobs[target]);
-          }
-        }
 
-        /* stop splitting jobs if we reached only leaves and cannot make progress anymore */
-        if (jobs[target].size() == jobs[source].size())
-          break;
+      /* the primitive densities let us estimate the subtree size of each node pair */
+      const BBox3fa bounds0 = bvh0->bounds.bounds();
+      const BBox3fa bounds1 = bvh1->bounds.bounds();
+      const float area0 = area(bounds0);
+      const float area1 = area(bounds1);
+      primDensity0 = area0 > 0.0f ? float(bvh0->numPrimitives)/area0 : 0.0f;
+      primDensity1 = area1 > 0.0f ? float(bvh1->numPrimitives)/area1 : 0.0f;
 
-        jobs[source].resize(0);
-        std::swap(source,target);
-      }
+      CollisionBuffer buffer(callback,userPtr);
+      collide_recurse(bvh0->root,bounds0,bvh1->root,bounds1,buffer);
+      buffer.flush();
 
-      /* parallel processing of all jobs */
-      parallel_for(size_t(jobs[source].size()), [&] ( size_t i ) {
-          CollideJob& j = jobs[source][i];
-          collide_recurse(j.ref0,j.bounds0,j.ref1,j.bounds1,j.depth0,j.depth1);
-        });
-      
-      
-#endif
       CSTAT(PRINT(bvh_collide_traversal_steps));
       CSTAT(PRINT(bvh_collide_leaf_pairs));
       CSTAT(PRINT(bvh_collide_leaf_iterations));
@@ -334,8 +416,282 @@ namespace embree
     template<int N>
     void BVHNColliderUserGeom<N>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr)
     { 
-      BVHNColliderUserGeom<N>(bvh0->scene,bvh1->scene,callback,userPtr).
-        collide_recurse_entry(bvh0->root,bvh0->bounds.bounds(),bvh1->root,bvh1->bounds.bounds());
+      BVHNColliderUserGeom<N>(bvh0->scene,bvh1->scene,callback,userPtr).collide_recurse_entry(bvh0,bvh1);
+    }
+
+    template<int N>
+    void BVHNColliderMesh<N>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr)
+    {
+      GatherFunc gather0 = selectGather(bvh0);
+      GatherFunc gather1 = selectGather(bvh1);
+      if (!gather0 || !gather1)
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"collision of triangle or quad meshes requires both scenes to contain only triangle or quad meshes");
+
+      BVHNColliderMesh<N>(bvh0->scene,bvh1->scene,callback,userPtr,gather0,gather1).collide_recurse_entry(bvh0,bvh1);
+    }
+
+    struct CollidePrimitives
+    {
+      enum { MAX_PRIMS = 32 };
+
+      __forceinline CollidePrimitives () : num(0) {}
+
+      __forceinline void add(unsigned geomID, unsigned primID, const LBBox3fa& bounds, const vint4& vertices)
+      {
+        assert(num < MAX_PRIMS);
+        geomIDs[num] = geomID;
+        primIDs[num] = primID;
+        this->bounds[num] = bounds;
+        this->vertices[num] = vertices;
+        num++;
+      }
+
+      size_t num;
+      unsigned geomIDs[MAX_PRIMS];
+      unsigned primIDs[MAX_PRIMS];
+      LBBox3fa bounds[MAX_PRIMS];   //!< linear bounds as function of the global time
+      vint4 vertices[MAX_PRIMS];    //!< vertex indices to skip topological neighbors, -1 for user geometries
+    };
+
+    /*! converts linear bounds over some time interval into linear bounds over the global time */
+    __forceinline LBBox3fa globalBounds(const LBBox3fa& bounds, const BBox1f& dt) {
+      return dt.size() > 0.0f ? bounds.global(dt) : LBBox3fa(bounds.bounds0);
+    }
+
+    /*! clips the time interval to the times where c+d*t >= 0 holds */
+    __forceinline bool clipTime(float c, float d, float& lower, float& upper)
+    {
+      if      (d > 0.0f) lower = max(lower,-c/d);
+      else if (d < 0.0f) upper = min(upper,-c/d);
+      else if (!(c >= 0.0f)) return false;
+      return lower <= upper;
+    }
+
+    /*! clips the time interval to the times where two linearly moving boxes overlap */
+    __forceinline bool overlapTime(const LBBox3fa& a, const LBBox3fa& b, BBox1f& dt)
+    {
+      /* the boxes overlap along an axis while both distances between opposite faces are positive */
+      const Vec3fa c0 = b.bounds0.upper - a.bounds0.lower;
+      const Vec3fa d0 = (b.bounds1.upper - a.bounds1.lower) - c0;
+      const Vec3fa c1 = a.bounds0.upper - b.bounds0.lower;
+      const Vec3fa d1 = (a.bounds1.upper - b.bounds1.lower) - c1;
+      float lower = dt.lower, upper = dt.upper;
+      for (size_t k=0; k<3; k++) {
+        if (!clipTime(c0[k],d0[k],lower,upper)) return false;
+        if (!clipTime(c1[k],d1[k],lower,upper)) return false;
+      }
+      dt = BBox1f(lower,upper);
+      return true;
+    }
+
+    template<typename Mesh>
+    __forceinline LBBox3fa primLinearBounds(const Mesh* mesh, unsigned primID, const BBox1f& dt)
+    {
+      if (mesh->numTimeSteps == 1)
+        return LBBox3fa(mesh->bounds(primID));
+      return globalBounds(mesh->linearBounds(primID,dt),dt);
+    }
+
+    __forceinline vint4 primVertices(const TriangleMesh* mesh, unsigned primID) {
+      const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+      return vint4(tri.v[0],tri.v[1],tri.v[2],tri.v[2]);
+    }
+
+    __forceinline vint4 primVertices(const QuadMesh* mesh, unsigned primID) {
+      const QuadMesh::Quad& quad = mesh->quad(primID);
+      return vint4(quad.v[0],quad.v[1],quad.v[2],quad.v[3]);
+    }
+
+    __forceinline vint4 primVertices(const AccelSet* mesh, unsigned primID) {
+      return vint4(-1);
+    }
+
+    template<int N, typename Primitive, typename Mesh>
+    static void gatherLeafPrimitives(Scene* scene, typename BVHN<N>::NodeRef ref, const BBox1f& dt, CollidePrimitives& prims)
+    {
+      size_t num; const Primitive* items = (const Primitive*) ref.leaf(num);
+      for (size_t i=0; i<num; i++) {
+        for (size_t j=0; j<Primitive::max_size(); j++) {
+          if (!items[i].valid(j)) continue;
+          const unsigned geomID = items[i].geomID(j);
+          const unsigned primID = items[i].primID(j);
+          const Mesh* mesh = scene->get<Mesh>(geomID);
+          prims.add(geomID,primID,primLinearBounds(mesh,primID,dt),primVertices(mesh,primID));
+        }
+      }
+    }
+
+    template<int N>
+    static void gatherLeafObjects(Scene* scene, typename BVHN<N>::NodeRef ref, const BBox1f& dt, CollidePrimitives& prims)
+    {
+      size_t num; const Object* items = (const Object*) ref.leaf(num);
+      for (size_t i=0; i<num; i++) {
+        const unsigned geomID = items[i].geomID();
+        const unsigned primID = items[i].primID();
+        const AccelSet* mesh = scene->get<AccelSet>(geomID);
+        prims.add(geomID,primID,primLinearBounds(mesh,primID,dt),primVertices(mesh,primID));
+      }
+    }
+
+    template<int N>
+    typename BVHNColliderContinuous<N>::GatherFunc BVHNColliderContinuous<N>::selectGather(const BVH* bvh)
+    {
+      if (bvh->primTy == &Triangle4::type   ) return gatherLeafPrimitives<N,Triangle4,   TriangleMesh>;
+      if (bvh->primTy == &Triangle4v::type  ) return gatherLeafPrimitives<N,Triangle4v,  TriangleMesh>;
+      if (bvh->primTy == &Triangle4i::type  ) return gatherLeafPrimitives<N,Triangle4i,  TriangleMesh>;
+      if (bvh->primTy == &Triangle4c::type  ) return gatherLeafPrimitives<N,Triangle4c,  TriangleMesh>;
+      if (bvh->primTy == &Triangle4vMB::type) return gatherLeafPrimitives<N,Triangle4vMB,TriangleMesh>;
+      if (bvh->primTy == &Quad4v::type      ) return gatherLeafPrimitives<N,Quad4v,      QuadMesh>;
+      if (bvh->primTy == &Quad4i::type      ) return gatherLeafPrimitives<N,Quad4i,      QuadMesh>;
+      if (bvh->primTy == &Object::type      ) return gatherLeafObjects<N>;
+      return nullptr;
+    }
+
+    template<int N>
+    void BVHNColliderContinuous<N>::processLeaf(NodeRef node0, NodeRef node1, const BBox1f& dt, ContinuousCollisionBuffer& buffer)
+    {
+      /* primitive bounds get calculated over the time the leaves overlap, for a single point in time over the entire interval */
+      const BBox1f primTime = dt.size() > 0.0f ? dt : time;
+      CollidePrimitives prims0; gather0(scene0,node0,primTime,prims0);
+      CollidePrimitives prims1; gather1(scene1,node1,primTime,prims1);
+      const bool sameScene = scene0 == scene1;
+
+      for (size_t i=0; i<prims0.num; i++)
+      {
+        for (size_t j=0; j<prims1.num; j++)
+        {
+          CSTAT(bvh_collide_prim_intersections++);
+          const unsigned geomID0 = prims0.geomIDs[i], primID0 = prims0.primIDs[i];
+          const unsigned geomID1 = prims1.geomIDs[j], primID1 = prims1.primIDs[j];
+
+          /* self collisions report every pair once and skip topological neighbors */
+          if (sameScene)
+          {
+            if (geomID0 > geomID1 || (geomID0 == geomID1 && primID0 >= primID1))
+              continue;
+            if (geomID0 == geomID1 && prims0.vertices[i][0] != -1) {
+              const vint4& v1 = prims1.vertices[j];
+              const vint4& v0 = prims0.vertices[i];
+              if (any((vint4(v0[0]) == v1) | (vint4(v0[1]) == v1) | (vint4(v0[2]) == v1) | (vint4(v0[3]) == v1)))
+                continue;
+            }
+          }
+
+          BBox1f contact = dt;
+          if (!overlapTime(prims0.bounds[i],prims1.bounds[j],contact))
+            continue;
+
+          buffer.add({geomID0,primID0,geomID1,primID1,contact.lower});
+        }
+      }
+    }
+
+    template<int N>
+    void BVHNColliderContinuous<N>::collide_recurse(NodeRef ref0, const LBBox3fa& bounds0, NodeRef ref1, const LBBox3fa& bounds1, const BBox1f& dt, ContinuousCollisionBuffer& buffer)
+    {
+      CSTAT(bvh_collide_traversal_steps++);
+      bool descend0;
+      if (unlikely(ref0.isLeaf())) {
+        if (unlikely(ref1.isLeaf())) {
+          CSTAT(bvh_collide_leaf_pairs++);
+          processLeaf(ref0,ref1,dt,buffer);
+          return;
+        }
+        descend0 = false;
+      }
+      else if (unlikely(ref1.isLeaf()))
+        descend0 = true;
+      else
+        descend0 = bounds0.expectedHalfArea(dt) > bounds1.expectedHalfArea(dt);
+
+      /* gather the children that overlap the other node within the time interval */
+      const NodeRef ref = descend0 ? ref0 : ref1;
+      const LBBox3fa& other = descend0 ? bounds1 : bounds0;
+      NodeRef children[N];
+      LBBox3fa childBounds[N];
+      BBox1f childTime[N];
+      size_t numChildren = 0;
+      for (size_t i=0; i<N; i++)
+      {
+        BBox1f ct = dt;
+        LBBox3fa cb;
+        if (likely(ref.isAlignedNode())) {
+          const typename BVH::AlignedNode* node = ref.alignedNode();
+          if (node->child(i) == BVH::emptyNode) continue;
+          cb = LBBox3fa(node->bounds(i));
+        }
+        else if (likely(ref.isAlignedNodeMB())) {
+          const typename BVH::AlignedNodeMB* node = ref.alignedNodeMB();
+          if (node->child(i) == BVH::emptyNode) continue;
+          cb = node->lbounds(i);
+        }
+        else if (likely(ref.isAlignedNodeMB4D())) {
+          const typename BVH::AlignedNodeMB4D* node = ref.alignedNodeMB4D();
+          if (node->child(i) == BVH::emptyNode) continue;
+          cb = node->lbounds(i);
+          ct = intersect(ct,node->timeRange(i));
+          if (ct.empty()) continue;
+        }
+        else
+          throw_RTCError(RTC_ERROR_INVALID_OPERATION,"unsupported node type for continuous collision");
+
+        if (!overlapTime(cb,other,ct)) continue;
+        children[numChildren] = ref.baseNode()->child(i);
+        childBounds[numChildren] = cb;
+        childTime[numChildren] = ct;
+        numChildren++;
+      }
+
+      auto recurse = [&] (size_t k, ContinuousCollisionBuffer& buffer) {
+        if (descend0) collide_recurse(children[k],childBounds[k],ref1,bounds1,childTime[k],buffer);
+        else          collide_recurse(ref0,bounds0,children[k],childBounds[k],childTime[k],buffer);
+      };
+
+      if (numChildren > 1 && estimatedPrimitives(bounds0,bounds1) > float(PARALLEL_SPLIT_THRESHOLD))
+      {
+        /* every task collects its collisions in its own buffer */
+        parallel_for(size_t(0), numChildren, size_t(1), [&] (const range<size_t>& r) {
+            ContinuousCollisionBuffer buffer(callback,userPtr);
+            for (size_t k=r.begin(); k<r.end(); k++)
+              recurse(k,buffer);
+            buffer.flush();
+          });
+      }
+      else
+      {
+        for (size_t k=0; k<numChildren; k++)
+          recurse(k,buffer);
+      }
+    }
+
+    template<int N>
+    void BVHNColliderContinuous<N>::collide_recurse_entry(BVH* bvh0, BVH* bvh1)
+    {
+      const LBBox3fa bounds0 = bvh0->bounds;
+      const LBBox3fa bounds1 = bvh1->bounds;
+      const float area0 = bounds0.expectedApproxHalfArea();
+      const float area1 = bounds1.expectedApproxHalfArea();
+      primDensity0 = area0 > 0.0f ? float(bvh0->numPrimitives)/area0 : 0.0f;
+      primDensity1 = area1 > 0.0f ? float(bvh1->numPrimitives)/area1 : 0.0f;
+
+      BBox1f dt = time;
+      if (!overlapTime(bounds0,bounds1,dt))
+        return;
+
+      ContinuousCollisionBuffer buffer(callback,userPtr);
+      collide_recurse(bvh0->root,bounds0,bvh1->root,bounds1,dt,buffer);
+      buffer.flush();
+    }
+
+    template<int N>
+    void BVHNColliderContinuous<N>::collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, float time0, float time1, RTCContinuousCollideFunc callback, void* userPtr)
+    {
+      GatherFunc gather0 = selectGather(bvh0);
+      GatherFunc gather1 = selectGather(bvh1);
+      if (!gather0 || !gather1)
+        throw_RTCError(RTC_ERROR_INVALID_OPERATION,"continuous collision requires both scenes to contain only triangle meshes, quad meshes, or user geometries");
+
+      BVHNColliderContinuous<N>(bvh0->scene,bvh1->scene,BBox1f(time0,time1),callback,userPtr,gather0,gather1).collide_recurse_entry(bvh0,bvh1);
     }
 
 #if defined (EMBREE_LOWEST_ISA)
@@ -380,9 +736,13 @@ namespace embree
     ////////////////////////////////////////////////////////////////////////////////
 
     DEFINE_COLLIDER(BVH4ColliderUserGeom,BVHNColliderUserGeom<4>);
+    DEFINE_COLLIDER(BVH4ColliderMesh,BVHNColliderMesh<4>);
+    DEFINE_CONTINUOUS_COLLIDER(BVH4ColliderContinuous,BVHNColliderContinuous<4>);
 
 #if defined(__AVX__)
     DEFINE_COLLIDER(BVH8ColliderUserGeom,BVHNColliderUserGeom<8>);
+    DEFINE_COLLIDER(BVH8ColliderMesh,BVHNColliderMesh<8>);
+    DEFINE_CONTINUOUS_COLLIDER(BVH8ColliderContinuous,BVHNColliderContinuous<8>);
 #endif
   }
 }
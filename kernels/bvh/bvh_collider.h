@@ -17,13 +17,50 @@
 #pragma once
 
 #include "bvh.h"
+#include "../geometry/triangle.h"
 #include "../geometry/trianglev.h"
+#include "../geometry/trianglei.h"
+#include "../geometry/trianglec.h"
+#include "../geometry/trianglev_mb.h"
+#include "../geometry/quadv.h"
+#include "../geometry/quadi.h"
 #include "../geometry/object.h"
 
 namespace embree
 {
   namespace isa
   {
+    /*! collisions found by one task, they get passed to the callback in large batches */
+    template<typename Collision, typename CollideFunc>
+    struct CollisionBufferT
+    {
+      enum { SIZE = 256 };
+
+      __forceinline CollisionBufferT (CollideFunc callback, void* userPtr)
+        : callback(callback), userPtr(userPtr), num(0) {}
+
+      __forceinline void add(const Collision& collision)
+      {
+        collisions[num++] = collision;
+        if (unlikely(num == SIZE)) flush();
+      }
+
+      __forceinline void flush()
+      {
+        if (num) callback(userPtr,collisions,(unsigned)num);
+        num = 0;
+      }
+
+    private:
+      CollideFunc callback;
+      void* userPtr;
+      size_t num;
+      Collision collisions[SIZE];
+    };
+
+    typedef CollisionBufferT<RTCCollision,RTCCollideFunc> CollisionBuffer;
+    typedef CollisionBufferT<RTCContinuousCollision,RTCContinuousCollideFunc> ContinuousCollisionBuffer;
+
     template<int N>
       class BVHNCollider
     {
@@ -31,40 +68,36 @@ namespace embree
       typedef typename BVH::NodeRef NodeRef;
       typedef typename BVH::AlignedNode AlignedNode;
 
-      struct CollideJob
-      {
-        CollideJob () {}
-        
-        CollideJob (NodeRef ref0, const BBox3fa& bounds0, size_t depth0,
-                    NodeRef ref1, const BBox3fa& bounds1, size_t depth1)
-        : ref0(ref0), bounds0(bounds0), depth0(depth0), ref1(ref1), bounds1(bounds1), depth1(depth1) {}
-        
-        NodeRef ref0;
-        BBox3fa bounds0;
-        size_t depth0;
-        NodeRef ref1;
-        BBox3fa bounds1;
-        size_t depth1;
-      };
-
-      typedef vector_t<CollideJob, aligned_allocator<CollideJob,16>> jobvector;
-
-      void split(const CollideJob& job, jobvector& jobs);
-      
+      /*! node pairs whose subtrees are estimated to contain more primitives get split into parallel tasks */
+      enum { PARALLEL_SPLIT_THRESHOLD = 1024 };
+
     public:
       __forceinline BVHNCollider (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
-        : scene0(scene0), scene1(scene1), callback(callback), userPtr(userPtr) {}
+        : scene0(scene0), scene1(scene1), callback(callback), userPtr(userPtr), primDensity0(0.0f), primDensity1(0.0f) {}
 
     public:
-      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1) = 0;
-      void collide_recurse(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1, size_t depth0, size_t depth1);
-      void collide_recurse_entry(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1);
-    
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1, CollisionBuffer& buffer) = 0;
+      void collide_recurse(NodeRef node0, const BBox3fa& bounds0, NodeRef node1, const BBox3fa& bounds1, CollisionBuffer& buffer);
+      void collide_recurse_entry(BVH* bvh0, BVH* bvh1);
+
+    private:
+      /*! SAH estimate of the number of primitives below two nodes */
+      __forceinline float estimatedPrimitives(const BBox3fa& bounds0, const BBox3fa& bounds1) const {
+        return primDensity0*area(bounds0) + primDensity1*area(bounds1);
+      }
+
+      template<typename Closure>
+        void collide_children_parallel(size_t mask, const Closure& closure);
+
     protected:
       Scene* scene0;
       Scene* scene1;
       RTCCollideFunc callback;
       void* userPtr;
+
+    private:
+      float primDensity0; //!< primitives per surface area of the root of the first BVH
+      float primDensity1; //!< primitives per surface area of the root of the second BVH
     };
 
     template<int N>
@@ -77,9 +110,83 @@ namespace embree
       __forceinline BVHNColliderUserGeom (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr)
         : BVHNCollider<N>(scene0,scene1,callback,userPtr) {}
 
-      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1);
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1, CollisionBuffer& buffer);
+    public:
+      static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr);
+    };
+
+    /*! triangles of a BVH leaf in SoA layout, quads get split into two triangles */
+    struct CollideTriangles;
+
+    template<int N>
+      class BVHNColliderMesh : public BVHNCollider<N>
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef typename BVH::AlignedNode AlignedNode;
+
+      /*! decodes the triangles of a leaf of some primitive type */
+      typedef void (*GatherFunc)(Scene* scene, NodeRef leaf, CollideTriangles& tris);
+
+      __forceinline BVHNColliderMesh (Scene* scene0, Scene* scene1, RTCCollideFunc callback, void* userPtr, GatherFunc gather0, GatherFunc gather1)
+        : BVHNCollider<N>(scene0,scene1,callback,userPtr), gather0(gather0), gather1(gather1) {}
+
+      virtual void processLeaf(NodeRef leaf0, NodeRef leaf1, CollisionBuffer& buffer);
+
+      static GatherFunc selectGather(const BVH* bvh);
     public:
       static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, RTCCollideFunc callback, void* userPtr);
+
+    private:
+      GatherFunc gather0;
+      GatherFunc gather1;
+    };
+
+    /*! primitives of a BVH leaf with their linear bounds over some time interval */
+    struct CollidePrimitives;
+
+    /*! Continuous collision detection over the linearly interpolated bounds
+     *  of static and motion blur BVHs of triangles, quads and user
+     *  geometries. Reports the earliest time the bounds of two primitives
+     *  overlap inside the queried time interval. */
+    template<int N>
+      class BVHNColliderContinuous
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+
+      /*! node pairs whose subtrees are estimated to contain more primitives get split into parallel tasks */
+      enum { PARALLEL_SPLIT_THRESHOLD = 1024 };
+
+      /*! decodes the primitives of a leaf of some primitive type */
+      typedef void (*GatherFunc)(Scene* scene, NodeRef leaf, const BBox1f& time, CollidePrimitives& prims);
+
+      __forceinline BVHNColliderContinuous (Scene* scene0, Scene* scene1, const BBox1f& time, RTCContinuousCollideFunc callback, void* userPtr, GatherFunc gather0, GatherFunc gather1)
+        : scene0(scene0), scene1(scene1), time(time), callback(callback), userPtr(userPtr), gather0(gather0), gather1(gather1), primDensity0(0.0f), primDensity1(0.0f) {}
+
+      void processLeaf(NodeRef leaf0, NodeRef leaf1, const BBox1f& dt, ContinuousCollisionBuffer& buffer);
+      void collide_recurse(NodeRef node0, const LBBox3fa& bounds0, NodeRef node1, const LBBox3fa& bounds1, const BBox1f& dt, ContinuousCollisionBuffer& buffer);
+      void collide_recurse_entry(BVH* bvh0, BVH* bvh1);
+
+      /*! SAH estimate of the number of primitives below two nodes */
+      __forceinline float estimatedPrimitives(const LBBox3fa& bounds0, const LBBox3fa& bounds1) const {
+        return primDensity0*bounds0.expectedApproxHalfArea() + primDensity1*bounds1.expectedApproxHalfArea();
+      }
+
+      static GatherFunc selectGather(const BVH* bvh);
+    public:
+      static void collide(BVH* __restrict__ bvh0, BVH* __restrict__ bvh1, float time0, float time1, RTCContinuousCollideFunc callback, void* userPtr);
+
+    private:
+      Scene* scene0;
+      Scene* scene1;
+      BBox1f time;          //!< queried time interval
+      RTCContinuousCollideFunc callback;
+      void* userPtr;
+      GatherFunc gather0;
+      GatherFunc gather1;
+      float primDensity0;   //!< primitives per surface area of the root of the first BVH
+      float primDensity1;   //!< primitives per surface area of the root of the second BVH
     };
   }
 }
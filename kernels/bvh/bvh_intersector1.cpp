@@ -23,6 +23,7 @@
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
+#include "../geometry/trianglec_intersector.h"
 #include "../geometry/quadv_intersector.h"
 #include "../geometry/quadi_intersector.h"
 #include "../geometry/curveNv_intersector.h"
@@ -58,7 +59,7 @@ namespace embree
       StackItemT<NodeRef> stack[stackSize];    // stack of nodes
       StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
       StackItemT<NodeRef>* stackEnd = stack+stackSize;
-      stack[0].ptr  = bvh->root;
+      stack[0].ptr  = bvh->getRoot();
       stack[0].dist = neg_inf;
       
       if (bvh->root == BVH::emptyNode)
@@ -79,6 +80,9 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, Nx, types> nodeTraverser;
 
+      /* counters of sampled rays, see TraversalCounters */
+      size_t numNodes = 0, numLeaves = 0, numPrims = 0;
+
       /* pop loop */
       while (true) pop:
       {
@@ -105,6 +109,7 @@ namespace embree
           STAT3(normal.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, Nx, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(normal.trav_nodes,-1,-1,-1); break; }
+          numNodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -118,6 +123,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(normal.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        numLeaves++; numPrims += num;
         size_t lazy_node = 0;
         PrimitiveIntersector1::intersect(This, pre, ray, context, prim, num, tray, lazy_node);
         tray.tfar = ray.tfar;
@@ -129,6 +135,9 @@ namespace embree
           stackPtr++;
         }
       }
+
+      if (unlikely(context->counters))
+        context->counters->add(numNodes,numLeaves,numPrims);
     }
 
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
@@ -153,7 +162,7 @@ namespace embree
       NodeRef stack[stackSize];    // stack of nodes that still need to get traversed
       NodeRef* stackPtr = stack+1; // current stack pointer
       NodeRef* stackEnd = stack+stackSize;
-      stack[0] = bvh->root;
+      stack[0] = bvh->getRoot();
 
       /* filter out invalid rays */
 #if defined(EMBREE_IGNORE_INVALID_RAYS)
@@ -171,6 +180,9 @@ namespace embree
       /* initialize the node traverser */
       BVHNNodeTraverser1Hit<N, Nx, types> nodeTraverser;
 
+      /* counters of sampled rays, see TraversalCounters */
+      size_t numNodes = 0, numLeaves = 0, numPrims = 0;
+
       /* pop loop */
       while (true) pop:
       {
@@ -187,6 +199,7 @@ namespace embree
           STAT3(shadow.trav_nodes,1,1,1);
           bool nodeIntersected = BVHNNodeIntersector1<N, Nx, types, robust>::intersect(cur, tray, ray.time(), tNear, mask);
           if (unlikely(!nodeIntersected)) { STAT3(shadow.trav_nodes,-1,-1,-1); break; }
+          numNodes++;
 
           /* if no child is hit, pop next node */
           if (unlikely(mask == 0))
@@ -200,6 +213,7 @@ namespace embree
         assert(cur != BVH::emptyNode);
         STAT3(shadow.trav_leaves,1,1,1);
         size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+        numLeaves++; numPrims += num;
         size_t lazy_node = 0;
         if (PrimitiveIntersector1::occluded(This, pre, ray, context, prim, num, tray, lazy_node)) {
           ray.tfar = neg_inf;
@@ -212,6 +226,9 @@ namespace embree
           stackPtr++;
         }
       }
+
+      if (unlikely(context->counters))
+        context->counters->add(numNodes,numLeaves,numPrims);
     }
 
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
@@ -315,22 +332,130 @@ namespace embree
         }
         return changed;
       }
+
+      /* traverses the BVH once for a packet of point queries, each
+       * node is tested against all queries that reached it and a child
+       * gets visited by the subset of queries that overlap it */
+      static __forceinline size_t pointQueryPacket(const Accel::Intersectors* This, size_t valid, PointQuery** query, PointQueryContext** context)
+      {
+        const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+        
+        /* we may traverse an empty BVH in case all geometry was invalid */
+        if (bvh->root == BVH::emptyNode)
+          return 0;
+
+        /* stack state */
+        struct StackItem { NodeRef ptr; size_t lanes; };
+        StackItem stack[stackSize];    // stack of nodes with their active queries
+        StackItem* stackPtr = stack+1; // current stack pointer
+        stack[0].ptr   = bvh->root;
+        stack[0].lanes = valid;
+
+        /* load the point queries into SIMD registers */
+        TravPointQuery<N> tquery[MAX_POINT_QUERY_PACKET_SIZE];
+        for (size_t m=valid; m; ) {
+          const size_t k = bscf(m);
+          assert(!(types & BVH_MB) || (query[k]->time >= 0.0f && query[k]->time <= 1.0f));
+          tquery[k] = TravPointQuery<N>(query[k]->p, context[k]->query_radius);
+        }
+
+        size_t changed = 0;
+
+        /* pop loop */
+        while (true) pop:
+        {
+          /* pop next node */
+          if (unlikely(stackPtr == stack)) break;
+          stackPtr--;
+          NodeRef cur = stackPtr->ptr;
+          size_t lanes = stackPtr->lanes;
+
+          /* downtraversal loop */
+          while (true)
+          {
+            /* intersect node with all active queries */
+            size_t childLanes[N] = { 0 };
+            size_t childMask = 0;
+            bool nodeIntersected = true;
+            for (size_t m=lanes; m; )
+            {
+              const size_t k = bscf(m);
+              size_t mask; vfloat<N> tNear;
+              STAT3(point_query.trav_nodes,1,1,1);
+              if (likely(context[k]->query_type == POINT_QUERY_TYPE_SPHERE)) {
+                nodeIntersected = BVHNNodePointQuerySphere1<N, types>::pointQuery(cur, tquery[k], query[k]->time, tNear, mask);
+              } else {
+                nodeIntersected = BVHNNodePointQueryAABB1  <N, types>::pointQuery(cur, tquery[k], query[k]->time, tNear, mask);
+              }
+              if (unlikely(!nodeIntersected)) { STAT3(point_query.trav_nodes,-1,-1,-1); break; }
+              childMask |= mask;
+              for (; mask; ) {
+                const size_t i = bscf(mask);
+                childLanes[i] |= size_t(1) << k;
+              }
+            }
+            if (unlikely(!nodeIntersected)) break;
+
+            /* if no child is hit, pop next node */
+            if (unlikely(childMask == 0))
+              goto pop;
+
+            /* continue with the first child and push the others */
+            const size_t first = bscf(childMask);
+            for (; childMask; ) {
+              const size_t i = bscf(childMask);
+              assert(stackPtr < stack+stackSize);
+              stackPtr->ptr   = cur.baseNode()->child(i);
+              stackPtr->lanes = childLanes[i];
+              stackPtr++;
+            }
+            lanes = childLanes[first];
+            cur = cur.baseNode()->child(first);
+          }
+
+          /* this is a leaf node, the primitives get processed for each query */
+          assert(cur != BVH::emptyNode);
+          STAT3(point_query.trav_leaves,1,1,1);
+          size_t num; Primitive* prim = (Primitive*)cur.leaf(num);
+          size_t lazy_node = 0;
+          for (size_t m=lanes; m; )
+          {
+            const size_t k = bscf(m);
+            if (PrimitiveIntersector1::pointQuery(This, query[k], context[k], prim, num, tquery[k], lazy_node))
+            {
+              changed |= size_t(1) << k;
+              tquery[k].rad = context[k]->query_radius;
+            }
+          }
+
+          /* push lazy node onto stack */
+          if (unlikely(lazy_node)) {
+            stackPtr->ptr = lazy_node;
+            stackPtr->lanes = lanes;
+            stackPtr++;
+          }
+        }
+        return changed;
+      }
     };
 
     /* disable point queries for not yet supported geometry types */
     template<int N, int types, bool robust>
     struct PointQueryDispatch<N, types, robust, VirtualCurveIntersector1> {
       static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) { return false; }
+      static __forceinline size_t pointQueryPacket(const Accel::Intersectors* This, size_t valid, PointQuery** query, PointQueryContext** context) { return 0; }
     };
     
     template<int N, int types, bool robust>
     struct PointQueryDispatch<N, types, robust, SubdivPatch1Intersector1> {
       static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) { return false; }
+      static __forceinline size_t pointQueryPacket(const Accel::Intersectors* This, size_t valid, PointQuery** query, PointQueryContext** context) { return 0; }
     };
     
     template<int N, int types, bool robust>
     struct PointQueryDispatch<N, types, robust, SubdivPatch1MBIntersector1> {
       static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) { return false; }
+      static __forceinline size_t pointQueryPacket(const Accel::Intersectors* This, size_t valid, PointQuery** query, PointQueryContext** context) { return 0; }
     };
 
     template<int N, int types, bool robust, typename PrimitiveIntersector1>
@@ -339,5 +464,12 @@ namespace embree
     {
       return PointQueryDispatch<N, types, robust, PrimitiveIntersector1>::pointQuery(This, query, context);
     }
+
+    template<int N, int types, bool robust, typename PrimitiveIntersector1>
+    size_t BVHNIntersector1<N, types, robust, PrimitiveIntersector1>::pointQueryPacket(
+      const Accel::Intersectors* This, size_t valid, PointQuery** query, PointQueryContext** context)
+    {
+      return PointQueryDispatch<N, types, robust, PrimitiveIntersector1>::pointQueryPacket(This, valid, query, context);
+    }
   }
 }
@@ -55,6 +55,10 @@ namespace embree
 
     IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(QBVH8Quad4iIntersector1Pluecker,BVHNIntersector1<8 COMMA BVH_QN1 COMMA false COMMA ArrayIntersector1<QuadMiIntersector1Pluecker<4 COMMA true> > >));
 
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR1(QBVH8Triangle4iMBIntersector1Pluecker,BVHNIntersector1<8 COMMA BVH_QN2_AN4D COMMA false COMMA ArrayIntersector1<TriangleMiMBIntersector1Pluecker<SIMD_MODE(4) COMMA true> > >));
+    IF_ENABLED_QUADS(DEFINE_INTERSECTOR1(QBVH8Quad4iMBIntersector1Pluecker,BVHNIntersector1<8 COMMA BVH_QN2_AN4D COMMA false COMMA ArrayIntersector1<QuadMiMBIntersector1Pluecker<4 COMMA true> > >));
+    IF_ENABLED_CURVES(DEFINE_INTERSECTOR1(QBVH8OBBVirtualCurveIntersector1MB,BVHNIntersector1<8 COMMA BVH_QN2_AN4D_UN2 COMMA false COMMA VirtualCurveIntersector1 >));
+
     IF_ENABLED_USER(DEFINE_INTERSECTOR1(BVH8VirtualIntersector1,BVHNIntersector1<8 COMMA BVH_AN1 COMMA false COMMA ArrayIntersector1<ObjectIntersector1<false>> >));
     IF_ENABLED_USER(DEFINE_INTERSECTOR1(BVH8VirtualMBIntersector1,BVHNIntersector1<8 COMMA BVH_AN2_AN4D COMMA false COMMA ArrayIntersector1<ObjectIntersector1<true>> >));
 
@@ -24,6 +24,7 @@
 #include "../geometry/trianglev_intersector.h"
 #include "../geometry/trianglev_mb_intersector.h"
 #include "../geometry/trianglei_intersector.h"
+#include "../geometry/trianglec_intersector.h"
 #include "../geometry/quadv_intersector.h"
 #include "../geometry/quadi_intersector.h"
 #include "../geometry/curveNv_intersector.h"
@@ -173,7 +174,7 @@ namespace embree
         
         for (; valid_bits!=0; ) {
           const size_t i = bscf(valid_bits);
-          intersect1(This, bvh, bvh->root, i, pre, ray, tray, context);
+          intersect1(This, bvh, bvh->getRoot(), i, pre, ray, tray, context);
         }
         return;
       }
@@ -223,7 +224,7 @@ namespace embree
         NodeRef stack_node[stackSizeChunk];
         stack_node[0] = BVH::invalidNode;
         stack_near[0] = inf;
-        stack_node[1] = bvh->root;
+        stack_node[1] = bvh->getRoot();
         stack_near[1] = tray.tnear;
         NodeRef* stackEnd MAYBE_UNUSED = stack_node+stackSizeChunk;
         NodeRef* __restrict__ sptr_node = stack_node + 2;
@@ -432,7 +433,7 @@ namespace embree
 
         StackItemT<NodeRef> stack[stackSizeSingle];  // stack of nodes
         StackItemT<NodeRef>* stackPtr = stack + 1;   // current stack pointer
-        stack[0].ptr  = bvh->root;
+        stack[0].ptr  = bvh->getRoot();
         stack[0].dist = neg_inf;
 
         while (1) pop:
@@ -667,7 +668,7 @@ namespace embree
       NodeRef stack_node[stackSizeChunk];
       stack_node[0] = BVH::invalidNode;
       stack_near[0] = inf;
-      stack_node[1] = bvh->root;
+      stack_node[1] = bvh->getRoot();
       stack_near[1] = tray.tnear;
       NodeRef* stackEnd MAYBE_UNUSED = stack_node+stackSizeChunk;
       NodeRef* __restrict__ sptr_node = stack_node + 2;
@@ -843,7 +844,7 @@ namespace embree
 
         StackItemMaskT<NodeRef> stack[stackSizeSingle];  // stack of nodes
         StackItemMaskT<NodeRef>* stackPtr = stack + 1;   // current stack pointer
-        stack[0].ptr  = bvh->root;
+        stack[0].ptr  = bvh->getRoot();
         stack[0].mask = movemask(octant_valid);
 
         while (1) pop:
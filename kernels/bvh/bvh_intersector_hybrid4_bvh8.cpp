@@ -50,6 +50,10 @@ namespace embree
     IF_ENABLED_CURVES(DEFINE_INTERSECTOR4(BVH8OBBVirtualCurveIntersectorRobust4Hybrid, BVHNIntersectorKHybrid<8 COMMA 4 COMMA BVH_AN1_UN1 COMMA true COMMA VirtualCurveIntersectorK<4> >));
     IF_ENABLED_CURVES(DEFINE_INTERSECTOR4(BVH8OBBVirtualCurveIntersectorRobust4HybridMB, BVHNIntersectorKHybrid<8 COMMA 4 COMMA BVH_AN2_AN4D_UN2 COMMA true COMMA VirtualCurveIntersectorK<4> >));
 
+    IF_ENABLED_TRIS(DEFINE_INTERSECTOR4(QBVH8Triangle4iMBIntersector4HybridPluecker,BVHNIntersectorKHybrid<8 COMMA 4 COMMA BVH_QN2_AN4D COMMA false COMMA ArrayIntersectorK_1<4 COMMA TriangleMiMBIntersectorKPluecker<SIMD_MODE(4) COMMA 4 COMMA true> > >));
+    IF_ENABLED_QUADS(DEFINE_INTERSECTOR4(QBVH8Quad4iMBIntersector4HybridPluecker,BVHNIntersectorKHybrid<8 COMMA 4 COMMA BVH_QN2_AN4D COMMA false COMMA ArrayIntersectorK_1<4 COMMA QuadMiMBIntersectorKPluecker<4 COMMA 4 COMMA true> > >));
+    IF_ENABLED_CURVES(DEFINE_INTERSECTOR4(QBVH8OBBVirtualCurveIntersector4HybridMB,BVHNIntersectorKHybrid<8 COMMA 4 COMMA BVH_QN2_AN4D_UN2 COMMA false COMMA VirtualCurveIntersectorK<4> >));
+
     IF_ENABLED_USER(DEFINE_INTERSECTOR4(BVH8VirtualIntersector4Chunk, BVHNIntersectorKChunk<8 COMMA 4 COMMA BVH_AN1 COMMA false COMMA ArrayIntersectorK_1<4 COMMA ObjectIntersector4> >));
     IF_ENABLED_USER(DEFINE_INTERSECTOR4(BVH8VirtualMBIntersector4Chunk, BVHNIntersectorKChunk<8 COMMA 4 COMMA BVH_AN2_AN4D COMMA false COMMA ArrayIntersectorK_1<4 COMMA ObjectIntersector4MB> >));
 
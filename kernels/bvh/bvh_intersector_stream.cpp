@@ -89,7 +89,7 @@ namespace embree
 
       stack[0].mask   = m_active;
       stack[0].parent = 0;
-      stack[0].child  = bvh->root;
+      stack[0].child  = bvh->getRoot();
 
       ///////////////////////////////////////////////////////////////////////////////////
       ///////////////////////////////////////////////////////////////////////////////////
@@ -217,7 +217,7 @@ namespace embree
 
       stack[0].mask   = m_active;
       stack[0].parent = 0;
-      stack[0].child  = bvh->root;
+      stack[0].child  = bvh->getRoot();
 
       ///////////////////////////////////////////////////////////////////////////////////
       ///////////////////////////////////////////////////////////////////////////////////
@@ -289,9 +289,14 @@ namespace embree
           vbool<K> m_valid = p.tnear <= p.tfar;
           vbool<K> m_hit = PrimitiveIntersectorK<K>::occludedK(m_valid, This, *inputPackets[i], context, prim, num, lazy_node);
           inputPackets[i]->tfar = select(m_hit & m_valid, vfloat<K>(neg_inf), inputPackets[i]->tfar);
+          /* compact terminated rays out of the packet for the node tests of the remaining subtrees */
+          p.tfar = select(m_hit & m_valid, vfloat<K>(neg_inf), p.tfar);
           m_active &= ~((size_t)movemask(m_hit) << (i*K));
         }
 
+        /* terminate traversal once every ray found a hit */
+        if (unlikely(m_active == 0)) break;
+
       } // traversal + intersection
     }
 
@@ -328,7 +333,7 @@ namespace embree
 
       StackItemMaskT<NodeRef> stack[stackSizeSingle]; // stack of nodes
       StackItemMaskT<NodeRef>* stackPtr = stack + 1;  // current stack pointer
-      stack[0].ptr = bvh->root;
+      stack[0].ptr = bvh->getRoot();
       stack[0].mask = m_active;
 
       size_t terminated = ~m_active;
@@ -406,6 +411,7 @@ namespace embree
           if (PrimitiveIntersectorK<K>::occluded(This, ray, k, context, prim, num, lazy_node))
           {
             ray.tfar[k] = neg_inf;
+            packet[rayID / K].tfar[k] = neg_inf;
             terminated |= (size_t)1 << rayID;
           }
 
@@ -413,7 +419,7 @@ namespace embree
           if (unlikely(lazy_node))
           {
             stackPtr->ptr = lazy_node;
-            stackPtr->mask = cur_mask;
+            stackPtr->mask = cur_mask & (~terminated);
             stackPtr++;
           }
         }
@@ -426,44 +432,46 @@ namespace embree
     /// ArrayIntersectorKStream Definitions
     ////////////////////////////////////////////////////////////////////////////////
 
+    /* the filter=false variants get selected for scenes without filter
+       functions and skip the filter dispatch on the first hit of a ray */
     template<bool filter>
     struct Triangle4IntersectorStreamMoeller {
-      template<int K> using Type = ArrayIntersectorKStream<K,TriangleMIntersectorKMoeller<SIMD_MODE(4) COMMA K COMMA true>>;
+      template<int K> using Type = ArrayIntersectorKStream<K,TriangleMIntersectorKMoeller<SIMD_MODE(4) COMMA K COMMA filter>>;
     };
 
     template<bool filter>
     struct Triangle4vIntersectorStreamPluecker {
-      template<int K> using Type = ArrayIntersectorKStream<K,TriangleMvIntersectorKPluecker<SIMD_MODE(4) COMMA K COMMA true>>;
+      template<int K> using Type = ArrayIntersectorKStream<K,TriangleMvIntersectorKPluecker<SIMD_MODE(4) COMMA K COMMA filter>>;
     };
 
     template<bool filter>
     struct Triangle4iIntersectorStreamMoeller {
-      template<int K> using Type = ArrayIntersectorKStream<K,TriangleMiIntersectorKMoeller<SIMD_MODE(4) COMMA K COMMA true>>;
+      template<int K> using Type = ArrayIntersectorKStream<K,TriangleMiIntersectorKMoeller<SIMD_MODE(4) COMMA K COMMA filter>>;
     };
 
     template<bool filter>
     struct Triangle4iIntersectorStreamPluecker {
-      template<int K> using Type = ArrayIntersectorKStream<K,TriangleMiIntersectorKPluecker<SIMD_MODE(4) COMMA K COMMA true>>;
+      template<int K> using Type = ArrayIntersectorKStream<K,TriangleMiIntersectorKPluecker<SIMD_MODE(4) COMMA K COMMA filter>>;
     };
 
     template<bool filter>
     struct Quad4vIntersectorStreamMoeller {
-      template<int K> using Type = ArrayIntersectorKStream<K,QuadMvIntersectorKMoeller<4 COMMA K COMMA true>>;
+      template<int K> using Type = ArrayIntersectorKStream<K,QuadMvIntersectorKMoeller<4 COMMA K COMMA filter>>;
     };
 
     template<bool filter>
     struct Quad4iIntersectorStreamMoeller {
-      template<int K> using Type = ArrayIntersectorKStream<K,QuadMiIntersectorKMoeller<4 COMMA K COMMA true>>;
+      template<int K> using Type = ArrayIntersectorKStream<K,QuadMiIntersectorKMoeller<4 COMMA K COMMA filter>>;
     };
 
     template<bool filter>
     struct Quad4vIntersectorStreamPluecker {
-      template<int K> using Type = ArrayIntersectorKStream<K,QuadMvIntersectorKPluecker<4 COMMA K COMMA true>>;
+      template<int K> using Type = ArrayIntersectorKStream<K,QuadMvIntersectorKPluecker<4 COMMA K COMMA filter>>;
     };
 
     template<bool filter>
     struct Quad4iIntersectorStreamPluecker {
-      template<int K> using Type = ArrayIntersectorKStream<K,QuadMiIntersectorKPluecker<4 COMMA K COMMA true>>;
+      template<int K> using Type = ArrayIntersectorKStream<K,QuadMiIntersectorKPluecker<4 COMMA K COMMA filter>>;
     };
 
     struct ObjectIntersectorStream {
@@ -16,11 +16,229 @@
 
 #include "bvh_intersector_stream_filters.h"
 #include "bvh_intersector_stream.h"
+#include "../../common/algorithms/parallel_for.h"
+#include "../../common/algorithms/parallel_sort.h"
 
 namespace embree
 {
   namespace isa
   {
+    /*! sort code and reference of a ray of the stream */
+    struct RayStreamSortItem
+    {
+      __forceinline operator unsigned int() const { return code; }
+
+      unsigned int code;
+      unsigned int ref;
+    };
+
+    /*! batches with more rays get their sort codes computed and sorted in parallel */
+    static const size_t PARALLEL_STREAM_SORT_THRESHOLD = 8192;
+
+    /*! the streams below address rays through a 32 bit reference, the
+     *  byte offset of the ray for AOS, SOA, and SOP layouts and the ray
+     *  index for the AOP layout */
+
+    struct RayStreamRefsAOS
+    {
+      __forceinline RayStreamRefsAOS(void* rays, size_t stride)
+        : rayN(rays), stride(stride) {}
+
+      __forceinline unsigned int ref(size_t i) const { return (unsigned int)(i * stride); }
+      __forceinline Ray getRay(unsigned int ref) { return rayN.getRayByOffset(ref); }
+
+      template<int K>
+      __forceinline RayK<K> getRay(const vbool<K>& valid, const vint<K>& ref) { return rayN.getRayByOffset(valid, ref); }
+
+      template<int K, typename RayT>
+      __forceinline void setHit(const vbool<K>& valid, const vint<K>& ref, const RayT& ray) { rayN.setHitByOffset(valid, ref, ray); }
+
+      RayStreamAOS rayN;
+      size_t stride;
+    };
+
+    struct RayStreamRefsAOP
+    {
+      __forceinline RayStreamRefsAOP(void** rays)
+        : rayN(rays) {}
+
+      __forceinline unsigned int ref(size_t i) const { return (unsigned int)i; }
+      __forceinline Ray getRay(unsigned int ref) { return rayN.getRayByIndex(ref); }
+
+      template<int K>
+      __forceinline RayK<K> getRay(const vbool<K>& valid, const vint<K>& ref) { return rayN.getRayByIndex(valid, ref); }
+
+      template<int K, typename RayT>
+      __forceinline void setHit(const vbool<K>& valid, const vint<K>& ref, const RayT& ray) { rayN.setHitByIndex(valid, ref, ray); }
+
+      RayStreamAOP rayN;
+    };
+
+    struct RayStreamRefsSOA
+    {
+      __forceinline RayStreamRefsSOA(char* rays, size_t N, size_t stride)
+        : rayN(rays, N), N(N), stride(stride) {}
+
+      __forceinline unsigned int ref(size_t i) const { return (unsigned int)((i / N) * stride + (i % N) * sizeof(float)); }
+      __forceinline Ray getRay(unsigned int ref) { return rayN.getRayByOffset(ref); }
+
+      template<int K>
+      __forceinline RayK<K> getRay(const vbool<K>& valid, const vint<K>& ref) { return rayN.getRayByOffset(valid, ref); }
+
+      template<int K, typename RayT>
+      __forceinline void setHit(const vbool<K>& valid, const vint<K>& ref, const RayT& ray) { rayN.setHitByOffset(valid, ref, ray); }
+
+      RayStreamSOA rayN;
+      size_t N;
+      size_t stride;
+    };
+
+    struct RayStreamRefsSOP
+    {
+      __forceinline RayStreamRefsSOP(RayStreamSOP& rayN)
+        : rayN(rayN) {}
+
+      __forceinline unsigned int ref(size_t i) const { return (unsigned int)(i * sizeof(float)); }
+      __forceinline Ray getRay(unsigned int ref) { return rayN.getRayByOffset(ref); }
+
+      template<int K>
+      __forceinline RayK<K> getRay(const vbool<K>& valid, const vint<K>& ref) { return rayN.getRayByOffset(valid, ref); }
+
+      template<int K, typename RayT>
+      __forceinline void setHit(const vbool<K>& valid, const vint<K>& ref, const RayT& ray) { rayN.setHitByOffset(valid, ref, ray); }
+
+      RayStreamSOP& rayN;
+    };
+
+    __forceinline unsigned int getRayOctant(const Ray& ray) {
+      return (ray.dir.x < 0.0f ? 1 : 0) + (ray.dir.y < 0.0f ? 2 : 0) + (ray.dir.z < 0.0f ? 4 : 0);
+    }
+
+    /*! quantizes p relative to the bounds into the specified number of bits per dimension */
+    __forceinline unsigned int quantize(const Vec3fa& p, const Vec3fa& lower, const Vec3fa& scale, const unsigned int maxValue)
+    {
+      const Vec3fa q = min(max((p - lower) * scale, Vec3fa(zero)), Vec3fa(float(maxValue)));
+      return bitInterleave((unsigned int)q.x, (unsigned int)q.y, (unsigned int)q.z);
+    }
+
+    /*! reorders batches of the stream by a Morton code of the ray origin
+     *  or by binned direction and origin, the octant is always stored in
+     *  the top bits of the code thus each sorted batch splits into octant
+     *  coherent runs that are traced as streams (occlusion rays) or as
+     *  consecutive packets (intersection rays) */
+    template<int K, bool intersect, typename RayStreamRefs>
+    __noinline void RayStreamFilter::filterSorted(Scene* scene, RayStreamRefs& rayN, size_t N, IntersectContext* context)
+    {
+      const State::STREAM_SORT mode = scene->device->stream_sort;
+      const size_t batchSize = scene->device->stream_sort_batch_size ? min(N, scene->device->stream_sort_batch_size) : N;
+
+      avector<RayStreamSortItem> items(batchSize);
+      avector<RayStreamSortItem> temp(batchSize);
+
+      __aligned(64) RayTypeK<K, intersect> rays[MAX_INTERNAL_STREAM_SIZE / K];
+      __aligned(64) RayTypeK<K, intersect>* rayPtrs[MAX_INTERNAL_STREAM_SIZE / K];
+      __aligned(64) unsigned int refs[MAX_INTERNAL_STREAM_SIZE];
+
+      for (size_t b = 0; b < N; b += batchSize)
+      {
+        const size_t end = min(N, b + batchSize);
+
+        /* collect valid rays and bounds of their origins */
+        BBox3fa bounds(empty);
+        size_t numRays = 0;
+        for (size_t i = b; i < end; i++)
+        {
+          const unsigned int ref = rayN.ref(i);
+          const Ray ray = rayN.getRay(ref);
+
+          /* skip invalid rays */
+          if (unlikely(ray.tnear() > ray.tfar)) continue;
+          if (unlikely(!intersect && ray.tfar < 0.0f)) continue; // ignore already occluded rays
+#if defined(EMBREE_IGNORE_INVALID_RAYS)
+          if (unlikely(!ray.valid())) continue;
+#endif
+          bounds.extend(Vec3fa(ray.org));
+          items[numRays++].ref = ref;
+        }
+        if (unlikely(numRays == 0)) continue;
+
+        /* compute sort codes */
+        const Vec3fa diag = bounds.size();
+        const unsigned int originBits = mode == State::STREAM_SORT_MORTON ? 9 : 6;
+        const unsigned int originMax = (1 << originBits) - 1;
+        const Vec3fa scale = select(gt_mask(diag, Vec3fa(1E-19f)), Vec3fa(float(originMax)) * rcp(diag), Vec3fa(0.0f));
+
+        auto computeCodes = [&] (const range<size_t>& r)
+        {
+          for (size_t i = r.begin(); i < r.end(); i++)
+          {
+            const Ray ray = rayN.getRay(items[i].ref);
+            const unsigned int octant = getRayOctant(ray);
+            unsigned int code = quantize(Vec3fa(ray.org), bounds.lower, scale, originMax);
+
+            if (mode == State::STREAM_SORT_DIRECTION)
+            {
+              const Vec3fa dir = abs(Vec3fa(ray.dir));
+              const float sum = dir.x + dir.y + dir.z;
+              const Vec3fa dirScale = Vec3fa(sum > 0.0f ? 8.0f / sum : 0.0f);
+              code |= quantize(dir, Vec3fa(zero), dirScale, 7) << 18;
+            }
+            items[i].code = (octant << 27) | code;
+          }
+        };
+
+        /* large batches are processed by the tasking system, small ones by the calling thread only */
+        if (numRays > PARALLEL_STREAM_SORT_THRESHOLD)
+          parallel_for(size_t(0), numRays, PARALLEL_STREAM_SORT_THRESHOLD/4, computeCodes);
+        else
+          computeCodes(range<size_t>(0, numRays));
+
+        radix_sort_u32(items.data(), temp.data(), numRays, PARALLEL_STREAM_SORT_THRESHOLD);
+
+        /* trace the sorted rays */
+        for (size_t i = 0; i < numRays;)
+        {
+          size_t numStreamRays = 0;
+          if (intersect)
+          {
+            for (; numStreamRays < K && i < numRays; i++)
+              refs[numStreamRays++] = items[i].ref;
+          }
+          else
+          {
+            const unsigned int octant = items[i].code >> 27;
+            for (; numStreamRays < MAX_INTERNAL_STREAM_SIZE && i < numRays && (items[i].code >> 27) == octant; i++)
+              refs[numStreamRays++] = items[i].ref;
+          }
+
+          for (size_t j = 0; j < numStreamRays; j += K)
+          {
+            const vint<K> vi = vint<K>(int(j)) + vint<K>(step);
+            const vbool<K> valid = vi < vint<K>(int(numStreamRays));
+            const vint<K> ref = vint<K>::loadu(&refs[j]);
+            RayTypeK<K, intersect>& ray = rays[j/K];
+            rayPtrs[j/K] = &ray;
+            ray = rayN.template getRay<K>(valid, ref);
+            ray.tnear() = select(valid, ray.tnear(), zero);
+            ray.tfar  = select(valid, ray.tfar,  neg_inf);
+          }
+
+          if (intersect)
+            scene->intersectors.intersect(vint<K>(step) < vint<K>(int(numStreamRays)), *(RayHitK<K>*)rayPtrs[0], context);
+          else
+            scene->intersectors.occludedN((RayK<K>**)rayPtrs, numStreamRays, context);
+
+          for (size_t j = 0; j < numStreamRays; j += K)
+          {
+            const vint<K> vi = vint<K>(int(j)) + vint<K>(step);
+            const vbool<K> valid = vi < vint<K>(int(numStreamRays));
+            const vint<K> ref = vint<K>::loadu(&refs[j]);
+            rayN.template setHit<K>(valid, ref, rays[j/K]);
+          }
+        }
+      }
+    }
+
     template<int K, bool intersect>
     __noinline void RayStreamFilter::filterAOS(Scene* scene, void* _rayN, size_t N, size_t stride, IntersectContext* context)
     {
@@ -66,6 +284,12 @@ namespace embree
           }
         }
       }
+      else if (unlikely(scene->device->stream_sort != State::STREAM_SORT_OCTANT))
+      {
+        /* reorder the whole stream for more coherent traversal */
+        RayStreamRefsAOS rayRefs(_rayN, stride);
+        filterSorted<K, intersect>(scene, rayRefs, N, context);
+      }
       else if (unlikely(!intersect))
       {
         /* octant sorting for occlusion rays */
@@ -208,6 +432,12 @@ namespace embree
           }
         }
       }
+      else if (unlikely(scene->device->stream_sort != State::STREAM_SORT_OCTANT))
+      {
+        /* reorder the whole stream for more coherent traversal */
+        RayStreamRefsAOP rayRefs(_rayN);
+        filterSorted<K, intersect>(scene, rayRefs, N, context);
+      }
       else if (unlikely(!intersect))
       {
         /* octant sorting for occlusion rays */
@@ -311,6 +541,14 @@ namespace embree
       const size_t rayDataAlignment = (size_t)rayData % (K*sizeof(float));
       const size_t offsetAlignment  = (size_t)stride  % (K*sizeof(float));
 
+      /* reorder the whole stream for more coherent traversal */
+      if (unlikely(!context->isCoherent() && scene->device->stream_sort != State::STREAM_SORT_OCTANT))
+      {
+        RayStreamRefsSOA rayRefs(rayData, N, stride);
+        filterSorted<K, intersect>(scene, rayRefs, N*numPackets, context);
+        return;
+      }
+
       /* fast path for packets with the correct width and data alignment */
       if (likely(N == K &&
                  !rayDataAlignment &&
@@ -506,6 +744,12 @@ namespace embree
           }
         }
       }
+      else if (unlikely(scene->device->stream_sort != State::STREAM_SORT_OCTANT))
+      {
+        /* reorder the whole stream for more coherent traversal */
+        RayStreamRefsSOP rayRefs(rayN);
+        filterSorted<K, intersect>(scene, rayRefs, N, context);
+      }
       else if (unlikely(!intersect))
       {
         /* octant sorting for occlusion rays */
@@ -49,6 +49,9 @@ namespace embree
 
       template<int K, bool intersect>
       static void filterSOP(Scene* scene, const void* rays, size_t N, IntersectContext* context);
+
+      template<int K, bool intersect, typename RayStreamRefs>
+      static void filterSorted(Scene* scene, RayStreamRefs& rayN, size_t N, IntersectContext* context);
     };
   }
 };
@@ -0,0 +1,130 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "bvh_knn.h"
+#include "node_intersector1.h"
+#include "bvh_traverser1.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    template<int N, int types, int M>
+    __forceinline void BVHNKNNQuery<N,types,M>::processLeaf(const Scene* scene, NodeRef cur, const PointQuery* query, KNNHeap* heap)
+    {
+      /* leaves of a curve BVH only store primitives of a single type */
+      size_t num; const Primitive* prims = (const Primitive*) cur.leaf(num);
+      const Geometry::GType gtype = (Geometry::GType) prims[0].gtype;
+      if (gtype != Geometry::GTY_SPHERE_POINT && gtype != Geometry::GTY_DISC_POINT && gtype != Geometry::GTY_ORIENTED_DISC_POINT)
+        return;
+
+      const Vec3vf<M> p(query->p.x,query->p.y,query->p.z);
+      for (size_t i=0; i<num; i++)
+      {
+        const Primitive& prim = prims[i];
+        STAT3(point_query.trav_prims,1,1,1);
+
+        /* distances of all point centers of the block at once */
+        Vec4vf<M> v;
+        if (types & BVH_MB) prim.gather(v,scene,query->time);
+        else                prim.gather(v,scene);
+        const Vec3vf<M> d = Vec3vf<M>(v.x,v.y,v.z) - p;
+        const vfloat<M> dist2 = dot(d,d);
+
+        size_t mask = movemask(prim.template valid<M>() & (dist2 <= vfloat<M>(heap->cullRadius2())));
+        while (mask) {
+          const size_t j = bscf(mask);
+          heap->insert(prim.geomID(),prim.primID(j),dist2[j]);
+        }
+      }
+    }
+
+    template<int N, int types, int M>
+    void BVHNKNNQuery<N,types,M>::query(Accel::Intersectors* This, PointQuery* query, KNNHeap* heap)
+    {
+      const BVH* __restrict__ bvh = (const BVH*)This->ptr;
+
+      /* we may traverse an empty BVH in case all geometry was invalid */
+      if (bvh->root == BVH::emptyNode)
+        return;
+
+      /* stack state */
+      StackItemT<NodeRef> stack[stackSize];    // stack of nodes
+      StackItemT<NodeRef>* stackPtr = stack+1; // current stack pointer
+      StackItemT<NodeRef>* stackEnd = stack+stackSize;
+      stack[0].ptr  = bvh->root;
+      stack[0].dist = neg_inf;
+
+      /* the query radius shrinks to the distance of the k-th neighbor once k neighbors are found */
+      TravPointQuery<N> tquery(query->p,Vec3fa(sqrt(heap->cullRadius2())));
+
+      /* children get visited closest first */
+      BVHNNodeTraverser1Hit<N, N, types> nodeTraverser;
+
+      /* pop loop */
+      while (true) pop:
+      {
+        /* pop next node */
+        if (unlikely(stackPtr == stack)) break;
+        stackPtr--;
+        NodeRef cur = NodeRef(stackPtr->ptr);
+
+        /* if popped node is too far, pop next one */
+        if (unlikely(*(float*)&stackPtr->dist > heap->cullRadius2()))
+          continue;
+
+        /* downtraversal loop */
+        while (true)
+        {
+          /* intersect node */
+          size_t mask; vfloat<N> tNear;
+          STAT3(point_query.trav_nodes,1,1,1);
+          bool nodeIntersected = BVHNNodePointQuerySphere1<N, types>::pointQuery(cur, tquery, query->time, tNear, mask);
+          if (unlikely(!nodeIntersected)) { STAT3(point_query.trav_nodes,-1,-1,-1); break; }
+
+          /* if no child is hit, pop next node */
+          if (unlikely(mask == 0))
+            goto pop;
+
+          /* select next child and push other children */
+          nodeTraverser.traverseClosestHit(cur, mask, tNear, stackPtr, stackEnd);
+        }
+
+        /* this is a leaf node */
+        assert(cur != BVH::emptyNode);
+        STAT3(point_query.trav_leaves,1,1,1);
+        processLeaf(bvh->scene, cur, query, heap);
+        tquery.rad = Vec3vf<N>(sqrt(heap->cullRadius2()));
+      }
+    }
+
+    ////////////////////////////////////////////////////////////////////////////////
+    /// KNN Query Definitions
+    ////////////////////////////////////////////////////////////////////////////////
+
+#if defined(EMBREE_GEOMETRY_CURVE) || defined(EMBREE_GEOMETRY_POINT)
+    DEFINE_KNN_QUERY(BVH4KNNQuery4i,BVHNKNNQuery<4 COMMA BVH_AN1_UN1 COMMA 4>);
+    DEFINE_KNN_QUERY(BVH4KNNQuery4iMB,BVHNKNNQuery<4 COMMA BVH_AN2_AN4D_UN2 COMMA 4>);
+
+#if defined(__AVX__)
+    DEFINE_KNN_QUERY(BVH4KNNQuery8i,BVHNKNNQuery<4 COMMA BVH_AN1_UN1 COMMA 8>);
+    DEFINE_KNN_QUERY(BVH4KNNQuery8iMB,BVHNKNNQuery<4 COMMA BVH_AN2_AN4D_UN2 COMMA 8>);
+    DEFINE_KNN_QUERY(BVH8KNNQuery8i,BVHNKNNQuery<8 COMMA BVH_AN1_UN1 COMMA 8>);
+    DEFINE_KNN_QUERY(BVH8KNNQuery8iMB,BVHNKNNQuery<8 COMMA BVH_AN2_AN4D_UN2 COMMA 8>);
+#endif
+#endif
+  }
+}
@@ -0,0 +1,44 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "bvh.h"
+#include "../geometry/pointi.h"
+
+namespace embree
+{
+  namespace isa
+  {
+    /*! k-nearest neighbor query of the points stored in a curve BVH,
+     *  the other primitives of the BVH get skipped */
+    template<int N, int types, int M>
+    class BVHNKNNQuery
+    {
+      typedef BVHN<N> BVH;
+      typedef typename BVH::NodeRef NodeRef;
+      typedef PointMi<M> Primitive;
+
+      static const size_t stackSize = 1+(N-1)*BVH::maxDepth+3; // +3 due to 16-wide store
+
+    public:
+      static void query (Accel::Intersectors* This, PointQuery* query, KNNHeap* heap);
+
+    private:
+      static void processLeaf (const Scene* scene, NodeRef cur, const PointQuery* query, KNNHeap* heap);
+    };
+  }
+}
@@ -15,6 +15,7 @@
 // ======================================================================== //
 
 #include "bvh_refit.h"
+#include "bvh_rotate.h"
 #include "bvh_statistics.h"
 
 #include "../geometry/linei.h"
@@ -29,6 +30,9 @@ namespace embree
   namespace isa
   {
     static const size_t SINGLE_THREAD_THRESHOLD = 4*1024;
+    static const float ROTATE_THRESHOLD = 1.5f;  // subtrees whose node cost grew by this factor get rotated
+    static const float REBUILD_THRESHOLD = 2.0f; // BVHs whose total cost grew by this factor get rebuilt
+    static const float MAX_MODIFIED_FRACTION = 0.25f; // refit everything when more vertices got modified
     
     template<int N>
     __forceinline bool compare(const typename BVHN<N>::NodeRef* a, const typename BVHN<N>::NodeRef* b)
@@ -40,7 +44,7 @@ namespace embree
 
     template<int N>
     BVHNRefitter<N>::BVHNRefitter (BVH* bvh, const LeafBoundsInterface& leafBounds)
-      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0)
+      : bvh(bvh), leafBounds(leafBounds), numSubTrees(0), isLinked(false), stamp(0), totalCost(0.0), totalLinkCost(0.0)
     {
     }
 
@@ -178,16 +182,310 @@ namespace embree
       return merge<N>(bounds);
     }
 
+    // =========================================================
+    // =========================================================
+    // =========================================================
+
+    template<int N>
+    float BVHNRefitter<N>::cost(const AlignedNode* node)
+    {
+      float c = 0.0f;
+      for (size_t i=0; i<N; i++)
+        if (node->child(i) != BVH::emptyNode)
+          c += halfArea(node->bounds(i));
+      return c;
+    }
+
+    template<int N>
+    bool BVHNRefitter<N>::link_recursive(NodeRef ref, unsigned int parent, unsigned int slot, unsigned int depth,
+                                         size_t& nodeID, size_t& leafID, LeafLinkInterface& leafLink)
+    {
+      if (ref == BVH::emptyNode)
+        return true;
+
+      if (ref.isLeaf())
+      {
+        if (leafID >= leafLinks.size()) leafLinks.resize(leafID+1);
+        LeafLink& leaf = leafLinks[leafID];
+        leaf.ref = ref; leaf.parent = parent; leaf.slot = slot;
+        leafLink.linkLeaf(ref,leafID++);
+        return true;
+      }
+
+      if (!ref.isAlignedNode())
+        return false;
+
+      const size_t id = nodeID++;
+      const size_t firstLeaf = leafID;
+      if (id >= nodeLinks.size()) nodeLinks.resize(id+1);
+
+      AlignedNode* node = ref.alignedNode();
+      for (size_t i=0; i<N; i++)
+        if (!link_recursive(node->child(i),(unsigned int)id,(unsigned int)i,depth+1,nodeID,leafID,leafLink))
+          return false;
+
+      NodeLink& link = nodeLinks[id];
+      link.node = node;
+      link.parent = parent;
+      link.slot = slot;
+      link.depth = depth;
+      link.numNodes = (unsigned int)(nodeID-id);
+      link.firstLeaf = (unsigned int)firstLeaf;
+      link.cost = link.linkCost = cost(node);
+      return true;
+    }
+
+    template<int N>
+    bool BVHNRefitter<N>::link(LeafLinkInterface& leafLink)
+    {
+      unlink();
+
+      size_t nodeID = 0, leafID = 0;
+      if (!link_recursive(bvh->root,invalidLink,0,0,nodeID,leafID,leafLink)) {
+        unlink();
+        return false;
+      }
+
+      nodeStamps.assign(nodeLinks.size(),0);
+      stamp = 0;
+      totalCost = 0.0;
+      for (size_t i=0; i<nodeLinks.size(); i++)
+        totalCost += nodeLinks[i].cost;
+      totalLinkCost = totalCost;
+      isLinked = true;
+      return true;
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::unlink()
+    {
+      isLinked = false;
+      nodeLinks.clear();
+      leafLinks.clear();
+      nodeStamps.clear();
+    }
+
+    template<int N>
+    bool BVHNRefitter<N>::refit(const std::vector<size_t>& leafIDs, LeafLinkInterface& leafLink)
+    {
+      assert(isLinked);
+      if (++stamp == 0) {
+        std::fill(nodeStamps.begin(),nodeStamps.end(),0);
+        stamp = 1;
+      }
+
+      /* nodes get refitted bottom up, one depth level after the other */
+      std::vector<std::vector<unsigned int>> levels(BVH::maxDepth+1);
+      auto schedule = [&] (unsigned int id) {
+        if (nodeStamps[id] == stamp) return;
+        nodeStamps[id] = stamp;
+        levels[min(size_t(nodeLinks[id].depth),size_t(BVH::maxDepth))].push_back(id);
+      };
+
+      for (size_t i=0; i<leafIDs.size(); i++)
+      {
+        LeafLink& leaf = leafLinks[leafIDs[i]];
+        const BBox3fa bounds = leafBounds.leafBounds(leaf.ref);
+        if (leaf.parent == invalidLink) {
+          bvh->bounds = LBBox3fa(bounds);
+          continue;
+        }
+        nodeLinks[leaf.parent].node->setBounds(leaf.slot,bounds);
+        schedule(leaf.parent);
+      }
+
+      std::vector<unsigned int> degraded;
+      for (ssize_t depth=levels.size()-1; depth>=0; depth--)
+      {
+        for (size_t i=0; i<levels[depth].size(); i++)
+        {
+          NodeLink& link = nodeLinks[levels[depth][i]];
+          const float c = cost(link.node);
+          totalCost += c - link.cost;
+          link.cost = c;
+          if (c > ROTATE_THRESHOLD*link.linkCost)
+            degraded.push_back(levels[depth][i]);
+
+          const BBox3fa bounds = link.node->bounds();
+          if (link.parent == invalidLink) {
+            bvh->bounds = LBBox3fa(bounds);
+            continue;
+          }
+          nodeLinks[link.parent].node->setBounds(link.slot,bounds);
+          schedule(link.parent);
+        }
+      }
+
+      if (totalCost > REBUILD_THRESHOLD*totalLinkCost)
+        return false;
+
+      if (!BVHNRotate<N>::enabled)
+        return true;
+
+      /* rotate topmost degraded subtrees, rotations do not change the bounds of the subtree */
+      std::vector<unsigned int> rotated;
+      for (ssize_t i=degraded.size()-1; i>=0; i--)
+      {
+        const unsigned int id = degraded[i];
+        bool inside = false;
+        for (size_t j=0; j<rotated.size() && !inside; j++)
+          inside = rotated[j] <= id && id < rotated[j]+nodeLinks[rotated[j]].numNodes;
+        if (inside) continue;
+
+        rotate(id,leafLink);
+        rotated.push_back(id);
+      }
+      return true;
+    }
+
+    template<int N>
+    void BVHNRefitter<N>::rotate(size_t id, LeafLinkInterface& leafLink)
+    {
+      const NodeLink link = nodeLinks[id];
+      double oldCost = 0.0;
+      for (size_t i=id; i<id+link.numNodes; i++)
+        oldCost += nodeLinks[i].cost;
+
+      BVHNRotate<N>::rotate(BVH::encodeNode(link.node),link.depth+1);
+
+      /* rotations keep the nodes and leaves of the subtree, thus it gets relinked in place */
+      size_t nodeID = id, leafID = link.firstLeaf;
+      link_recursive(BVH::encodeNode(link.node),link.parent,link.slot,link.depth,nodeID,leafID,leafLink);
+      assert(nodeID == id+link.numNodes);
+
+      double newCost = 0.0;
+      for (size_t i=id; i<id+link.numNodes; i++)
+        newCost += nodeLinks[i].cost;
+      totalCost += newCost - oldCost;
+    }
+
+    // =========================================================
+    // =========================================================
+    // =========================================================
+
+    /*! vertex buffer used to track modified primitives of a mesh */
+    __forceinline const RawBufferView* getRefitVertices(const TriangleMesh* mesh) { return mesh->numTimeSteps == 1 ? &mesh->vertices[0] : nullptr; }
+    __forceinline const RawBufferView* getRefitVertices(const QuadMesh* mesh)     { return mesh->numTimeSteps == 1 ? &mesh->vertices[0] : nullptr; }
+    __forceinline const RawBufferView* getRefitVertices(const UserGeometry* mesh) { return nullptr; }
+
+    /*! vertices used by some primitive of a mesh */
+    __forceinline size_t getRefitPrimVertices(const TriangleMesh* mesh, size_t primID, unsigned int v[4])
+    {
+      const TriangleMesh::Triangle& tri = mesh->triangle(primID);
+      v[0] = tri.v[0]; v[1] = tri.v[1]; v[2] = tri.v[2];
+      return 3;
+    }
+
+    __forceinline size_t getRefitPrimVertices(const QuadMesh* mesh, size_t primID, unsigned int v[4])
+    {
+      const QuadMesh::Quad& quad = mesh->quad(primID);
+      v[0] = quad.v[0]; v[1] = quad.v[1]; v[2] = quad.v[2]; v[3] = quad.v[3];
+      return 4;
+    }
+
+    __forceinline size_t getRefitPrimVertices(const UserGeometry* mesh, size_t primID, unsigned int v[4]) {
+      return 0;
+    }
+
+    /*! invokes func for the primitive ID of each valid primitive of a leaf block */
+    template<typename Primitive, typename Func>
+    __forceinline void foreachPrimID(const Primitive& prim, const Func& func)
+    {
+      for (size_t i=0; i<Primitive::max_size(); i++) {
+        if (!prim.valid(i)) break;
+        func(prim.primID(i));
+      }
+    }
+
+    template<typename Func>
+    __forceinline void foreachPrimID(const Object& prim, const Func& func) {
+      func(prim.primID());
+    }
+
     template<int N, typename Mesh, typename Primitive>
     BVHNRefitT<N,Mesh,Primitive>::BVHNRefitT (BVH* bvh, Builder* builder, Mesh* mesh, size_t mode)
-      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0) {}
+      : bvh(bvh), builder(builder), refitter(new BVHNRefitter<N>(bvh,*(typename BVHNRefitter<N>::LeafBoundsInterface*)this)), mesh(mesh), topologyVersion(0), vertexModCounter(0) {}
 
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::clear()
     {
+      refitter->unlink();
       if (builder) 
         builder->clear();
     }
+
+    template<int N, typename Mesh, typename Primitive>
+    void BVHNRefitT<N,Mesh,Primitive>::linkLeaf(NodeRef& ref, size_t leafID)
+    {
+      size_t num; char* prim = ref.leaf(num);
+      for (size_t i=0; i<num; i++)
+        foreachPrimID(((Primitive*)prim)[i], [&] (unsigned int primID) {
+            if (primID < primLeaf.size()) primLeaf[primID] = (unsigned int) leafID;
+          });
+    }
+
+    template<int N, typename Mesh, typename Primitive>
+    bool BVHNRefitT<N,Mesh,Primitive>::refitModified()
+    {
+      const RawBufferView* vertices = getRefitVertices(mesh);
+      if (vertices == nullptr)
+        return false;
+
+      std::vector<range<size_t>> ranges;
+      if (!vertices->getModifiedRanges(vertexModCounter,ranges))
+        return false;
+
+      size_t numModified = 0;
+      for (size_t i=0; i<ranges.size(); i++)
+        numModified += ranges[i].size();
+      if (numModified > MAX_MODIFIED_FRACTION*vertices->size())
+        return false;
+
+      /* link BVH and create vertex to primitive map once after each build */
+      if (!refitter->linked())
+      {
+        primLeaf.assign(mesh->size(),unsigned(-1));
+        if (!refitter->link(*this))
+          return false;
+
+        const size_t numVertices = vertices->size();
+        unsigned int v[4];
+        vertexPrimOffsets.assign(numVertices+1,0);
+        for (size_t primID=0; primID<mesh->size(); primID++) {
+          const size_t n = getRefitPrimVertices(mesh,primID,v);
+          for (size_t k=0; k<n; k++)
+            if (v[k] < numVertices) vertexPrimOffsets[v[k]+1]++;
+        }
+        for (size_t i=0; i<numVertices; i++)
+          vertexPrimOffsets[i+1] += vertexPrimOffsets[i];
+
+        vertexPrims.resize(vertexPrimOffsets[numVertices]);
+        std::vector<unsigned int> pos(vertexPrimOffsets.begin(),vertexPrimOffsets.end()-1);
+        for (size_t primID=0; primID<mesh->size(); primID++) {
+          const size_t n = getRefitPrimVertices(mesh,primID,v);
+          for (size_t k=0; k<n; k++)
+            if (v[k] < numVertices) vertexPrims[pos[v[k]]++] = (unsigned int) primID;
+        }
+      }
+
+      /* gather leaves of primitives with modified vertices */
+      std::vector<size_t> leafIDs;
+      for (size_t i=0; i<ranges.size(); i++)
+        for (size_t v=ranges[i].begin(); v<ranges[i].end(); v++)
+          for (size_t j=vertexPrimOffsets[v]; j<vertexPrimOffsets[v+1]; j++) {
+            const unsigned int leafID = primLeaf[vertexPrims[j]];
+            if (leafID != unsigned(-1)) leafIDs.push_back(leafID);
+          }
+
+      std::sort(leafIDs.begin(),leafIDs.end());
+      leafIDs.erase(std::unique(leafIDs.begin(),leafIDs.end()),leafIDs.end());
+
+      if (!refitter->refit(leafIDs,*this)) {
+        builder->build();
+        refitter->unlink();
+      }
+      return true;
+    }
     
     template<int N, typename Mesh, typename Primitive>
     void BVHNRefitT<N,Mesh,Primitive>::build()
@@ -195,9 +493,15 @@ namespace embree
       if (mesh->topologyChanged(topologyVersion)) {
         topologyVersion = mesh->getTopologyVersion();
         builder->build();
+        refitter->unlink();
       }
-      else
+      else if (!refitModified()) {
         refitter->refit();
+        refitter->unlink();
+      }
+
+      if (const RawBufferView* vertices = getRefitVertices(mesh))
+        vertexModCounter = vertices->modCounter;
     }
 
     template class BVHNRefitter<4>;
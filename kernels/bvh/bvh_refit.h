@@ -36,6 +36,10 @@ namespace embree
         virtual const BBox3fa leafBounds(NodeRef& ref) const = 0;
       };
 
+      struct LeafLinkInterface {
+        virtual void linkLeaf(NodeRef& ref, size_t leafID) = 0;
+      };
+
     public:
     
       /*! Constructor. */
@@ -44,6 +48,29 @@ namespace embree
       /*! refits the BVH */
       void refit();
 
+      /*! links all nodes and leaves to their parents, fails for BVHs with other than aligned nodes */
+      bool link(LeafLinkInterface& leafLink);
+
+      /*! drops all links, required whenever the BVH gets rebuilt or entirely refitted */
+      void unlink();
+
+      /*! returns true if the BVH is linked */
+      __forceinline bool linked() const { return isLinked; }
+
+      /*! refits only the linked leaves and their ancestors, returns false if the BVH degraded so much that it should get rebuilt */
+      bool refit(const std::vector<size_t>& leafIDs, LeafLinkInterface& leafLink);
+
+    private:
+      /* links a subtree in depth first order */
+      bool link_recursive(NodeRef ref, unsigned int parent, unsigned int slot, unsigned int depth,
+                          size_t& nodeID, size_t& leafID, LeafLinkInterface& leafLink);
+
+      /* restructures a degraded subtree using tree rotations */
+      void rotate(size_t nodeID, LeafLinkInterface& leafLink);
+
+      /* sum of the half areas of all children of a node */
+      static float cost(const AlignedNode* node);
+
     private:
       /* single-threaded subtree extraction based on BVH depth */
       void gather_subtree_refs(NodeRef& ref, 
@@ -67,10 +94,40 @@ namespace embree
       static const size_t MAX_NUM_SUB_TREES             = (N==4) ? 256 : (N==8) ? 512 : N*N*N; // N ^ MAX_SUB_TREE_EXTRACTION_DEPTH
       size_t numSubTrees;
       NodeRef subTrees[MAX_NUM_SUB_TREES];
+
+    private:
+      static const unsigned int invalidLink = -1;
+
+      struct NodeLink
+      {
+        AlignedNode* node;
+        unsigned int parent;    //!< parent node, invalidLink for the root
+        unsigned int slot;      //!< child slot inside the parent
+        unsigned int depth;     //!< depth of the node, the root has depth 0
+        unsigned int numNodes;  //!< number of nodes of the subtree, they are stored consecutively
+        unsigned int firstLeaf; //!< first leaf of the subtree, leaves of a subtree are stored consecutively
+        float cost;             //!< current sum of the child half areas
+        float linkCost;         //!< sum of the child half areas when the node got linked
+      };
+
+      struct LeafLink
+      {
+        NodeRef ref;
+        unsigned int parent;    //!< parent node, invalidLink for a root leaf
+        unsigned int slot;      //!< child slot inside the parent
+      };
+
+      bool isLinked;
+      std::vector<NodeLink> nodeLinks;
+      std::vector<LeafLink> leafLinks;
+      std::vector<unsigned int> nodeStamps; //!< marks nodes already scheduled for refit
+      unsigned int stamp;
+      double totalCost;                     //!< current sum of all node costs
+      double totalLinkCost;                 //!< sum of all node costs when the BVH got linked
     };
 
     template<int N, typename Mesh, typename Primitive>
-    class BVHNRefitT : public Builder, public BVHNRefitter<N>::LeafBoundsInterface
+    class BVHNRefitT : public Builder, public BVHNRefitter<N>::LeafBoundsInterface, public BVHNRefitter<N>::LeafLinkInterface
     {
     public:
       
@@ -96,13 +153,23 @@ namespace embree
             bounds.extend(((Primitive*)prim)[i].update(mesh));
         return bounds;
       }
-      
+
+      virtual void linkLeaf (NodeRef& ref, size_t leafID);
+
+    private:
+      /*! refits only the leaves of primitives with modified vertices, returns false if not possible */
+      bool refitModified();
+
     private:
       BVH* bvh;
       std::unique_ptr<Builder> builder;
       std::unique_ptr<BVHNRefitter<N>> refitter;
       Mesh* mesh;
       unsigned int topologyVersion;
+      unsigned int vertexModCounter;              //!< version of the vertex buffer the BVH got fitted to
+      std::vector<unsigned int> primLeaf;         //!< linked leaf of each primitive
+      std::vector<unsigned int> vertexPrimOffsets;
+      std::vector<unsigned int> vertexPrims;      //!< primitives using each vertex
     };
   }
 }
@@ -44,6 +44,7 @@ namespace embree
     if (stat.statAlignedNodesMB4D.numNodes) stream << "  alignedNodesMB4D : "  << stat.statAlignedNodesMB4D.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statUnalignedNodesMB.numNodes) stream << "  unalignedNodesMB : "  << stat.statUnalignedNodesMB.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (stat.statQuantizedNodes.numNodes  ) stream << "  quantizedNodes   : "  << stat.statQuantizedNodes.toString(bvh,totalSAH,totalBytes) << std::endl;
+    if (stat.statQuantizedNodesMB.numNodes) stream << "  quantizedNodesMB : "  << stat.statQuantizedNodesMB.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "  leaves           : "  << stat.statLeaf.toString(bvh,totalSAH,totalBytes) << std::endl;
     if (true)                               stream << "    histogram      : "  << stat.statLeaf.histToString() << std::endl;
     return stream.str();
@@ -141,6 +142,20 @@ namespace embree
       s.statQuantizedNodes.nodeSAH += dt*A;
       s.depth++;
     }
+    else if (node.isQuantizedNodeMB())
+    {
+      QuantizedNodeMB* n = node.quantizedNodeMB();
+      s = s + parallel_reduce(0,N,Statistics(),[&] ( const int i ) {
+          if (n->child(i) == BVH::emptyNode) return Statistics();
+          const double Ai = max(0.0f,halfArea(n->extent(i)));
+          Statistics s = statistics(n->child(i),Ai,t0t1);
+          s.statQuantizedNodesMB.numChildren++;
+          return s;
+        }, Statistics::add);
+      s.statQuantizedNodesMB.numNodes++;
+      s.statQuantizedNodesMB.nodeSAH += dt*A;
+      s.depth++;
+    }
     else if (node.isLeaf())
     {
       size_t num; const char* tri = node.leaf(num);
@@ -168,11 +183,15 @@ namespace embree
     return s;
   } 
 
-#if defined(__AVX__)
+#if defined(__AVX__) && (!defined(__AVX512VL__) || !defined(EMBREE_TARGET_AVX))
   template class BVHNStatistics<8>;
 #endif
 
-#if !defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)
+#if (!defined(__AVX__) || !defined(EMBREE_TARGET_SSE2) && !defined(EMBREE_TARGET_SSE42)) && (!defined(__AVX512VL__) || !defined(EMBREE_TARGET_AVX))
   template class BVHNStatistics<4>;
 #endif
+
+#if defined(__AVX512VL__)
+  template class BVHNStatistics<16>;
+#endif
 }
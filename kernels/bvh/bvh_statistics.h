@@ -31,6 +31,7 @@ namespace embree
     typedef typename BVH::AlignedNodeMB4D AlignedNodeMB4D;
     typedef typename BVH::UnalignedNodeMB UnalignedNodeMB;
     typedef typename BVH::QuantizedNode QuantizedNode;
+    typedef typename BVH::QuantizedNodeMB QuantizedNodeMB;
 
     typedef typename BVH::NodeRef NodeRef;
 
@@ -180,7 +181,8 @@ namespace embree
                   NodeStat<AlignedNodeMB> statAlignedNodesMB = NodeStat<AlignedNodeMB>(),
                   NodeStat<AlignedNodeMB4D> statAlignedNodesMB4D = NodeStat<AlignedNodeMB4D>(),
                   NodeStat<UnalignedNodeMB> statUnalignedNodesMB = NodeStat<UnalignedNodeMB>(),
-                  NodeStat<QuantizedNode> statQuantizedNodes = NodeStat<QuantizedNode>())
+                  NodeStat<QuantizedNode> statQuantizedNodes = NodeStat<QuantizedNode>(),
+                  NodeStat<QuantizedNodeMB> statQuantizedNodesMB = NodeStat<QuantizedNodeMB>())
 
       : depth(depth), 
         statLeaf(statLeaf),
@@ -189,7 +191,8 @@ namespace embree
         statAlignedNodesMB(statAlignedNodesMB),
         statAlignedNodesMB4D(statAlignedNodesMB4D),
         statUnalignedNodesMB(statUnalignedNodesMB),
-        statQuantizedNodes(statQuantizedNodes) {}
+        statQuantizedNodes(statQuantizedNodes),
+        statQuantizedNodesMB(statQuantizedNodesMB) {}
 
       double sah(BVH* bvh) const 
       {
@@ -199,7 +202,8 @@ namespace embree
           statAlignedNodesMB.sah(bvh) + 
           statAlignedNodesMB4D.sah(bvh) + 
           statUnalignedNodesMB.sah(bvh) + 
-          statQuantizedNodes.sah(bvh);
+          statQuantizedNodes.sah(bvh) + 
+          statQuantizedNodesMB.sah(bvh);
       }
       
       size_t bytes(BVH* bvh) const {
@@ -209,7 +213,8 @@ namespace embree
           statAlignedNodesMB.bytes() + 
           statAlignedNodesMB4D.bytes() + 
           statUnalignedNodesMB.bytes() + 
-          statQuantizedNodes.bytes();
+          statQuantizedNodes.bytes() + 
+          statQuantizedNodesMB.bytes();
       }
 
       size_t size() const 
@@ -220,7 +225,8 @@ namespace embree
           statAlignedNodesMB.size() + 
           statAlignedNodesMB4D.size() + 
           statUnalignedNodesMB.size() + 
-          statQuantizedNodes.size();
+          statQuantizedNodes.size() + 
+          statQuantizedNodesMB.size();
       }
 
       double fillRate (BVH* bvh) const 
@@ -231,14 +237,16 @@ namespace embree
           statAlignedNodesMB.fillRateNom() + 
           statAlignedNodesMB4D.fillRateNom() + 
           statUnalignedNodesMB.fillRateNom() + 
-          statQuantizedNodes.fillRateNom();
+          statQuantizedNodes.fillRateNom() + 
+          statQuantizedNodesMB.fillRateNom();
         double den = statLeaf.fillRateDen(bvh) +
           statAlignedNodes.fillRateDen() + 
           statUnalignedNodes.fillRateDen() + 
           statAlignedNodesMB.fillRateDen() + 
           statAlignedNodesMB4D.fillRateDen() + 
           statUnalignedNodesMB.fillRateDen() + 
-          statQuantizedNodes.fillRateDen();
+          statQuantizedNodes.fillRateDen() + 
+          statQuantizedNodesMB.fillRateDen();
         return nom/den;
       }
 
@@ -251,7 +259,8 @@ namespace embree
                           a.statAlignedNodesMB + b.statAlignedNodesMB,
                           a.statAlignedNodesMB4D + b.statAlignedNodesMB4D,
                           a.statUnalignedNodesMB + b.statUnalignedNodesMB,
-                          a.statQuantizedNodes + b.statQuantizedNodes);
+                          a.statQuantizedNodes + b.statQuantizedNodes,
+                          a.statQuantizedNodesMB + b.statQuantizedNodesMB);
       }
 
       static Statistics add ( const Statistics& a, const Statistics& b ) {
@@ -267,6 +276,7 @@ namespace embree
       NodeStat<AlignedNodeMB4D> statAlignedNodesMB4D;
       NodeStat<UnalignedNodeMB> statUnalignedNodesMB;
       NodeStat<QuantizedNode> statQuantizedNodes;
+      NodeStat<QuantizedNodeMB> statQuantizedNodesMB;
     };
 
   public:
@@ -285,6 +295,14 @@ namespace embree
       return stat.bytes(bvh);
     }
 
+    size_t numInnerNodes() const {
+      return stat.size()-stat.statLeaf.size();
+    }
+
+    size_t numLeaves() const {
+      return stat.statLeaf.size();
+    }
+
   private:
     Statistics statistics(NodeRef node, const double A, const BBox1f dt);
 
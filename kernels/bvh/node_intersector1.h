@@ -317,24 +317,38 @@ namespace embree
       return pointQuerySphereDistAndMask(query, dist, minX, maxX, minY, maxY, minZ, maxZ) & movemask(node->validMask());
     }
     
+    /* the node spaces only rotate and scale the axes, thus clamping to the
+     * box inside node space yields the closest point and scaling the
+     * offset back by the extents of the box yields its distance */
+    template<int N>
+    __forceinline vfloat<N> pointQueryUnalignedDist(const AffineSpace3vf<N>& space, const TravPointQuery<N>& query,
+                                                    const Vec3vf<N>& lower, const Vec3vf<N>& upper)
+    {
+      const Vec3vf<N> org = xfmPoint(space,query.org);
+      const vfloat<N> vX = org.x - min(max(org.x, lower.x), upper.x);
+      const vfloat<N> vY = org.y - min(max(org.y, lower.y), upper.y);
+      const vfloat<N> vZ = org.z - min(max(org.z, lower.z), upper.z);
+      const Vec3vf<N> rcpExtent2 = space.l.vx*space.l.vx + space.l.vy*space.l.vy + space.l.vz*space.l.vz;
+      return vX*vX/rcpExtent2.x + vY*vY/rcpExtent2.y + vZ*vZ/rcpExtent2.z;
+    }
+
     template<int N>
     __forceinline size_t pointQueryNodeSphere(const typename BVHN<N>::UnalignedNode* node, const TravPointQuery<N>& query, vfloat<N>& dist)
     {
-      // TODO: point query - implement
-      const vbool<N> vmask = vbool<N>(true);
-      const size_t mask = movemask(vmask) & ((1<<N)-1);
-      dist = vfloat<N>(0.0f);
-      return mask;
+      dist = pointQueryUnalignedDist<N>(node->naabb, query, Vec3vf<N>(zero), Vec3vf<N>(one));
+      const vbool<N> vmask = dist <= query.tfar()*query.tfar();
+      return movemask(vmask);
     }
     
     template<int N>
     __forceinline size_t pointQueryNodeSphere(const typename BVHN<N>::UnalignedNodeMB* node, const TravPointQuery<N>& query, const float time, vfloat<N>& dist)
     {
-      // TODO: point query - implement
-      const vbool<N> vmask = vbool<N>(true);
-      const size_t mask = movemask(vmask) & ((1<<N)-1);
-      dist = vfloat<N>(0.0f);
-      return mask;
+      const Vec3vf<N> lower = lerp(Vec3vf<N>(zero),node->b1.lower,vfloat<N>(time));
+      const Vec3vf<N> upper = lerp(Vec3vf<N>(one ),node->b1.upper,vfloat<N>(time));
+      dist = pointQueryUnalignedDist<N>(node->space0, query, lower, upper);
+      const vbool<N> vmask = dist <= query.tfar()*query.tfar();
+      const vbool<N> valid = node->b1.lower.x <= node->b1.upper.x;
+      return movemask(vmask & valid);
     }
 
     template<int N>
@@ -539,6 +553,27 @@ namespace embree
 
 #endif
 
+#if defined(__AVX512VL__) // SKX
+
+    template<>
+      __forceinline size_t intersectNode<16,16>(const typename BVH16::AlignedNode* node, const TravRay<16,16,false>& ray, vfloat16& dist)
+    {
+      const vfloat16 tNearX = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearX)), ray.rdir.x, ray.org_rdir.x);
+      const vfloat16 tNearY = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearY)), ray.rdir.y, ray.org_rdir.y);
+      const vfloat16 tNearZ = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.nearZ)), ray.rdir.z, ray.org_rdir.z);
+      const vfloat16 tFarX  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farX )), ray.rdir.x, ray.org_rdir.x);
+      const vfloat16 tFarY  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farY )), ray.rdir.y, ray.org_rdir.y);
+      const vfloat16 tFarZ  = msub(vfloat16::load((float*)((const char*)&node->lower_x+ray.farZ )), ray.rdir.z, ray.org_rdir.z);
+      const vfloat16 tNear = maxi(tNearX,tNearY,tNearZ,ray.tnear);
+      const vfloat16 tFar  = mini(tFarX ,tFarY ,tFarZ ,ray.tfar);
+      const vbool16 vmask = asInt(tNear) <= asInt(tFar);
+      const size_t mask = movemask(vmask);
+      dist = tNear;
+      return mask;
+    }
+
+#endif
+
 #if defined(__AVX512F__) && !defined(__AVX512VL__) // KNL
 
     template<>
@@ -1377,6 +1412,31 @@ namespace embree
       }
     };
 
+    template<int N>
+    struct BVHNNodePointQuerySphere1<N, BVH_QN2_AN4D>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        if (likely(node.isQuantizedNodeMB())) mask = pointQueryNodeSphere((const typename BVHN<N>::QuantizedBaseNodeMB*)node.quantizedNodeMB(), query, time, dist);
+        else                                  mask = pointQueryNodeSphereMB4D<N>(node, query, time, dist);
+        return true;
+      }
+    };
+
+    template<int N>
+    struct BVHNNodePointQuerySphere1<N, BVH_QN2_AN4D_UN2>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        if (likely(node.isQuantizedNodeMB()))        mask = pointQueryNodeSphere((const typename BVHN<N>::QuantizedBaseNodeMB*)node.quantizedNodeMB(), query, time, dist);
+        else if (unlikely(node.isUnalignedNodeMB())) mask = pointQueryNodeSphere(node.unalignedNodeMB(), query, time, dist);
+        else                                         mask = pointQueryNodeSphereMB4D(node, query, time, dist);
+        return true;
+      }
+    };
+
     template<int N>
     struct BVHNNodePointQuerySphere1<N, BVH_QN1>
     {
@@ -1475,6 +1535,31 @@ namespace embree
       }
     };
 
+    template<int N>
+    struct BVHNNodePointQueryAABB1<N, BVH_QN2_AN4D>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        if (likely(node.isQuantizedNodeMB())) mask = pointQueryNodeAABB((const typename BVHN<N>::QuantizedBaseNodeMB*)node.quantizedNodeMB(), query, time, dist);
+        else                                  mask = pointQueryNodeAABBMB4D<N>(node, query, time, dist);
+        return true;
+      }
+    };
+
+    template<int N>
+    struct BVHNNodePointQueryAABB1<N, BVH_QN2_AN4D_UN2>
+    {
+      static __forceinline bool pointQuery(const typename BVHN<N>::NodeRef& node, const TravPointQuery<N>& query, float time, vfloat<N>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        if (likely(node.isQuantizedNodeMB()))        mask = pointQueryNodeAABB((const typename BVHN<N>::QuantizedBaseNodeMB*)node.quantizedNodeMB(), query, time, dist);
+        else if (unlikely(node.isUnalignedNodeMB())) mask = pointQueryNodeAABB(node.unalignedNodeMB(), query, time, dist);
+        else                                         mask = pointQueryNodeAABBMB4D(node, query, time, dist);
+        return true;
+      }
+    };
+
     template<int N>
     struct BVHNNodePointQueryAABB1<N, BVH_QN1>
     {
@@ -1647,6 +1732,56 @@ namespace embree
       }
     };
 
+    template<int N, int Nx>
+    struct BVHNNodeIntersector1<N, Nx, BVH_QN2_AN4D, false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx,false>& ray, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        if (likely(node.isQuantizedNodeMB())) mask = intersectNode((const typename BVHN<N>::QuantizedBaseNodeMB*)node.quantizedNodeMB(), ray, time, dist);
+        else                                  mask = intersectNodeMB4D<N>(node, ray, time, dist);
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+    struct BVHNNodeIntersector1<N, Nx, BVH_QN2_AN4D, true>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx,true>& ray, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        if (likely(node.isQuantizedNodeMB())) mask = intersectNode((const typename BVHN<N>::QuantizedBaseNodeMB*)node.quantizedNodeMB(), ray, time, dist);
+        else                                  mask = intersectNodeMB4DRobust<N>(node, ray, time, dist);
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+    struct BVHNNodeIntersector1<N, Nx, BVH_QN2_AN4D_UN2, false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx,false>& ray, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        if (likely(node.isQuantizedNodeMB()))        mask = intersectNode((const typename BVHN<N>::QuantizedBaseNodeMB*)node.quantizedNodeMB(), ray, time, dist);
+        else if (unlikely(node.isUnalignedNodeMB())) mask = intersectNode(node.unalignedNodeMB(), ray, time, dist);
+        else                                         mask = intersectNodeMB4D(node, ray, time, dist);
+        return true;
+      }
+    };
+
+    template<int N, int Nx>
+    struct BVHNNodeIntersector1<N, Nx, BVH_QN2_AN4D_UN2, true>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, const TravRay<N,Nx,true>& ray, float time, vfloat<Nx>& dist, size_t& mask)
+      {
+        if (unlikely(node.isLeaf())) return false;
+        if (likely(node.isQuantizedNodeMB()))        mask = intersectNode((const typename BVHN<N>::QuantizedBaseNodeMB*)node.quantizedNodeMB(), ray, time, dist);
+        else if (unlikely(node.isUnalignedNodeMB())) mask = intersectNode(node.unalignedNodeMB(), ray, time, dist);
+        else                                         mask = intersectNodeMB4DRobust(node, ray, time, dist);
+        return true;
+      }
+    };
+
     template<int N, int Nx>
     struct BVHNNodeIntersector1<N, Nx, BVH_QN1, false>
     {
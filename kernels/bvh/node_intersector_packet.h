@@ -776,6 +776,73 @@ namespace embree
     };
 
 
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N, K, BVH_QN2_AN4D, false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, size_t i,
+                                          const TravRayKFast<K>& ray, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        if (likely(node.isQuantizedNodeMB())) {
+          vmask &= intersectQuantizedNodeMBK<N,K>(node.quantizedNodeMB(), i, ray, time, dist);
+        } else {
+          vmask &= intersectNodeKMB4D<N,K>(node, i, ray, time, dist);
+        }
+        return true;
+      }
+    };
+
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N, K, BVH_QN2_AN4D, true>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, size_t i,
+                                          const TravRayKRobust<K>& ray, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        if (likely(node.isQuantizedNodeMB())) {
+          vmask &= intersectQuantizedNodeMBK<N,K>(node.quantizedNodeMB(), i, ray, time, dist);
+        } else {
+          vmask &= intersectNodeKMB4DRobust<N,K>(node, i, ray, time, dist);
+        }
+        return true;
+      }
+    };
+
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N, K, BVH_QN2_AN4D_UN2, false>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, size_t i,
+                                          const TravRayKFast<K>& ray, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        if (likely(node.isQuantizedNodeMB())) {
+          vmask &= intersectQuantizedNodeMBK<N,K>(node.quantizedNodeMB(), i, ray, time, dist);
+        } else if (likely(node.isAlignedNodeMB4D())) {
+          vmask &= intersectNodeKMB4D<N,K>(node, i, ray, time, dist);
+        } else /*if (unlikely(node.isUnalignedNodeMB()))*/ {
+          assert(node.isUnalignedNodeMB());
+          vmask &= intersectNodeK<N,K>(node.unalignedNodeMB(), i, ray, time, dist);
+        }
+        return true;
+      }
+    };
+
+    template<int N, int K>
+    struct BVHNNodeIntersectorK<N, K, BVH_QN2_AN4D_UN2, true>
+    {
+      static __forceinline bool intersect(const typename BVHN<N>::NodeRef& node, size_t i,
+                                          const TravRayKRobust<K>& ray, const vfloat<K>& time, vfloat<K>& dist, vbool<K>& vmask)
+      {
+        if (likely(node.isQuantizedNodeMB())) {
+          vmask &= intersectQuantizedNodeMBK<N,K>(node.quantizedNodeMB(), i, ray, time, dist);
+        } else if (likely(node.isAlignedNodeMB4D())) {
+          vmask &= intersectNodeKMB4DRobust<N,K>(node, i, ray, time, dist);
+        } else /*if (unlikely(node.isUnalignedNodeMB()))*/ {
+          assert(node.isUnalignedNodeMB());
+          vmask &= intersectNodeK<N,K>(node.unalignedNodeMB(), i, ray, time, dist);
+        }
+        return true;
+      }
+    };
+
+
     /*! Intersects N nodes with K rays */
     template<int N, int K, bool robust>
     struct BVHNQuantizedBaseNodeIntersectorK;
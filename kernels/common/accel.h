@@ -42,6 +42,12 @@ namespace embree
     /*! clears the acceleration structure data */
     virtual void clear() = 0;
 
+    /*! called after each build to replicate frequently accessed data per NUMA node */
+    virtual void replicate() {};
+
+    /*! makes some geometry unreachable for rays without rebuilding, while rays may traverse the structure */
+    virtual void hideGeometry(size_t geomID) {};
+
     /*! returns normal bounds */
     __forceinline BBox3fa getBounds() const {
       return bounds.bounds();
@@ -78,11 +84,25 @@ namespace embree
     /*! Type of collide function */
     typedef void (*CollideFunc)(void* bvh0, void* bvh1, RTCCollideFunc callback, void* userPtr);
 
+    /*! Type of continuous collide function */
+    typedef void (*ContinuousCollideFunc)(void* bvh0, void* bvh1, float time0, float time1, RTCContinuousCollideFunc callback, void* userPtr);
+
     /*! Type of point query function */
     typedef bool(*PointQueryFunc)(Intersectors* This,          /*!< this pointer to accel */
                                   PointQuery* query,        /*!< point query for lookup */
                                   PointQueryContext* context); /*!< point query context */
 
+    /*! Type of point query function for packets, returns the mask of queries whose radius changed */
+    typedef size_t(*PointQueryPacketFunc)(Intersectors* This,           /*!< this pointer to accel */
+                                          size_t valid,                /*!< mask of active queries */
+                                          PointQuery** query,          /*!< point queries for lookup */
+                                          PointQueryContext** context); /*!< point query contexts */
+
+    /*! Type of k-nearest neighbor point query function */
+    typedef void (*KNNQueryFunc)(Intersectors* This,  /*!< this pointer to accel */
+                                 PointQuery* query,   /*!< point query for lookup */
+                                 KNNHeap* heap);      /*!< nearest neighbors found so far */
+
     /*! Type of intersect function pointer for single rays. */
     typedef void (*IntersectFunc)(Intersectors* This,  /*!< this pointer to accel */
                                   RTCRayHit& ray,      /*!< ray to intersect */
@@ -157,17 +177,50 @@ namespace embree
       CollideFunc collide;  
       const char* name;
     };
+
+    struct ContinuousCollider
+    {
+      ContinuousCollider (ErrorFunc error = nullptr) 
+      : collide((ContinuousCollideFunc)error), name(nullptr) {}
+
+      ContinuousCollider (ContinuousCollideFunc collide, const char* name)
+      : collide(collide), name(name) {}
+
+      operator bool() const { return name; }
+
+    public:
+      ContinuousCollideFunc collide;  
+      const char* name;
+    };
+
+    struct KNNQuery
+    {
+      KNNQuery (ErrorFunc error = nullptr) 
+      : query((KNNQueryFunc)error), name(nullptr) {}
+
+      KNNQuery (KNNQueryFunc query, const char* name)
+      : query(query), name(name) {}
+
+      operator bool() const { return name; }
+
+    public:
+      KNNQueryFunc query;  
+      const char* name;
+    };
     
     struct Intersector1
     {
       Intersector1 (ErrorFunc error = nullptr)
-      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), name(nullptr) {}
+      : intersect((IntersectFunc)error), occluded((OccludedFunc)error), pointQueryPacket(nullptr), name(nullptr) {}
       
       Intersector1 (IntersectFunc intersect, OccludedFunc occluded, const char* name)
-      : intersect(intersect), occluded(occluded), pointQuery(nullptr), name(name) {}
+      : intersect(intersect), occluded(occluded), pointQuery(nullptr), pointQueryPacket(nullptr), name(name) {}
       
       Intersector1 (IntersectFunc intersect, OccludedFunc occluded, PointQueryFunc pointQuery, const char* name)
-      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), name(name) {}
+      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), pointQueryPacket(nullptr), name(name) {}
+
+      Intersector1 (IntersectFunc intersect, OccludedFunc occluded, PointQueryFunc pointQuery, PointQueryPacketFunc pointQueryPacket, const char* name)
+      : intersect(intersect), occluded(occluded), pointQuery(pointQuery), pointQueryPacket(pointQueryPacket), name(name) {}
 
       operator bool() const { return name; }
 
@@ -176,6 +229,7 @@ namespace embree
       IntersectFunc intersect;
       OccludedFunc occluded;
       PointQueryFunc pointQuery;
+      PointQueryPacketFunc pointQueryPacket;
       const char* name;
     };
     
@@ -250,10 +304,10 @@ namespace embree
     struct Intersectors 
     {
       Intersectors() 
-      : ptr(nullptr), leafIntersector(nullptr), collider(nullptr), intersector1(nullptr), intersector4(nullptr), intersector8(nullptr), intersector16(nullptr), intersectorN(nullptr) {}
+      : ptr(nullptr), leafIntersector(nullptr), collider(nullptr), continuousCollider(nullptr), knn(nullptr), intersector1(nullptr), intersector4(nullptr), intersector8(nullptr), intersector16(nullptr), intersectorN(nullptr) {}
 
       Intersectors (ErrorFunc error) 
-      : ptr(nullptr), leafIntersector(nullptr), collider(error), intersector1(error), intersector4(error), intersector8(error), intersector16(error), intersectorN(error) {}
+      : ptr(nullptr), leafIntersector(nullptr), collider(error), continuousCollider(error), knn(error), intersector1(error), intersector4(error), intersector8(error), intersector16(error), intersectorN(error) {}
 
       void print(size_t ident) 
       {
@@ -261,6 +315,14 @@ namespace embree
           for (size_t i=0; i<ident; i++) std::cout << " ";
           std::cout << "collider  = " << collider.name << std::endl;
         }
+        if (continuousCollider.name) {
+          for (size_t i=0; i<ident; i++) std::cout << " ";
+          std::cout << "continuousCollider  = " << continuousCollider.name << std::endl;
+        }
+        if (knn.name) {
+          for (size_t i=0; i<ident; i++) std::cout << " ";
+          std::cout << "knn  = " << knn.name << std::endl;
+        }
         if (intersector1.name) {
           for (size_t i=0; i<ident; i++) std::cout << " ";
           std::cout << "intersector1  = " << intersector1.name << std::endl;
@@ -308,12 +370,40 @@ namespace embree
         return intersector1.pointQuery(this,query,context);
       }
 
+      /*! performs a packet of point queries, the queries get processed one by one if no packet traversal is available */
+      __forceinline size_t pointQueryPacket (size_t valid, PointQuery** query, PointQueryContext** context)
+      {
+        assert(intersector1.pointQuery);
+        if (intersector1.pointQueryPacket)
+          return intersector1.pointQueryPacket(this,valid,query,context);
+
+        size_t changed = 0;
+        for (size_t m=valid; m; ) {
+          const size_t k = bscf(m);
+          if (intersector1.pointQuery(this,query[k],context[k]))
+            changed |= size_t(1) << k;
+        }
+        return changed;
+      }
+
+      /*! finds the nearest neighbors of a point query */
+      __forceinline void knnQuery (PointQuery* query, KNNHeap* heap) {
+        assert(knn.query);
+        knn.query(this,query,heap);
+      }
+
       /*! collides two scenes */
       __forceinline void collide (Accel* scene0, Accel* scene1, RTCCollideFunc callback, void* userPtr) {
         assert(collider.collide);
         collider.collide(scene0->intersectors.ptr,scene1->intersectors.ptr,callback,userPtr);
       }
 
+      /*! collides two scenes continuously over a time interval */
+      __forceinline void collideContinuous (Accel* scene0, Accel* scene1, float time0, float time1, RTCContinuousCollideFunc callback, void* userPtr) {
+        assert(continuousCollider.collide);
+        continuousCollider.collide(scene0->intersectors.ptr,scene1->intersectors.ptr,time0,time1,callback,userPtr);
+      }
+
       /*! Intersects a single ray with the scene. */
       __forceinline void intersect (RTCRayHit& ray, IntersectContext* context) {
         assert(intersector1.intersect);
@@ -447,6 +537,8 @@ namespace embree
       AccelData* ptr;
       void* leafIntersector;
       Collider collider;
+      ContinuousCollider continuousCollider;
+      KNNQuery knn;
       Intersector1 intersector1;
       Intersector4 intersector4;
       Intersector4 intersector4_filter;
@@ -491,11 +583,24 @@ namespace embree
                            TOSTRING(isa) "::" TOSTRING(symbol));        \
   }
 
+#define DEFINE_CONTINUOUS_COLLIDER(symbol,collider)                     \
+  Accel::ContinuousCollider symbol() {                                  \
+    return Accel::ContinuousCollider((Accel::ContinuousCollideFunc)collider::collide, \
+                                     TOSTRING(isa) "::" TOSTRING(symbol)); \
+  }
+
+#define DEFINE_KNN_QUERY(symbol,knn)                                    \
+  Accel::KNNQuery symbol() {                                            \
+    return Accel::KNNQuery((Accel::KNNQueryFunc)knn::query,             \
+                           TOSTRING(isa) "::" TOSTRING(symbol));        \
+  }
+
 #define DEFINE_INTERSECTOR1(symbol,intersector)                               \
   Accel::Intersector1 symbol() {                                              \
     return Accel::Intersector1((Accel::IntersectFunc )intersector::intersect, \
                                (Accel::OccludedFunc  )intersector::occluded,  \
                                (Accel::PointQueryFunc)intersector::pointQuery,\
+                               (Accel::PointQueryPacketFunc)intersector::pointQueryPacket,\
                                TOSTRING(isa) "::" TOSTRING(symbol));          \
   }
   
@@ -33,7 +33,10 @@ namespace embree
 
   public:
     void build () {
-      if (builder) builder->build();
+      if (builder) {
+        builder->build();
+        accel->replicate();
+      }
       bounds = accel->bounds;
     }
 
@@ -41,6 +44,11 @@ namespace embree
       if (accel  ) accel->deleteGeometry(geomID);
       if (builder) builder->deleteGeometry(geomID);
     }
+
+    void hideGeometry(size_t geomID) {
+      if (accel  ) accel->hideGeometry(geomID);
+      if (builder) builder->hideGeometry(geomID);
+    }
     
     void clear() {
       if (accel) accel->clear();
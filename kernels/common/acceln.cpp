@@ -54,6 +54,24 @@ namespace embree
     return changed;
   }
 
+  size_t AccelN::pointQueryPacket (Accel::Intersectors* This_in, size_t valid, PointQuery** query, PointQueryContext** context)
+  {
+    size_t changed = 0;
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (!This->accels[i]->isEmpty())
+        changed |= This->accels[i]->intersectors.pointQueryPacket(valid,query,context);
+    return changed;
+  }
+
+  void AccelN::knnQuery (Accel::Intersectors* This_in, PointQuery* query, KNNHeap* heap)
+  {
+    AccelN* This = (AccelN*)This_in->ptr;
+    for (size_t i=0; i<This->accels.size(); i++)
+      if (!This->accels[i]->isEmpty() && This->accels[i]->intersectors.knn)
+        This->accels[i]->intersectors.knnQuery(query,heap);
+  }
+
   void AccelN::intersect (Accel::Intersectors* This_in, RTCRayHit& ray, IntersectContext* context) 
   {
     AccelN* This = (AccelN*)This_in->ptr;
@@ -210,7 +228,8 @@ namespace embree
     {
       type = AccelData::TY_ACCELN;
       intersectors.ptr = this;
-      intersectors.intersector1  = Intersector1(&intersect,&occluded,&pointQuery,valid1 ? "AccelN::intersector1": nullptr);
+      intersectors.knn           = KNNQuery(&knnQuery,"AccelN::knnQuery");
+      intersectors.intersector1  = Intersector1(&intersect,&occluded,&pointQuery,&pointQueryPacket,valid1 ? "AccelN::intersector1": nullptr);
       intersectors.intersector4  = Intersector4(&intersect4,&occluded4,valid4 ? "AccelN::intersector4" : nullptr);
       intersectors.intersector8  = Intersector8(&intersect8,&occluded8,valid8 ? "AccelN::intersector8" : nullptr);
       intersectors.intersector16 = Intersector16(&intersect16,&occluded16,valid16 ? "AccelN::intersector16": nullptr);
@@ -235,6 +254,12 @@ namespace embree
       accels[i]->deleteGeometry(geomID);
   }
 
+  void AccelN::hideGeometry(size_t geomID)
+  {
+    for (size_t i=0; i<accels.size(); i++)
+      accels[i]->hideGeometry(geomID);
+  }
+
   void AccelN::accels_clear()
   {
     for (size_t i=0; i<accels.size(); i++) {
@@ -31,8 +31,15 @@ namespace embree
     void accels_add(Accel* accel);
     void accels_init();
 
+  public:
+    void build () { accels_build(); }
+    void clear () { accels_clear(); }
+    void hideGeometry (size_t geomID);
+
   public:
     static bool pointQuery (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
+    static size_t pointQueryPacket (Accel::Intersectors* This, size_t valid, PointQuery** query, PointQueryContext** context);
+    static void knnQuery (Accel::Intersectors* This, PointQuery* query, KNNHeap* heap);
 
   public:
     static void intersect (Accel::Intersectors* This, RTCRayHit& ray, IntersectContext* context);
@@ -183,8 +183,17 @@ namespace embree
     FastAllocator (Device* device, bool osAllocation) 
       : device(device), slotMask(0), usedBlocks(nullptr), freeBlocks(nullptr), use_single_mode(false), defaultBlockSize(PAGE_SIZE), estimatedSize(0),
         growSize(PAGE_SIZE), maxGrowSize(maxAllocationSize), log2_grow_size_scale(0), bytesUsed(0), bytesFree(0), bytesWasted(0), atype(osAllocation ? OS_MALLOC : ALIGNED_MALLOC),
-        primrefarray(device,0)
+        numaNodes(0), numaSlotsPerNode(0), primrefarray(device,0)
     {
+      /* in NUMA mode the block slots get distributed over the NUMA nodes */
+      if (device && device->numa && getNumberOfNumaNodes() > 1)
+      {
+        numaNodes = min(size_t(getNumberOfNumaNodes()),MAX_THREAD_USED_BLOCK_SLOTS);
+        numaSlotsPerNode = 1;
+        while (2*numaSlotsPerNode*numaNodes <= MAX_THREAD_USED_BLOCK_SLOTS)
+          numaSlotsPerNode *= 2;
+      }
+
       for (size_t i=0; i<MAX_THREAD_USED_BLOCK_SLOTS; i++)
       {
         threadUsedBlocks[i] = nullptr;
@@ -486,6 +495,18 @@ namespace embree
       return size_t(1) << min(size_t(16),scale);
     }
 
+    /*! returns the NUMA node new blocks of the calling thread get bound to, -1 if NUMA mode is disabled */
+    __forceinline int getNumaNode() const {
+      return numaNodes ? (int) getThreadNumaNode() : -1;
+    }
+
+    /*! returns the block slot of some thread, in NUMA mode threads only share slots with threads of the same node */
+    __forceinline size_t getSlot(size_t threadID, int numaNode) const
+    {
+      if (numaNode < 0) return threadID & slotMask;
+      return (size_t(numaNode) % numaNodes)*numaSlotsPerNode + (threadID & slotMask & (numaSlotsPerNode-1));
+    }
+
     /*! thread safe allocation of memory */
     void* malloc(size_t& bytes, size_t align, bool partial)
     {
@@ -495,7 +516,8 @@ namespace embree
       {
         /* allocate using current block */
         size_t threadID = TaskScheduler::threadID();
-        size_t slot = threadID & slotMask;
+        const int numaNode = getNumaNode();
+        size_t slot = getSlot(threadID,numaNode);
 	Block* myUsedBlocks = threadUsedBlocks[slot];
         if (myUsedBlocks) {
           void* ptr = myUsedBlocks->malloc(device,bytes,align,partial);
@@ -514,7 +536,7 @@ namespace embree
             const size_t alignedBytes = (bytes+(align-1)) & ~(align-1);
             const size_t allocSize = max(min(growSize,maxGrowSize),alignedBytes);
             assert(allocSize >= bytes);
-            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,threadBlocks[slot],atype); // FIXME: a large allocation might throw away a block here!
+            threadBlocks[slot] = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,threadBlocks[slot],atype,numaNode); // FIXME: a large allocation might throw away a block here!
             // FIXME: a direct allocation should allocate inside the block here, and not in the next loop! a different thread could do some allocation and make the large allocation fail.
           }
           continue;
@@ -525,16 +547,25 @@ namespace embree
           Lock<SpinLock> lock(mutex);
 	  if (myUsedBlocks == threadUsedBlocks[slot])
 	  {
-            if (freeBlocks.load() != nullptr) {
-	      Block* nextFreeBlock = freeBlocks.load()->next;
-	      freeBlocks.load()->next = usedBlocks;
+            Block* freeBlock = freeBlocks.load();
+            Block* freeBlockPrev = nullptr;
+            if (numaNode >= 0) {
+              /* in NUMA mode we only reuse blocks of the same node or blocks not bound to any node */
+              for (; freeBlock && freeBlock->numaNode >= 0 && freeBlock->numaNode != numaNode; freeBlock = freeBlock->next)
+                freeBlockPrev = freeBlock;
+            }
+
+            if (freeBlock != nullptr) {
+	      Block* nextFreeBlock = freeBlock->next;
+	      freeBlock->next = usedBlocks;
 	      __memory_barrier();
-	      usedBlocks = freeBlocks.load();
-              threadUsedBlocks[slot] = freeBlocks.load();
-	      freeBlocks = nextFreeBlock;
+	      usedBlocks = freeBlock;
+              threadUsedBlocks[slot] = freeBlock;
+              if (freeBlockPrev) freeBlockPrev->next = nextFreeBlock;
+              else               freeBlocks = nextFreeBlock;
 	    } else {
               const size_t allocSize = min(growSize*incGrowSizeScale(),maxGrowSize);
-	      usedBlocks = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,usedBlocks,atype); // FIXME: a large allocation should get delivered directly, like above!
+	      usedBlocks = threadUsedBlocks[slot] = Block::create(device,allocSize,allocSize,usedBlocks,atype,numaNode); // FIXME: a large allocation should get delivered directly, like above!
 	    }
           }
         }
@@ -719,7 +750,7 @@ namespace embree
 
     struct Block
     {
-      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype)
+      static Block* create(MemoryMonitorInterface* device, size_t bytesAllocate, size_t bytesReserve, Block* next, AllocationType atype, int numaNode = -1)
       {
         /* We avoid using os_malloc for small blocks as this could
          * cause a risk of fragmenting the virtual address space and
@@ -748,6 +779,7 @@ namespace embree
             const size_t alignment = maxAlignment;
             if (device) device->memoryMonitor(bytesAllocate+alignment,false);
             ptr = alignedMalloc(bytesAllocate,alignment);
+            if (numaNode >= 0) os_bind_numa(ptr,bytesAllocate,numaNode);
 
             /* give hint to transparently convert these pages to 2MB pages */
             const size_t ptr_aligned_begin = ((size_t)ptr) & ~size_t(PAGE_SIZE_2M-1);
@@ -755,21 +787,23 @@ namespace embree
             os_advise((void*)(ptr_aligned_begin + 1*PAGE_SIZE_2M),PAGE_SIZE_2M);
             os_advise((void*)(ptr_aligned_begin + 2*PAGE_SIZE_2M),PAGE_SIZE_2M); // may fail if no memory mapped after block
 
-            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
+            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment,false,numaNode);
           }
           else
           {
             const size_t alignment = maxAlignment;
             if (device) device->memoryMonitor(bytesAllocate+alignment,false);
             ptr = alignedMalloc(bytesAllocate,alignment);
-            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment);
+            if (numaNode >= 0) os_bind_numa(ptr,bytesAllocate,numaNode);
+            return new (ptr) Block(ALIGNED_MALLOC,bytesAllocate-sizeof_Header,bytesAllocate-sizeof_Header,next,alignment,false,numaNode);
           }
         }
         else if (atype == OS_MALLOC)
         {
           if (device) device->memoryMonitor(bytesAllocate,false);
           bool huge_pages; ptr = os_malloc(bytesReserve,huge_pages);
-          return new (ptr) Block(OS_MALLOC,bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,0,huge_pages);
+          if (numaNode >= 0) os_bind_numa(ptr,bytesReserve,numaNode);
+          return new (ptr) Block(OS_MALLOC,bytesAllocate-sizeof_Header,bytesReserve-sizeof_Header,next,0,huge_pages,numaNode);
         }
         else
           assert(false);
@@ -777,8 +811,8 @@ namespace embree
         return NULL;
       }
 
-      Block (AllocationType atype, size_t bytesAllocate, size_t bytesReserve, Block* next, size_t wasted, bool huge_pages = false)
-      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), atype(atype), huge_pages(huge_pages)
+      Block (AllocationType atype, size_t bytesAllocate, size_t bytesReserve, Block* next, size_t wasted, bool huge_pages = false, int numaNode = -1)
+      : cur(0), allocEnd(bytesAllocate), reserveEnd(bytesReserve), next(next), wasted(wasted), atype(atype), numaNode(numaNode), huge_pages(huge_pages)
       {
         assert((((size_t)&data[0]) & (maxAlignment-1)) == 0);
       }
@@ -939,8 +973,9 @@ namespace embree
       Block* next;               //!< pointer to next block in list
       size_t wasted;             //!< amount of memory wasted through block alignment
       AllocationType atype;      //!< allocation mode of the block
+      int numaNode;              //!< NUMA node the block is bound to, -1 if not bound
       bool huge_pages;           //!< whether the block uses huge pages
-      char align[maxAlignment-5*sizeof(size_t)-sizeof(AllocationType)-sizeof(bool)]; //!< align data to maxAlignment
+      char align[maxAlignment-5*sizeof(size_t)-sizeof(AllocationType)-sizeof(int)-sizeof(bool)]; //!< align data to maxAlignment
       char data[1];              //!< here starts memory to use for allocations
     };
 
@@ -970,6 +1005,8 @@ namespace embree
     SpinLock thread_local_allocators_lock;
     std::vector<ThreadLocal2*> thread_local_allocators;
     AllocationType atype;
+    size_t numaNodes;                  //!< number of NUMA nodes the block slots are distributed over, zero if NUMA mode is disabled
+    size_t numaSlotsPerNode;           //!< number of block slots per NUMA node
     mvector<PrimRef> primrefarray;     //!< primrefarray used to allocate nodes
   };
 }
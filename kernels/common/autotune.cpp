@@ -0,0 +1,197 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "scene.h"
+#include "context.h"
+#include "../../common/algorithms/parallel_for.h"
+
+namespace embree
+{
+  /*! small LCG to sample a reproducible ray workload */
+  struct AutotuneRandom
+  {
+    __forceinline AutotuneRandom (unsigned int seed) : state(seed*0x9E3779B9u + 0x6C078965u) {}
+
+    __forceinline float operator() ()
+    {
+      state = 1664525u*state + 1013904223u;
+      return float(state >> 8) * (1.0f/16777216.0f);
+    }
+
+    unsigned int state;
+  };
+
+  /*! one dimension of the autotuner search space */
+  struct AutotuneParameter
+  {
+    const char* name;
+    size_t numValues;
+    float values[6];
+    void (*set)(RTCBuildArguments& args, float value);
+  };
+
+  static const AutotuneParameter autotuneParameters[] =
+  {
+    { "maxBranchingFactor", 3, { 2, 4, 8 },            [] (RTCBuildArguments& args, float v) { args.maxBranchingFactor = (unsigned int) v; } },
+    { "maxLeafSize",        6, { 1, 2, 4, 8, 16, 32 }, [] (RTCBuildArguments& args, float v) { args.maxLeafSize = (unsigned int) v; } },
+    { "minLeafSize",        4, { 1, 2, 4, 8 },         [] (RTCBuildArguments& args, float v) { args.minLeafSize = (unsigned int) v; } },
+    { "sahBlockSize",       4, { 1, 2, 4, 8 },         [] (RTCBuildArguments& args, float v) { args.sahBlockSize = (unsigned int) v; } },
+    { "traversalCost",      4, { 0.5f, 1, 2, 4 },      [] (RTCBuildArguments& args, float v) { args.traversalCost = v; } },
+    { "intersectionCost",   4, { 0.5f, 1, 2, 4 },      [] (RTCBuildArguments& args, float v) { args.intersectionCost = v; } },
+  };
+
+  /*! ray workload used to measure the trace cost of the scene */
+  struct AutotuneWorkload
+  {
+    AutotuneWorkload (Scene* scene, const RTCAutotuneArguments& args)
+      : scene(scene), numRepetitions(args.numRepetitions), rays(args.numRays), traced(args.numRays)
+    {
+      if (args.rays)
+      {
+        for (size_t i=0; i<rays.size(); i++)
+          rays[i] = args.rays[i];
+        return;
+      }
+
+      /* sample incoherent rays inside the scene bounds */
+      const BBox3fa bounds = scene->bounds.bounds();
+      AutotuneRandom random(args.seed);
+      for (size_t i=0; i<rays.size(); i++)
+      {
+        const Vec3fa org = bounds.lower + Vec3fa(random(),random(),random())*bounds.size();
+        const float z = 2.0f*random()-1.0f;
+        const float r = sqrt(max(0.0f,1.0f-z*z));
+        const float phi = float(two_pi)*random();
+        const Vec3fa dir(r*cos(phi),r*sin(phi),z);
+
+        RTCRayHit& ray = rays[i];
+        ray.ray.org_x = org.x; ray.ray.org_y = org.y; ray.ray.org_z = org.z;
+        ray.ray.dir_x = dir.x; ray.ray.dir_y = dir.y; ray.ray.dir_z = dir.z;
+        ray.ray.tnear = 0.0f;
+        ray.ray.tfar = float(inf);
+        ray.ray.time = random();
+        ray.ray.mask = -1;
+        ray.ray.id = (unsigned int) i;
+        ray.ray.flags = 0;
+        ray.hit.geomID = RTC_INVALID_GEOMETRY_ID;
+        ray.hit.instID[0] = RTC_INVALID_GEOMETRY_ID;
+      }
+    }
+
+    /*! returns the fastest of all repetitions in seconds */
+    double measure()
+    {
+      RTCIntersectContext user_context;
+      rtcInitIntersectContext(&user_context);
+
+      double best = inf;
+      for (size_t r=0; r<numRepetitions; r++)
+      {
+        for (size_t i=0; i<rays.size(); i++)
+          traced[i] = rays[i];
+
+        const double t0 = getSeconds();
+        parallel_for(size_t(0), traced.size(), size_t(256), [&] (const range<size_t>& range) {
+            IntersectContext context(scene,&user_context);
+            for (size_t i=range.begin(); i<range.end(); i++)
+              scene->intersectors.intersect(traced[i],&context);
+          });
+        const double t1 = getSeconds();
+        best = min(best,t1-t0);
+      }
+      return best;
+    }
+
+    Scene* scene;
+    size_t numRepetitions;
+    avector<RTCRayHit> rays;
+    avector<RTCRayHit> traced;
+  };
+
+  void Scene::autotune(const RTCAutotuneArguments& args)
+  {
+    /* build with the current settings to get valid scene bounds */
+    commit(false);
+    if (numPrimitives() == 0)
+      return;
+
+    AutotuneWorkload workload(this,args);
+
+    auto rebuild = [&] (const RTCBuildArguments& candidate)
+    {
+      setBuildArguments(candidate);
+      commit(false);
+    };
+
+    auto evaluate = [&] (const RTCBuildArguments& candidate) -> double
+    {
+      rebuild(candidate);
+      return workload.measure();
+    };
+
+    /* the builder defaults are the baseline */
+    RTCBuildArguments defaultArgs = rtcDefaultBuildArguments();
+    defaultArgs.byteSize = 0;
+    RTCBuildArguments bestArgs = defaultArgs;
+    double bestCost = evaluate(defaultArgs);
+    if (device->verbosity(1))
+      std::cout << "autotune: builder defaults " << 1E9*bestCost/workload.rays.size() << " ns/ray" << std::endl;
+
+    /* coordinate descent starts from explicit settings close to the builder defaults */
+    RTCBuildArguments current = rtcDefaultBuildArguments();
+    current.maxBranchingFactor = 8;
+    current.sahBlockSize = 4;
+    current.minLeafSize = 1;
+    current.maxLeafSize = RTC_BUILD_MAX_PRIMITIVES_PER_LEAF;
+    double currentCost = inf;
+
+    for (size_t pass=0; pass<max(args.numPasses,1u); pass++)
+    {
+      for (const AutotuneParameter& param : autotuneParameters)
+      {
+        RTCBuildArguments bestValue = current;
+        for (size_t i=0; i<param.numValues; i++)
+        {
+          RTCBuildArguments candidate = current;
+          param.set(candidate,param.values[i]);
+          if (currentCost != double(inf) && memcmp(&candidate,&current,sizeof(RTCBuildArguments)) == 0)
+            continue;
+
+          const double cost = evaluate(candidate);
+          if (device->verbosity(1))
+            std::cout << "autotune: " << param.name << " = " << param.values[i] << " : " << 1E9*cost/workload.rays.size() << " ns/ray" << std::endl;
+
+          if (cost < currentCost) {
+            currentCost = cost;
+            bestValue = candidate;
+          }
+        }
+        current = bestValue;
+      }
+    }
+
+    if (currentCost < bestCost) {
+      bestCost = currentCost;
+      bestArgs = current;
+    }
+
+    if (device->verbosity(1))
+      std::cout << "autotune: selected " << (bestArgs.byteSize ? "tuned settings " : "builder defaults ") << 1E9*bestCost/workload.rays.size() << " ns/ray" << std::endl;
+
+    /* rebuild with the best settings, they stay active for all future commits */
+    rebuild(bestArgs);
+  }
+}
@@ -145,7 +145,7 @@ namespace embree
   public:
     /*! Buffer construction */
     RawBufferView()
-      : ptr_ofs(nullptr), stride(0), num(0), format(RTC_FORMAT_UNDEFINED), modCounter(1), modified(true), userData(0) {}
+      : ptr_ofs(nullptr), stride(0), num(0), format(RTC_FORMAT_UNDEFINED), modCounter(1), modified(true), userData(0), fullModCounter(1) {}
 
   public:
     /*! sets the buffer view */
@@ -160,6 +160,8 @@ namespace embree
       format = format_in;
       modCounter++;
       modified = true;
+      fullModCounter = modCounter;
+      modifiedRanges.clear();
       buffer = buffer_in;
     }
 
@@ -201,6 +203,37 @@ namespace embree
     __forceinline void setModified() {
       modCounter++;
       modified = true;
+      fullModCounter = modCounter;
+      modifiedRanges.clear();
+    }
+
+    /*! marks the items in [begin,end) as modified */
+    void setModified(size_t begin, size_t end)
+    {
+      if (begin > end || end > num)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "buffer range out of bounds");
+
+      /* too many small updates are tracked as a full update */
+      if (modifiedRanges.size() >= maxModifiedRanges) {
+        setModified();
+        return;
+      }
+
+      modCounter++;
+      modified = true;
+      modifiedRanges.push_back(ModifiedRange(modCounter,range<size_t>(begin,end)));
+    }
+
+    /*! returns the item ranges modified after otherModCounter, returns false if the entire buffer may have changed */
+    bool getModifiedRanges(unsigned int otherModCounter, std::vector<range<size_t>>& ranges) const
+    {
+      if (otherModCounter < fullModCounter)
+        return false;
+
+      for (const ModifiedRange& r : modifiedRanges)
+        if (r.first > otherModCounter)
+          ranges.push_back(r.second);
+      return true;
     }
 
     /*! mark buffer as modified or unmodified */
@@ -239,6 +272,12 @@ namespace embree
     bool modified;      //!< local modified data
     int userData;       //!< special data
     Ref<Buffer> buffer; //!< reference to the parent buffer
+
+  private:
+    typedef std::pair<unsigned int,range<size_t>> ModifiedRange;
+    static const size_t maxModifiedRanges = 1024;
+    unsigned int fullModCounter;                //!< version ID of the last update of the entire buffer
+    std::vector<ModifiedRange> modifiedRanges;  //!< item ranges modified after the last full update
   };
 
   /*! A typed contiguous range of a buffer. This class does not own the buffer content. */
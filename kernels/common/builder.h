@@ -35,6 +35,9 @@ namespace embree
     /*! notifies the builder about the deletion of some geometry */
     virtual void deleteGeometry(size_t geomID) {};
 
+    /*! makes some geometry unreachable in the last built hierarchy without rebuilding it */
+    virtual void hideGeometry(size_t geomID) {};
+
     /*! clears internal builder state */
     virtual void clear() = 0;
   };
@@ -24,11 +24,32 @@ namespace embree
 {
   class Scene;
 
+  /*! traversal counters of a single sampled ray */
+  struct TraversalCounters
+  {
+  public:
+    __forceinline TraversalCounters()
+      : nodes(0), leaves(0), prims(0), filters(0) {}
+
+    __forceinline void add(size_t numNodes, size_t numLeaves, size_t numPrims)
+    {
+      nodes  += numNodes;
+      leaves += numLeaves;
+      prims  += numPrims;
+    }
+
+  public:
+    size_t nodes;    //!< number of inner nodes visited
+    size_t leaves;   //!< number of leaves visited
+    size_t prims;    //!< number of primitive blocks tested
+    size_t filters;  //!< number of filter function invocations
+  };
+
   struct IntersectContext
   {
   public:
     __forceinline IntersectContext(Scene* scene, RTCIntersectContext* user_context)
-      : scene(scene), user(user_context) {}
+      : scene(scene), user(user_context), counters(nullptr) {}
 
     __forceinline bool hasContextFilter() const {
       return user->filter != nullptr;
@@ -45,6 +66,7 @@ namespace embree
   public:
     Scene* scene;
     RTCIntersectContext* user;
+    TraversalCounters* counters; //!< only set for rays sampled for traversal statistics
   };
   
   enum PointQueryType
@@ -24,6 +24,7 @@ namespace embree
 {
   class BVH4Factory;
   class BVH8Factory;
+  class BVH16Factory;
 
   class Device : public State, public MemoryMonitorInterface
   {
@@ -87,6 +88,9 @@ namespace embree
 #if defined(EMBREE_TARGET_SIMD8)
     std::unique_ptr<BVH8Factory> bvh8_factory;
 #endif
+#if defined(EMBREE_TARGET_AVX512SKX)
+    std::unique_ptr<BVH16Factory> bvh16_factory;
+#endif
     
 #if USE_TASK_ARENA
     std::unique_ptr<tbb::task_arena> arena;
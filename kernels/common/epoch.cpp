@@ -0,0 +1,110 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#include "epoch.h"
+
+namespace embree
+{
+  static __thread unsigned int epochThreadSlot = 0;
+  static std::atomic<unsigned int> epochThreadCounter(0);
+
+  Epochs::Epochs ()
+    : epoch(0), retired(nullptr)
+  {
+    slots = (Slot*) alignedMalloc(NUM_SLOTS*sizeof(Slot),64);
+    for (size_t i=0; i<NUM_SLOTS; i++)
+      for (size_t j=0; j<3; j++)
+        new (&slots[i].readers[j]) std::atomic<size_t>(0);
+  }
+
+  Epochs::~Epochs ()
+  {
+    clear();
+    alignedFree(slots);
+  }
+
+  size_t Epochs::threadSlot()
+  {
+    if (unlikely(epochThreadSlot == 0))
+      epochThreadSlot = epochThreadCounter++ % NUM_SLOTS + 1;
+    return epochThreadSlot-1;
+  }
+
+  void Epochs::push(Retired* first, Retired* last)
+  {
+    Retired* head = retired.load();
+    do last->next = head;
+    while (!retired.compare_exchange_weak(head,first));
+  }
+
+  void Epochs::retire(std::function<void()> release)
+  {
+    Retired* r = new Retired;
+    r->epoch = epoch.load();
+    r->release = std::move(release);
+    push(r,r);
+  }
+
+  void Epochs::collect()
+  {
+    /* each thread collects the data it took from the list, thus concurrent collects never release data twice */
+    Retired* list = retired.exchange(nullptr);
+    if (list == nullptr)
+      return;
+
+    /* advance the epoch at most twice, each time only if no reader is left in the previous epoch */
+    for (size_t i=0; i<2; i++)
+    {
+      size_t e = epoch.load();
+      bool active = false;
+      for (size_t j=0; j<NUM_SLOTS; j++)
+        active |= slots[j].readers[(e+2)%3].load() != 0;
+      if (active) break;
+      epoch.compare_exchange_strong(e,e+1);
+    }
+
+    /* data retired two epochs ago cannot be accessed by any reader anymore, the remaining data goes back to the list */
+    const size_t e = epoch.load();
+    Retired* first = nullptr;
+    Retired* last = nullptr;
+    while (list)
+    {
+      Retired* r = list;
+      list = list->next;
+      if (r->epoch+2 <= e) {
+        r->release();
+        delete r;
+      } else {
+        r->next = first;
+        first = r;
+        if (last == nullptr) last = r;
+      }
+    }
+    if (first) push(first,last);
+  }
+
+  void Epochs::clear()
+  {
+    Retired* list = retired.exchange(nullptr);
+    while (list)
+    {
+      Retired* r = list;
+      list = list->next;
+      r->release();
+      delete r;
+    }
+  }
+}
@@ -0,0 +1,105 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+#include <functional>
+
+namespace embree
+{
+  /*! Epoch based reclamation of data that concurrent readers may still
+   *  access. Readers announce themselves in the current epoch, writers
+   *  retire data and the data gets released once the epoch advanced
+   *  twice, as then no reader can still be inside the epoch the data
+   *  got retired in. Neither readers nor writers ever block. */
+  class Epochs
+  {
+    enum { NUM_SLOTS = 64 };
+
+    /*! reader counts of one group of threads for the last three epochs */
+    struct __aligned(64) Slot
+    {
+      std::atomic<size_t> readers[3];
+    };
+
+    struct Retired
+    {
+      size_t epoch;
+      std::function<void()> release;
+      Retired* next;
+    };
+
+  public:
+
+    Epochs ();
+    ~Epochs ();
+
+    /*! registers the calling thread as reader of the current epoch, the returned ticket has to be passed to leave */
+    __forceinline size_t enter()
+    {
+      Slot& slot = slots[threadSlot()];
+      while (true)
+      {
+        const size_t e = epoch.load();
+        slot.readers[e%3]++;
+        if (likely(epoch.load() == e))
+          return size_t(&slot-slots)*3 + e%3;
+        slot.readers[e%3]--;
+      }
+    }
+
+    /*! unregisters a reader */
+    __forceinline void leave(size_t ticket) {
+      slots[ticket/3].readers[ticket%3]--;
+    }
+
+    /*! releases data through the specified function once no reader can access it anymore */
+    void retire(std::function<void()> release);
+
+    /*! advances the epoch if possible and releases all data no reader can access anymore */
+    void collect();
+
+    /*! releases all retired data, no reader may be active */
+    void clear();
+
+  private:
+    static size_t threadSlot();
+
+    /*! pushes a list of retired data onto the retired list */
+    void push(Retired* first, Retired* last);
+
+  private:
+    Slot* slots;
+    std::atomic<size_t> epoch;
+    std::atomic<Retired*> retired; //!< lock free list of data waiting for its release
+  };
+
+  /*! keeps the current epoch alive while in scope */
+  struct EpochGuard
+  {
+    __forceinline EpochGuard (Epochs& epochs)
+      : epochs(epochs), ticket(epochs.enter()) {}
+
+    __forceinline ~EpochGuard () {
+      epochs.leave(ticket);
+    }
+
+  private:
+    Epochs& epochs;
+    size_t ticket;
+  };
+}
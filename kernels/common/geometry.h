@@ -342,6 +342,11 @@ namespace embree
     virtual void updateBuffer(RTCBufferType type, unsigned int slot) {
       update(); // update everything for geometries not supporting this call
     }
+
+    /*! Update a range of items of a geometry buffer. */
+    virtual void updateBufferRange(RTCBufferType type, unsigned int slot, size_t itemOffset, size_t itemCount) {
+      updateBuffer(type,slot); // update the entire buffer for geometries not tracking ranges
+    }
     
     /*! Disable geometry. */
     virtual void disable();
@@ -364,6 +369,11 @@ namespace embree
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
     }
 
+    /*! sets camera for view dependent tessellation rates of the geometry */
+    virtual void setTessellationCamera(const RTCTessellationCamera* camera) {
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"operation not supported for this geometry"); 
+    }
+
     /*! Set user data pointer. */
     virtual void setUserData(void* ptr);
       
@@ -263,6 +263,10 @@ namespace embree
   INIT_SYMBOL(features,intersector);                                 \
   SELECT_SYMBOL_AVX512KNL(features,intersector);                     \
   SELECT_SYMBOL_AVX512SKX(features,intersector);
+
+#define SELECT_SYMBOL_INIT_AVX512SKX(features,intersector) \
+  INIT_SYMBOL(features,intersector);                       \
+  SELECT_SYMBOL_AVX512SKX(features,intersector);
   
 #define SELECT_SYMBOL_SSE42_AVX_AVX2(features,intersector) \
   SELECT_SYMBOL_SSE42(features,intersector);               \
@@ -128,6 +128,9 @@ namespace embree
     time[i]   = query.time; 
   }
 
+  /* Maximal number of point queries that traverse a BVH together */
+  static const size_t MAX_POINT_QUERY_PACKET_SIZE = 16;
+
   /* Shortcuts */
   typedef PointQueryK<1>  PointQuery;
   typedef PointQueryK<4>  PointQuery4;
@@ -135,6 +138,88 @@ namespace embree
   typedef PointQueryK<16> PointQuery16;
   struct PointQueryN;
 
+  /*! Bounded max-heap of the k nearest neighbors found so far. The heap
+   *  is stored inside the output array of the query and holds squared
+   *  distances until finalize sorts the neighbors by distance. */
+  struct KNNHeap
+  {
+    __forceinline KNNHeap (RTCPointQueryNeighbor* items, size_t k, float radius)
+      : items(items), k(k), num(0), radius2(k ? radius*radius : float(neg_inf)) {}
+
+    /*! squared distance a primitive or node has to stay below to be of interest */
+    __forceinline float cullRadius2() const {
+      return radius2;
+    }
+
+    /*! inserts a neighbor, the farthest neighbor gets dropped once the heap is full */
+    __forceinline void insert(unsigned int geomID, unsigned int primID, float dist2)
+    {
+      if (dist2 > radius2)
+        return;
+
+      if (num < k)
+      {
+        size_t i = num++;
+        while (i > 0)
+        {
+          const size_t parent = (i-1)/2;
+          if (items[parent].distance >= dist2) break;
+          items[i] = items[parent];
+          i = parent;
+        }
+        items[i].geomID = geomID; items[i].primID = primID; items[i].distance = dist2;
+        if (num == k) radius2 = items[0].distance;
+        return;
+      }
+
+      if (dist2 >= items[0].distance)
+        return;
+
+      RTCPointQueryNeighbor item;
+      item.geomID = geomID; item.primID = primID; item.distance = dist2;
+      siftDown(item,num);
+      radius2 = items[0].distance;
+    }
+
+    /*! sorts the neighbors by increasing distance and returns their number */
+    __forceinline size_t finalize()
+    {
+      for (size_t n=num; n>1; n--)
+      {
+        const RTCPointQueryNeighbor last = items[n-1];
+        items[n-1] = items[0];
+        siftDown(last,n-1);
+      }
+      for (size_t i=0; i<num; i++)
+        items[i].distance = sqrt(items[i].distance);
+      return num;
+    }
+
+  private:
+
+    /*! places item at the root of a heap of size n and restores the heap property */
+    __forceinline void siftDown(const RTCPointQueryNeighbor& item, size_t n)
+    {
+      size_t i = 0;
+      while (true)
+      {
+        size_t c = 2*i+1;
+        if (c >= n) break;
+        if (c+1 < n && items[c+1].distance > items[c].distance) c++;
+        if (items[c].distance <= item.distance) break;
+        items[i] = items[c];
+        i = c;
+      }
+      items[i] = item;
+    }
+
+  private:
+    RTCPointQueryNeighbor* items;
+    size_t k;
+    size_t num;
+    float radius2;
+  };
+
   /* Outputs point query to stream */
   template<int K>
   inline std::ostream& operator <<(std::ostream& cout, const PointQueryK<K>& query)
@@ -204,6 +204,30 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcSetSceneBuildThreads (RTCScene hscene, unsigned int maxThreads) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneBuildThreads);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->setBuildThreads(maxThreads);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcSetSceneBuildPriority (RTCScene hscene, RTCBuildPriority priority) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneBuildPriority);
+    RTC_VERIFY_HANDLE(hscene);
+    if (priority != RTC_BUILD_PRIORITY_LOW &&
+        priority != RTC_BUILD_PRIORITY_NORMAL &&
+        priority != RTC_BUILD_PRIORITY_HIGH)
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid build priority");
+    scene->setBuildPriority(priority);
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcSetSceneFlags (RTCScene hscene, RTCSceneFlags flags) 
   {
     Scene* scene = (Scene*) hscene;
@@ -230,7 +254,7 @@ RTC_NAMESPACE_BEGIN;
       RTC_CATCH_BEGIN;
       RTC_TRACE(rtc_AT_SetNextBVHArguments);
       RTC_VERIFY_HANDLE(hscene);
-      scene->buildArguments=args;
+      scene->setBuildArguments(args);
       RTC_CATCH_END2(scene);
   }
 
@@ -245,12 +269,29 @@ RTC_NAMESPACE_BEGIN;
 
   }
 
+  RTC_API void rtc_AT_AutotuneScene(RTCScene hscene, const RTCAutotuneArguments* args)
+  {
+      Scene* scene = (Scene*) hscene;
+      RTC_CATCH_BEGIN;
+      RTC_TRACE(rtc_AT_AutotuneScene);
+      RTC_VERIFY_HANDLE(hscene);
+      RTCAutotuneArguments defaultArgs = rtc_AT_DefaultAutotuneArguments();
+      if (args == nullptr) args = &defaultArgs;
+      if (args->byteSize != sizeof(RTCAutotuneArguments))
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid autotune arguments");
+      if (args->numRays == 0 || args->numRepetitions == 0)
+        throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"autotuner requires at least one ray and one repetition");
+      scene->autotune(*args);
+      RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcCommitScene (RTCScene hscene) 
   {
     Scene* scene = (Scene*) hscene;
     RTC_CATCH_BEGIN;
     RTC_TRACE(rtcCommitScene);
     RTC_VERIFY_HANDLE(hscene);
+    scene->waitCommitAsync();
     scene->commit(false);
     RTC_CATCH_END2(scene);
   }
@@ -265,6 +306,68 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(scene);
   }
 
+  RTC_API void rtcCommitSceneAsync (RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCommitSceneAsync);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->commitAsync();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcWaitCommitScene (RTCScene hscene) 
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcWaitCommitScene);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->waitCommitAsync();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcGetSceneBuildStatistics(RTCScene hscene, RTCSceneBuildStatistics* statistics)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneBuildStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(statistics);
+    *statistics = scene->getBuildStatistics();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcSetSceneTraversalStatisticsRate(RTCScene hscene, unsigned int sampleRate)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetSceneTraversalStatisticsRate);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->setTraversalStatisticsRate(sampleRate);
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcGetSceneTraversalStatistics(RTCScene hscene, RTCTraversalStatistics* statistics)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcGetSceneTraversalStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    RTC_VERIFY_HANDLE(statistics);
+    *statistics = scene->getTraversalStatistics();
+    RTC_CATCH_END2(scene);
+  }
+
+  RTC_API void rtcResetSceneTraversalStatistics(RTCScene hscene)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcResetSceneTraversalStatistics);
+    RTC_VERIFY_HANDLE(hscene);
+    scene->resetTraversalStatistics();
+    RTC_CATCH_END2(scene);
+  }
+
   RTC_API void rtcGetSceneBounds(RTCScene hscene, RTCBounds* bounds_o)
   {
     Scene* scene = (Scene*) hscene;
@@ -326,14 +429,59 @@ RTC_NAMESPACE_BEGIN;
     if (scene0->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (scene1->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
     if (scene0->device != scene1->device) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes are from different devices");
-    auto nUserPrims0 = scene0->getNumPrimitives (Geometry::MTY_USER_GEOMETRY, false);
-    auto nUserPrims1 = scene1->getNumPrimitives (Geometry::MTY_USER_GEOMETRY, false);
-    if (scene0->numPrimitives() != nUserPrims0 && scene1->numPrimitives() != nUserPrims1) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain user geometries with a single timestep");
 #endif
-    scene0->intersectors.collide(scene0,scene1,callback,userPtr);
+    if (scene0->isAsyncCommit() || scene1->isAsyncCommit()) {
+      scene0->intersectors.collide(scene0,scene1,callback,userPtr);
+      return;
+    }
+
+    /* collide each acceleration structure of one scene with each of the other scene, e.g. triangles and quads get separate structures */
+    for (Accel* accel0 : scene0->accels)
+    {
+      for (Accel* accel1 : scene1->accels)
+      {
+        if (!accel0->intersectors.collider || accel0->intersectors.collider.collide != accel1->intersectors.collider.collide)
+          throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain user geometries or only triangle and quad meshes with a single timestep");
+        accel0->intersectors.collide(accel0,accel1,callback,userPtr);
+      }
+    }
     RTC_CATCH_END(scene0->device);
   }
   
+  RTC_API void rtcCollideContinuous (RTCScene hscene0, RTCScene hscene1, float time0, float time1, RTCContinuousCollideFunc callback, void* userPtr)
+  {
+    Scene* scene0 = (Scene*) hscene0;
+    Scene* scene1 = (Scene*) hscene1;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcCollideContinuous);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene0);
+    RTC_VERIFY_HANDLE(hscene1);
+    if (scene0->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (scene1->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (scene0->device != scene1->device) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes are from different devices");
+#endif
+    if (!(0.0f <= time0 && time0 < time1 && time1 <= 1.0f))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid time interval");
+
+    if (scene0->isAsyncCommit() || scene1->isAsyncCommit()) {
+      scene0->intersectors.collideContinuous(scene0,scene1,time0,time1,callback,userPtr);
+      return;
+    }
+
+    /* collide each acceleration structure of one scene with each of the other scene */
+    for (Accel* accel0 : scene0->accels)
+    {
+      for (Accel* accel1 : scene1->accels)
+      {
+        if (!accel0->intersectors.continuousCollider || accel0->intersectors.continuousCollider.collide != accel1->intersectors.continuousCollider.collide)
+          throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scenes must only contain triangle meshes, quad meshes, or user geometries");
+        accel0->intersectors.collideContinuous(accel0,accel1,time0,time1,callback,userPtr);
+      }
+    }
+    RTC_CATCH_END(scene0->device);
+  }
+
   inline bool pointQuery(Scene* scene, RTCPointQuery* query, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void* userPtr)
   {
     bool changed = false;
@@ -364,6 +512,46 @@ RTC_NAMESPACE_BEGIN;
     return changed;
   }
 
+  template<int K>
+  inline bool pointQueryK(const int* valid, Scene* scene, PointQueryK<K>* queryK, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void** userPtrN)
+  {
+    bool changed = false;
+    PointQuery query1[K];
+
+    /* queries relative to an instance get processed one by one */
+    if (userContext->instStackSize > 0)
+    {
+      for (size_t i=0; i<K; i++) {
+        if (!valid[i]) continue;
+        queryK->get(i,query1[i]);
+        changed |= pointQuery(scene, (RTCPointQuery*)&query1[i], userContext, queryFunc, userPtrN?userPtrN[i]:NULL);
+        queryK->set(i,query1[i]);
+      }
+      return changed;
+    }
+
+    /* all other queries traverse the scene together */
+    __aligned(16) char contextMem[K*sizeof(PointQueryContext)];
+    PointQuery* query[K];
+    PointQueryContext* context[K];
+    size_t mask = 0;
+    for (size_t i=0; i<K; i++) {
+      if (!valid[i]) continue;
+      queryK->get(i,query1[i]);
+      query[i] = &query1[i];
+      context[i] = new (&contextMem[i*sizeof(PointQueryContext)]) PointQueryContext(scene, query[i], 
+        POINT_QUERY_TYPE_SPHERE, queryFunc, userContext, 1.f, userPtrN?userPtrN[i]:NULL);
+      mask |= size_t(1) << i;
+    }
+    if (mask)
+      changed = scene->intersectors.pointQueryPacket(mask, query, context) != 0;
+
+    for (size_t i=0; i<K; i++) {
+      if (valid[i]) queryK->set(i,query1[i]);
+    }
+    return changed;
+  }
+
   RTC_API bool rtcPointQuery(RTCScene hscene, RTCPointQuery* query, RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void* userPtr)
   {
     Scene* scene = (Scene*) hscene;
@@ -381,6 +569,28 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2_FALSE(scene);
   }
   
+  RTC_API unsigned int rtcPointQueryKNN(RTCScene hscene, RTCPointQuery* query, unsigned int k, RTCPointQueryNeighbor* neighbors)
+  {
+    Scene* scene = (Scene*) hscene;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcPointQueryKNN);
+#if defined(DEBUG)
+    RTC_VERIFY_HANDLE(hscene);
+    if (scene->isModified()) throw_RTCError(RTC_ERROR_INVALID_OPERATION,"scene got not committed");
+    if (((size_t)query) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "query not aligned to 16 bytes");   
+#endif
+    if (k && !neighbors) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid neighbor array");
+    STAT3(point_query.travs,1,1,1);
+
+    /* the accels without points have no k-nearest neighbor query */
+    KNNHeap heap(neighbors,k,query->radius);
+    if (k && scene->intersectors.knn)
+      scene->intersectors.knnQuery((PointQuery*)query,&heap);
+    return (unsigned int) heap.finalize();
+    RTC_CATCH_END2(scene);
+    return 0;
+  }
+  
   RTC_API bool rtcPointQuery4 (const int* valid, RTCScene hscene, RTCPointQuery4* query, struct RTCPointQueryContext* userContext, RTCPointQueryFunction queryFunc, void** userPtrN)
   {
     Scene* scene = (Scene*) hscene;
@@ -396,16 +606,7 @@ RTC_NAMESPACE_BEGIN;
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(point_query.travs,cnt,cnt,cnt);
 
-    bool changed = false;
-    PointQuery4* query4 = (PointQuery4*)query;
-    PointQuery query1; 
-    for (size_t i=0; i<4; i++) {
-      if (!valid[i]) continue;
-      query4->get(i,query1);
-      changed |= pointQuery(scene, (RTCPointQuery*)&query1, userContext, queryFunc, userPtrN?userPtrN[i]:NULL);
-      query4->set(i,query1);
-    }
-    return changed;
+    return pointQueryK<4>(valid, scene, (PointQuery4*)query, userContext, queryFunc, userPtrN);
     RTC_CATCH_END2_FALSE(scene);
   }
   
@@ -424,16 +625,7 @@ RTC_NAMESPACE_BEGIN;
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(point_query.travs,cnt,cnt,cnt);
 
-    bool changed = false;
-    PointQuery8* query8 = (PointQuery8*)query;
-    PointQuery query1; 
-    for (size_t i=0; i<8; i++) {
-      if (!valid[i]) continue;
-      query8->get(i,query1);
-      changed |= pointQuery(scene, (RTCPointQuery*)&query1, userContext, queryFunc, userPtrN?userPtrN[i]:NULL);
-      query8->set(i,query1);
-    }
-    return changed;
+    return pointQueryK<8>(valid, scene, (PointQuery8*)query, userContext, queryFunc, userPtrN);
     RTC_CATCH_END2_FALSE(scene);
   }
 
@@ -452,16 +644,7 @@ RTC_NAMESPACE_BEGIN;
     STAT(size_t cnt=0; for (size_t i=0; i<4; i++) cnt += ((int*)valid)[i] == -1;);
     STAT3(point_query.travs,cnt,cnt,cnt);
 
-    bool changed = false;
-    PointQuery16* query16 = (PointQuery16*)query;
-    PointQuery query1; 
-    for (size_t i=0; i<16; i++) {
-      if (!valid[i]) continue;
-      PointQuery query1; query16->get(i,query1);
-      changed |= pointQuery(scene, (RTCPointQuery*)&query1, userContext, queryFunc, userPtrN?userPtrN[i]:NULL);
-      query16->set(i,query1);
-    }
-    return changed;
+    return pointQueryK<16>(valid, scene, (PointQuery16*)query, userContext, queryFunc, userPtrN);
     RTC_CATCH_END2_FALSE(scene);
   }
 
@@ -477,7 +660,10 @@ RTC_NAMESPACE_BEGIN;
 #endif
     STAT3(normal.travs,1,1,1);
     IntersectContext context(scene,user_context);
+    TraversalCounters counters;
+    if (unlikely(scene->sampleTraversal(user_context))) context.counters = &counters;
     scene->intersectors.intersect(*rayhit,&context);
+    if (unlikely(context.counters)) scene->addTraversalCounters(counters);
 #if defined(DEBUG)
     ((RayHit*)rayhit)->verifyHit();
 #endif
@@ -731,7 +917,10 @@ RTC_NAMESPACE_BEGIN;
     if (((size_t)ray) & 0x0F) throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "ray not aligned to 16 bytes");   
 #endif
     IntersectContext context(scene,user_context);
+    TraversalCounters counters;
+    if (unlikely(scene->sampleTraversal(user_context))) context.counters = &counters;
     scene->intersectors.occluded(*ray,&context);
+    if (unlikely(context.counters)) scene->addTraversalCounters(counters);
     RTC_CATCH_END2(scene);
   }
   
@@ -1491,6 +1680,16 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcUpdateGeometryBufferRange (RTCGeometry hgeometry, RTCBufferType type, unsigned int slot, size_t itemOffset, size_t itemCount) 
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcUpdateGeometryBufferRange);
+    RTC_VERIFY_HANDLE(hgeometry);
+    geometry->updateBufferRange(type, slot, itemOffset, itemCount);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcDisableGeometry (RTCGeometry hgeometry) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -1511,6 +1710,18 @@ RTC_NAMESPACE_BEGIN;
     RTC_CATCH_END2(geometry);
   }
 
+  RTC_API void rtcSetGeometryTessellationCamera (RTCGeometry hgeometry, const RTCTessellationCamera* camera)
+  {
+    Geometry* geometry = (Geometry*) hgeometry;
+    RTC_CATCH_BEGIN;
+    RTC_TRACE(rtcSetGeometryTessellationCamera);
+    RTC_VERIFY_HANDLE(hgeometry);
+    if (camera && (camera->width == 0 || camera->height == 0 || !(camera->edgeLength > 0.0f)))
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"invalid tessellation camera");
+    geometry->setTessellationCamera(camera);
+    RTC_CATCH_END2(geometry);
+  }
+
   RTC_API void rtcSetGeometryUserData (RTCGeometry hgeometry, void* ptr) 
   {
     Geometry* geometry = (Geometry*) hgeometry;
@@ -18,6 +18,7 @@
 
 #include "../bvh/bvh4_factory.h"
 #include "../bvh/bvh8_factory.h"
+#include "../bvh/bvh16_factory.h"
 #include "../../common/algorithms/parallel_reduce.h"
  
 namespace embree
@@ -29,13 +30,17 @@ namespace embree
   void invalid_rtcIntersect8()  { throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersect8 and rtcOccluded8 not enabled"); }
   void invalid_rtcIntersect16() { throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersect16 and rtcOccluded16 not enabled"); }
   void invalid_rtcIntersectN()  { throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcIntersectN and rtcOccludedN not enabled"); }
+  void invalid_rtcCollideAsync() { throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcCollide not supported for scenes with RTC_SCENE_FLAG_ASYNC_COMMIT"); }
+  void invalid_rtcCollideContinuousAsync() { throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcCollideContinuous not supported for scenes with RTC_SCENE_FLAG_ASYNC_COMMIT"); }
 
   Scene::Scene (Device* device)
     : device(device),
       flags_modified(true), enabled_geometry_types(0),
       scene_flags(RTC_SCENE_FLAG_NONE),
       quality_flags(RTC_BUILD_QUALITY_MEDIUM),
-      is_build(false), modified(true),
+      buildThreads(0), buildPriority(RTC_BUILD_PRIORITY_NORMAL),
+      firstFreeGeometrySlot(0), traversalStatisticsRate(0), is_build(false), modified(true),
+      traversalStatisticsSlots(nullptr), asyncFront(nullptr), asyncSpare(nullptr), asyncThread(nullptr),
       progressInterface(this), progress_monitor_function(nullptr), progress_monitor_ptr(nullptr), progress_monitor_counter(0)
   {
     device->refInc();
@@ -52,6 +57,11 @@ namespace embree
 
     intersectors = Accel::Intersectors(missing_rtcCommit);
 
+    /* builders use their default settings until build arguments are set */
+    buildArguments = rtcDefaultBuildArguments();
+    buildArguments.byteSize = 0;
+    memset(&buildStatistics,0,sizeof(buildStatistics));
+
     /* one can overwrite flags through device for debugging */
     if (device->quality_flags != -1)
       quality_flags = (RTCBuildQuality) device->quality_flags;
@@ -61,6 +71,12 @@ namespace embree
 
   Scene::~Scene () 
   {
+    if (asyncThread) embree::join(asyncThread);
+    epochs.clear();
+    delete asyncFront.load();
+    delete asyncSpare.load();
+    alignedFree(traversalStatisticsSlots.load());
+
 #if defined(TASKING_TBB) || defined(TASKING_PPL)
     delete group; group = nullptr;
 #endif
@@ -183,6 +199,7 @@ namespace embree
     else if (device->tri_accel == "bvh4.triangle4")       accels_add(device->bvh4_factory->BVH4Triangle4 (this));
     else if (device->tri_accel == "bvh4.triangle4v")      accels_add(device->bvh4_factory->BVH4Triangle4v(this));
     else if (device->tri_accel == "bvh4.triangle4i")      accels_add(device->bvh4_factory->BVH4Triangle4i(this));
+    else if (device->tri_accel == "bvh4.triangle4c")      accels_add(device->bvh4_factory->BVH4Triangle4c(this));
     else if (device->tri_accel == "qbvh4.triangle4i")     accels_add(device->bvh4_factory->BVH4QuantizedTriangle4i(this));
 
 #if defined (EMBREE_TARGET_SIMD8)
@@ -191,6 +208,10 @@ namespace embree
     else if (device->tri_accel == "bvh8.triangle4i")      accels_add(device->bvh8_factory->BVH8Triangle4i(this));
     else if (device->tri_accel == "qbvh8.triangle4i")     accels_add(device->bvh8_factory->BVH8QuantizedTriangle4i(this));
     else if (device->tri_accel == "qbvh8.triangle4")      accels_add(device->bvh8_factory->BVH8QuantizedTriangle4(this));
+#endif
+#if defined (EMBREE_TARGET_AVX512SKX)
+    else if (device->tri_accel == "bvh16.triangle4")      accels_add(device->bvh16_factory->BVH16Triangle4 (this));
+    else if (device->tri_accel == "bvh16.triangle4v")     accels_add(device->bvh16_factory->BVH16Triangle4v(this));
 #endif
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown triangle acceleration structure "+device->tri_accel);
 #endif
@@ -226,9 +247,11 @@ namespace embree
     }
     else if (device->tri_accel_mb == "bvh4.triangle4imb") accels_add(device->bvh4_factory->BVH4Triangle4iMB(this));
     else if (device->tri_accel_mb == "bvh4.triangle4vmb") accels_add(device->bvh4_factory->BVH4Triangle4vMB(this));
+    else if (device->tri_accel_mb == "qbvh4.triangle4imb") accels_add(device->bvh4_factory->BVH4QuantizedTriangle4iMB(this));
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->tri_accel_mb == "bvh8.triangle4imb") accels_add(device->bvh8_factory->BVH8Triangle4iMB(this));
     else if (device->tri_accel_mb == "bvh8.triangle4vmb") accels_add(device->bvh8_factory->BVH8Triangle4vMB(this));
+    else if (device->tri_accel_mb == "qbvh8.triangle4imb") accels_add(device->bvh8_factory->BVH8QuantizedTriangle4iMB(this));
 #endif
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown motion blur triangle acceleration structure "+device->tri_accel_mb);
 #endif
@@ -345,8 +368,10 @@ namespace embree
       }
     }
     else if (device->quad_accel_mb == "bvh4.quad4imb") accels_add(device->bvh4_factory->BVH4Quad4iMB(this));
+    else if (device->quad_accel_mb == "qbvh4.quad4imb") accels_add(device->bvh4_factory->BVH4QuantizedQuad4iMB(this));
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->quad_accel_mb == "bvh8.quad4imb") accels_add(device->bvh8_factory->BVH8Quad4iMB(this));
+    else if (device->quad_accel_mb == "qbvh8.quad4imb") accels_add(device->bvh8_factory->BVH8QuantizedQuad4iMB(this));
 #endif
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown quad motion blur acceleration structure "+device->quad_accel_mb);
 #endif
@@ -408,10 +433,12 @@ namespace embree
       }
     }
     else if (device->hair_accel_mb == "bvh4.virtualcurve4imb") accels_add(device->bvh4_factory->BVH4OBBVirtualCurve4iMB(this,BVHFactory::IntersectVariant::FAST));
+    else if (device->hair_accel_mb == "qbvh4.virtualcurve4imb") accels_add(device->bvh4_factory->BVH4QuantizedOBBVirtualCurve4iMB(this));
 
 #if defined (EMBREE_TARGET_SIMD8)
     else if (device->hair_accel_mb == "bvh4.virtualcurve8imb") accels_add(device->bvh4_factory->BVH4OBBVirtualCurve8iMB(this,BVHFactory::IntersectVariant::FAST));
     else if (device->hair_accel_mb == "bvh8.virtualcurve8imb") accels_add(device->bvh8_factory->BVH8OBBVirtualCurve8iMB(this,BVHFactory::IntersectVariant::FAST));
+    else if (device->hair_accel_mb == "qbvh8.virtualcurve8imb") accels_add(device->bvh8_factory->BVH8QuantizedOBBVirtualCurve8iMB(this));
 #endif
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown motion blur hair acceleration structure "+device->hair_accel_mb);
 #endif
@@ -425,6 +452,7 @@ namespace embree
     }
     else if (device->subdiv_accel == "bvh4.grid.eager" ) accels_add(device->bvh4_factory->BVH4SubdivPatch1(this));
     else if (device->subdiv_accel == "bvh4.subdivpatch1eager" ) accels_add(device->bvh4_factory->BVH4SubdivPatch1(this));
+    else if (device->subdiv_accel == "bvh4.grid.lazy"         ) accels_add(device->bvh4_factory->BVH4SubdivPatch1Lazy(this));
     else throw_RTCError(RTC_ERROR_INVALID_ARGUMENT,"unknown subdiv accel "+device->subdiv_accel);
 #endif
   }
@@ -596,51 +624,116 @@ namespace embree
   void Scene::clear() {
   }
 
-  unsigned Scene::bind(unsigned geomID, Ref<Geometry> geometry) 
+  void Scene::growGeometryTables(size_t N)
   {
-    Lock<SpinLock> lock(geometriesMutex);
-    if (geomID == RTC_INVALID_GEOMETRY_ID) {
-      geomID = id_pool.allocate();
-      if (geomID == RTC_INVALID_GEOMETRY_ID)
+    /* the geometry table grows last, thus all tables are large enough for each slot a reader can see */
+    geometrySlots_.grow(N);
+    vertices.grow(N);
+    geometryModCounters_.grow(N);
+    geometries.grow(N);
+  }
+
+  unsigned Scene::allocateGeometrySlot()
+  {
+    unsigned int first = firstFreeGeometrySlot.load();
+    for (size_t i=first; ; i++)
+    {
+      if (i+1 > 0xFFFFFFFE)
         throw_RTCError(RTC_ERROR_INVALID_OPERATION,"too many geometries inside scene");
+      if (i >= size())
+        growGeometryTables(i+1);
+
+      char expected = SLOT_FREE;
+      if (geometrySlots_[i].compare_exchange_strong(expected,SLOT_BINDING)) {
+        firstFreeGeometrySlot.compare_exchange_strong(first,unsigned(i+1));
+        return unsigned(i);
+      }
     }
+  }
+
+  unsigned Scene::bind(unsigned geomID, Ref<Geometry> geometry) 
+  {
+    /* geometries claim their slot atomically, thus attaching never blocks ray queries, builds, or other attaching threads */
+    if (geomID == RTC_INVALID_GEOMETRY_ID)
+      geomID = allocateGeometrySlot();
     else
     {
-      if (!id_pool.add(geomID))
+      if (geomID >= size())
+        growGeometryTables(geomID+1);
+
+      char expected = SLOT_FREE;
+      if (!geometrySlots_[geomID].compare_exchange_strong(expected,SLOT_BINDING))
         throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid geometry ID provided");
     }
-    if (geomID >= geometries.size()) {
-      geometries.resize(geomID+1);
-      vertices.resize(geomID+1);
-      geometryModCounters_.resize(geomID+1);
-    }
-    geometries[geomID] = geometry;
+
+    vertices[geomID] = nullptr;
     geometryModCounters_[geomID] = 0;
+    geometries[geomID] = geometry;
+
+    /* a build of an asynchronous commit scene may run, thus the geometry becomes visible to the next build only */
+    geometrySlots_[geomID] = isAsyncCommit() ? SLOT_ATTACHED : SLOT_VISIBLE;
     if (geometry->isEnabled()) {
       setModified ();
     }
+    if (isAsyncCommit())
+      epochs.collect();
     return geomID;
   }
 
   void Scene::detachGeometry(size_t geomID)
   {
-    Lock<SpinLock> lock(geometriesMutex);
-    
-    if (geomID >= geometries.size())
+    if (geomID >= size())
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid geometry ID");
 
+    /* rays may still traverse the geometry, thus asynchronous commit scenes keep its slot until no ray can reach it anymore */
+    if (isAsyncCommit())
+    {
+      {
+        /* the front structures stay alive while the geometry gets hidden in them */
+        EpochGuard guard(epochs);
+        while (true)
+        {
+          char slot = geometrySlots_[geomID];
+          if (slot == SLOT_ATTACHED && geometrySlots_[geomID].compare_exchange_strong(slot,SLOT_REMOVED)) {
+            epochs.retire([this,geomID] () { releaseGeometrySlot(geomID); });
+            break;
+          }
+          if (slot == SLOT_VISIBLE && geometrySlots_[geomID].compare_exchange_strong(slot,SLOT_DETACHED)) {
+            if (AccelN* front = asyncFront.load())
+              front->hideGeometry(geomID);
+            break;
+          }
+          if (slot != SLOT_ATTACHED && slot != SLOT_VISIBLE)
+            throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid geometry");
+        }
+        if (geometries[geomID]->isEnabled()) {
+          setModified ();
+        }
+      }
+      epochs.collect();
+      return;
+    }
+
     Ref<Geometry>& geometry = geometries[geomID];
-    if (geometry == null)
+    if (geometry == null || geometrySlots_[geomID] != SLOT_VISIBLE)
       throw_RTCError(RTC_ERROR_INVALID_OPERATION,"invalid geometry");
     
     if (geometry->isEnabled()) {
       setModified ();
     }
     accels_deleteGeometry(unsigned(geomID));
-    id_pool.deallocate((unsigned)geomID);
+    releaseGeometrySlot(geomID);
+  }
+
+  void Scene::releaseGeometrySlot(size_t geomID)
+  {
     geometries[geomID] = null;
     vertices[geomID] = nullptr;
     geometryModCounters_[geomID] = 0;
+    geometrySlots_[geomID] = SLOT_FREE;
+
+    unsigned int first = firstFreeGeometrySlot.load();
+    while (geomID < first && !firstFreeGeometrySlot.compare_exchange_weak(first,unsigned(geomID)));
   }
 
   void Scene::updateInterface()
@@ -650,10 +743,52 @@ namespace embree
 
   void Scene::commit_task ()
   {
+    /* structures retired by the last publish become the spare once ray queries finished */
+    if (isAsyncCommit())
+      epochs.collect();
+
+    /* geometry tables of asynchronous commit scenes may get replaced while building */
+    EpochGuard guard(epochs);
+
+    /* the build includes all geometries attached and excludes all geometries detached before it started */
+    if (isAsyncCommit())
+    {
+      for (size_t i=0; i<size(); i++)
+      {
+        char slot = SLOT_ATTACHED;
+        if (geometrySlots_[i].compare_exchange_strong(slot,SLOT_VISIBLE))
+          continue;
+        if (slot == SLOT_DETACHED) {
+          geometrySlots_[i] = SLOT_REMOVED;
+          asyncRemoved.push_back(i);
+        }
+      }
+    }
+
     checkIfModifiedAndSet ();
     if (!isModified()) {
       return;
     }
+
+    /* asynchronous commits build into the structures rays traversed before the last publish if no ray query accesses them anymore */
+    std::unique_ptr<AsyncAccel> back;
+    if (isAsyncCommit())
+    {
+      back.reset(asyncSpare.exchange(nullptr));
+      if (back && !flags_modified)
+        reuseAsync(back.get());
+      else {
+        back.reset(new AsyncAccel);
+        flags_modified = true;
+      }
+    }
+
+    /* builders report their statistics during the commit */
+    const double t0 = device->build_statistics ? getSeconds() : 0.0;
+    {
+      Lock<SpinLock> lock(buildStatisticsMutex);
+      memset(&buildStatistics,0,sizeof(buildStatistics));
+    }
     
     /* print scene statistics */
     if (device->verbosity(2))
@@ -668,7 +803,7 @@ namespace embree
         GeometryCounts c;
         for (auto i=r.begin(); i<r.end(); ++i) 
         {
-          if (geometries[i] && geometries[i]->isEnabled()) 
+          if (geometries[i] && !isGeometryHidden(i) && geometries[i]->isEnabled()) 
           {
             geometries[i]->preCommit();
             geometries[i]->addElementsToCount (c);
@@ -688,8 +823,8 @@ namespace embree
 
       /* we need to make all geometries modified, otherwise two level builder will 
         not rebuild currently not modified geometries */
-      parallel_for(geometryModCounters_.size(), [&] ( const size_t i ) {
-          geometryModCounters_[i] = 0;
+      parallel_for(size(), [&] ( const size_t i ) {
+          if (!isGeometryHidden(i)) geometryModCounters_[i] = 0;
         });
       
       if (getNumPrimitives(TriangleMesh::geom_type,false)) createTriangleAccel();
@@ -713,29 +848,55 @@ namespace embree
       enabled_geometry_types = new_enabled_geometry_types;
     }
     
+    /* asynchronous commits build into the back structures while rays traverse the front ones */
+    AccelN* target = this;
+    if (back) {
+      back->accels.swap(accels);
+      target = back.get();
+    }
+
     /* select fast code path if no filter function is present */
-    accels_select(hasFilterFunction());
+    target->accels_select(hasFilterFunction());
   
     /* build all hierarchies of this scene */
-	accels_build();
+    target->accels_build();
 
     /* make static geometry immutable */
     if (!isDynamicAccel()) {
-      accels_immutable();
+      target->accels_immutable();
       flags_modified = true; // in non-dynamic mode we have to re-create accels
     }
 
     /* call postCommit function of each geometry */
-    parallel_for(geometries.size(), [&] ( const size_t i ) {
-        if (geometries[i] && geometries[i]->isEnabled()) {
+    parallel_for(size(), [&] ( const size_t i ) {
+        if (geometries[i] && !isGeometryHidden(i) && geometries[i]->isEnabled()) {
           geometries[i]->postCommit();
           vertices[i] = geometries[i]->getCompactVertexArray();
           geometryModCounters_[i] = geometries[i]->getModCounter();
         }
       });
+
+    if (back)
+    {
+      const size_t N = size();
+      back->geometries.resize(N);
+      back->modCounters.resize(N);
+      parallel_for(N, [&] ( const size_t i ) {
+          if (isGeometryHidden(i)) return;
+          back->geometries[i] = geometries[i];
+          back->modCounters[i] = geometryModCounters_[i];
+        });
+      back->enabledGeometryTypes = enabled_geometry_types;
+      publishAsync(back.release());
+    }
       
     updateInterface();
 
+    if (device->build_statistics) {
+      Lock<SpinLock> lock(buildStatisticsMutex);
+      buildStatistics.buildTime = getSeconds()-t0;
+    }
+
     if (device->verbosity(2)) {
       std::cout << "created scene intersector" << std::endl;
       accels_print(2);
@@ -743,7 +904,285 @@ namespace embree
       intersectors.print(2);
     }
     
+    /* publishing resets the modified flag of asynchronous commit scenes */
+    if (!isAsyncCommit())
+      setModified(false);
+  }
+
+  void Scene::reuseAsync (AsyncAccel* accel)
+  {
+    /* the structures only need updates for geometries modified since their build, other geometries may now use the slot,
+       thus the builders drop their data of that slot, the snapshot keeps the old geometries alive thus their addresses cannot get reused */
+    for (size_t i=0; i<size(); i++)
+    {
+      const bool visible = !isGeometryHidden(i) && geometries[i];
+      const bool same = visible && i < accel->geometries.size() && accel->geometries[i] == geometries[i];
+      if (!same && i < accel->geometries.size()) accel->accels_deleteGeometry(i);
+      if (visible) geometryModCounters_[i] = same ? accel->modCounters[i] : 0;
+    }
+    accels.swap(accel->accels);
+    enabled_geometry_types = accel->enabledGeometryTypes;
+  }
+
+  void Scene::publishAsync (AsyncAccel* accel)
+  {
+    bounds = accel->bounds;
+    AsyncAccel* prev = asyncFront.exchange(accel);
+
+    /* geometries detached during the build get hidden in the new structures again, attaching and detaching
+       geometries marks the scene as modified after changing the slot, thus the scene is reset first */
     setModified(false);
+    bool pending = false;
+    for (size_t i=0; i<size(); i++)
+    {
+      const char slot = geometrySlots_[i];
+      if (slot == SLOT_DETACHED) accel->hideGeometry(i);
+      pending |= slot == SLOT_DETACHED || slot == SLOT_ATTACHED;
+    }
+    if (pending) setModified();
+
+    /* the previous structures become the spare for the next commit and the removed geometries get released once no ray traverses them anymore */
+    if (prev)
+      epochs.retire([this,prev] () { delete asyncSpare.exchange(prev); });
+    for (size_t geomID : asyncRemoved)
+      epochs.retire([this,geomID] () { releaseGeometrySlot(geomID); });
+    asyncRemoved.clear();
+    epochs.collect();
+
+    /* ray queries get forwarded to the front structures from now on */
+    if (intersectors.intersector1.intersect != &intersectAsync)
+    {
+      type = AccelData::TY_ACCELN;
+      intersectors = Accel::Intersectors();
+      intersectors.ptr = this;
+      intersectors.collider      = Accel::Collider((Accel::ErrorFunc) invalid_rtcCollideAsync);
+      intersectors.continuousCollider = Accel::ContinuousCollider((Accel::ErrorFunc) invalid_rtcCollideContinuousAsync);
+      intersectors.knn           = Accel::KNNQuery(&knnQueryAsync,"Scene::knnQueryAsync");
+      intersectors.intersector1  = Accel::Intersector1(&intersectAsync,&occludedAsync,&pointQueryAsync,&pointQueryPacketAsync,"Scene::intersector1Async");
+      intersectors.intersector4  = Accel::Intersector4(&intersectAsync4,&occludedAsync4,"Scene::intersector4Async");
+      intersectors.intersector8  = Accel::Intersector8(&intersectAsync8,&occludedAsync8,"Scene::intersector8Async");
+      intersectors.intersector16 = Accel::Intersector16(&intersectAsync16,&occludedAsync16,"Scene::intersector16Async");
+      intersectors.intersectorN  = Accel::IntersectorN(&intersectAsyncN,&occludedAsyncN,"Scene::intersectorNAsync");
+    }
+  }
+
+  void Scene::intersectAsync (Accel::Intersectors* This, RTCRayHit& ray, IntersectContext* context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    scene->asyncFront.load()->intersectors.intersect(ray,context);
+  }
+
+  void Scene::intersectAsync4 (const void* valid, Accel::Intersectors* This, RTCRayHit4& ray, IntersectContext* context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    scene->asyncFront.load()->intersectors.intersect4(valid,ray,context);
+  }
+
+  void Scene::intersectAsync8 (const void* valid, Accel::Intersectors* This, RTCRayHit8& ray, IntersectContext* context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    scene->asyncFront.load()->intersectors.intersect8(valid,ray,context);
+  }
+
+  void Scene::intersectAsync16 (const void* valid, Accel::Intersectors* This, RTCRayHit16& ray, IntersectContext* context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    scene->asyncFront.load()->intersectors.intersect16(valid,ray,context);
+  }
+
+  void Scene::intersectAsyncN (Accel::Intersectors* This, RTCRayHitN** ray, const size_t N, IntersectContext* context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    scene->asyncFront.load()->intersectors.intersectN(ray,N,context);
+  }
+
+  void Scene::occludedAsync (Accel::Intersectors* This, RTCRay& ray, IntersectContext* context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    scene->asyncFront.load()->intersectors.occluded(ray,context);
+  }
+
+  void Scene::occludedAsync4 (const void* valid, Accel::Intersectors* This, RTCRay4& ray, IntersectContext* context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    scene->asyncFront.load()->intersectors.occluded4(valid,ray,context);
+  }
+
+  void Scene::occludedAsync8 (const void* valid, Accel::Intersectors* This, RTCRay8& ray, IntersectContext* context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    scene->asyncFront.load()->intersectors.occluded8(valid,ray,context);
+  }
+
+  void Scene::occludedAsync16 (const void* valid, Accel::Intersectors* This, RTCRay16& ray, IntersectContext* context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    scene->asyncFront.load()->intersectors.occluded16(valid,ray,context);
+  }
+
+  void Scene::occludedAsyncN (Accel::Intersectors* This, RTCRayN** ray, const size_t N, IntersectContext* context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    scene->asyncFront.load()->intersectors.occludedN(ray,N,context);
+  }
+
+  bool Scene::pointQueryAsync (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    return scene->asyncFront.load()->intersectors.pointQuery(query,context);
+  }
+
+  size_t Scene::pointQueryPacketAsync (Accel::Intersectors* This, size_t valid, PointQuery** query, PointQueryContext** context) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    return scene->asyncFront.load()->intersectors.pointQueryPacket(valid,query,context);
+  }
+
+  void Scene::knnQueryAsync (Accel::Intersectors* This, PointQuery* query, KNNHeap* heap) {
+    Scene* scene = (Scene*)This->ptr;
+    EpochGuard guard(scene->epochs);
+    AccelN* front = scene->asyncFront.load();
+    if (front->intersectors.knn) front->intersectors.knnQuery(query,heap);
+  }
+
+  void Scene::commitAsyncThread (void* ptr)
+  {
+    Scene* scene = (Scene*) ptr;
+    try {
+      scene->commit(false);
+    } catch (...) {
+      scene->asyncError = std::current_exception();
+    }
+
+    /* the build does not hold back the release of retired structures anymore */
+    scene->epochs.collect();
+  }
+
+  void Scene::commitAsync ()
+  {
+    if (!isAsyncCommit())
+      throw_RTCError(RTC_ERROR_INVALID_OPERATION,"rtcCommitSceneAsync requires RTC_SCENE_FLAG_ASYNC_COMMIT");
+
+    /* only one commit of the scene can run at a time */
+    waitCommitAsync();
+
+    Lock<MutexSys> lock(asyncMutex);
+    asyncThread = createThread(commitAsyncThread,this);
+  }
+
+  void Scene::waitCommitAsync ()
+  {
+    Lock<MutexSys> lock(asyncMutex);
+    if (asyncThread) {
+      embree::join(asyncThread);
+      asyncThread = nullptr;
+    }
+
+    if (asyncError) {
+      std::exception_ptr error = asyncError;
+      asyncError = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+  void Scene::addBuildStatistics (const RTCSceneBuildStatistics& stat)
+  {
+    Lock<SpinLock> lock(buildStatisticsMutex);
+    buildStatistics.primRefTime      += stat.primRefTime;
+    buildStatistics.binningTime      += stat.binningTime;
+    buildStatistics.spatialSplitTime += stat.spatialSplitTime;
+    buildStatistics.leafTime         += stat.leafTime;
+    buildStatistics.layoutTime       += stat.layoutTime;
+    buildStatistics.allocatorTime    += stat.allocatorTime;
+    buildStatistics.numPrimitives    += stat.numPrimitives;
+    buildStatistics.numInnerNodes    += stat.numInnerNodes;
+    buildStatistics.numLeaves        += stat.numLeaves;
+    buildStatistics.sahCost          += stat.sahCost;
+    buildStatistics.allocatedBytes   += stat.allocatedBytes;
+    buildStatistics.usedBytes        += stat.usedBytes;
+    buildStatistics.wastedBytes      += stat.wastedBytes;
+  }
+
+  RTCSceneBuildStatistics Scene::getBuildStatistics ()
+  {
+    Lock<SpinLock> lock(buildStatisticsMutex);
+    return buildStatistics;
+  }
+
+  void Scene::setTraversalStatisticsRate (unsigned int rate) {
+    traversalStatisticsRate = rate;
+  }
+
+  /*! per thread state for ray sampling, shared by all scenes */
+  static __thread unsigned int traversalSampleCounter = 0;
+  static __thread unsigned int traversalThreadSlot = 0;
+  static std::atomic<unsigned int> traversalThreadCounter(0);
+
+  bool Scene::sampleTraversalRate (const RTCIntersectContext* context)
+  {
+    if (context->flags & RTC_INTERSECT_CONTEXT_FLAG_TRAVERSAL_STATISTICS)
+      return true;
+
+    const unsigned int rate = traversalStatisticsRate.load(std::memory_order_relaxed);
+    if (rate == 0) return false;
+    if (++traversalSampleCounter < rate) return false;
+    traversalSampleCounter = 0;
+    return true;
+  }
+
+  void Scene::addTraversalCounters (const TraversalCounters& counters)
+  {
+    TraversalStatisticsSlot* slots = traversalStatisticsSlots.load();
+    if (unlikely(slots == nullptr))
+    {
+      TraversalStatisticsSlot* newSlots = (TraversalStatisticsSlot*) alignedMalloc(NUM_TRAVERSAL_STATISTICS_SLOTS*sizeof(TraversalStatisticsSlot),64);
+      memset((void*)newSlots,0,NUM_TRAVERSAL_STATISTICS_SLOTS*sizeof(TraversalStatisticsSlot));
+      if (traversalStatisticsSlots.compare_exchange_strong(slots,newSlots)) slots = newSlots;
+      else alignedFree(newSlots);
+    }
+
+    if (unlikely(traversalThreadSlot == 0))
+      traversalThreadSlot = traversalThreadCounter++ % NUM_TRAVERSAL_STATISTICS_SLOTS + 1;
+
+    TraversalStatisticsSlot& slot = slots[traversalThreadSlot-1];
+    slot.rays   .fetch_add(1,               std::memory_order_relaxed);
+    slot.nodes  .fetch_add(counters.nodes,  std::memory_order_relaxed);
+    slot.leaves .fetch_add(counters.leaves, std::memory_order_relaxed);
+    slot.prims  .fetch_add(counters.prims,  std::memory_order_relaxed);
+    slot.filters.fetch_add(counters.filters,std::memory_order_relaxed);
+  }
+
+  RTCTraversalStatistics Scene::getTraversalStatistics ()
+  {
+    RTCTraversalStatistics stat;
+    memset(&stat,0,sizeof(stat));
+    TraversalStatisticsSlot* slots = traversalStatisticsSlots.load();
+    if (slots == nullptr) return stat;
+
+    for (size_t i=0; i<NUM_TRAVERSAL_STATISTICS_SLOTS; i++)
+    {
+      stat.numRays           += slots[i].rays   .load(std::memory_order_relaxed);
+      stat.numNodes          += slots[i].nodes  .load(std::memory_order_relaxed);
+      stat.numLeaves         += slots[i].leaves .load(std::memory_order_relaxed);
+      stat.numPrimitiveTests += slots[i].prims  .load(std::memory_order_relaxed);
+      stat.numFilterCalls    += slots[i].filters.load(std::memory_order_relaxed);
+    }
+    return stat;
+  }
+
+  void Scene::resetTraversalStatistics ()
+  {
+    TraversalStatisticsSlot* slots = traversalStatisticsSlots.load();
+    if (slots == nullptr) return;
+
+    for (size_t i=0; i<NUM_TRAVERSAL_STATISTICS_SLOTS; i++)
+    {
+      slots[i].rays    = 0;
+      slots[i].nodes   = 0;
+      slots[i].leaves  = 0;
+      slots[i].prims   = 0;
+      slots[i].filters = 0;
+    }
   }
 
   void Scene::setBuildQuality(RTCBuildQuality quality_flags_i)
@@ -767,6 +1206,21 @@ namespace embree
   RTCSceneFlags Scene::getSceneFlags() const {
     return scene_flags;
   }
+
+  void Scene::setBuildArguments(const RTCBuildArguments& arguments)
+  {
+    buildArguments = arguments;
+    flags_modified = true; // builders pick up the arguments when they get created
+    setModified();
+  }
+
+  void Scene::setBuildThreads(size_t maxThreads) {
+    buildThreads = maxThreads; // takes effect with the next commit
+  }
+
+  void Scene::setBuildPriority(RTCBuildPriority priority) {
+    buildPriority = priority;
+  }
                    
 #if defined(TASKING_INTERNAL)
 
@@ -781,7 +1235,7 @@ namespace embree
       scheduler = this->scheduler;
       if (scheduler == null) {
         buildLock.lock();
-        this->scheduler = scheduler = new TaskScheduler;
+        this->scheduler = scheduler = new TaskScheduler(buildThreads,int(buildPriority)-int(RTC_BUILD_PRIORITY_NORMAL));
       }
     }
 
@@ -860,7 +1314,10 @@ namespace embree
 #else
       tbb::task_group_context ctx( tbb::task_group_context::isolated, tbb::task_group_context::default_traits | tbb::task_group_context::fp_settings );
 #endif
-      //ctx.set_priority(tbb::priority_high);
+#if TBB_INTERFACE_VERSION < 12000 && __TBB_TASK_PRIORITY
+      static const tbb::priority_t priorities[] = { tbb::priority_low, tbb::priority_normal, tbb::priority_high };
+      ctx.set_priority(priorities[buildPriority]);
+#endif
 
 #if USE_TASK_ARENA
       if (join)
@@ -872,6 +1329,23 @@ namespace embree
             group->wait();
           });
       }
+      else if (buildThreads != 0 || buildPriority != RTC_BUILD_PRIORITY_NORMAL)
+      {
+        /* commits with a thread budget or priority build in their own arena */
+        const int maxThreads = buildThreads ? (int) min(size_t(buildThreads),TaskScheduler::threadCount()) : tbb::task_arena::automatic;
+#if TBB_INTERFACE_VERSION >= 12000
+        static const tbb::task_arena::priority priorities[] = { tbb::task_arena::priority::low, tbb::task_arena::priority::normal, tbb::task_arena::priority::high };
+        tbb::task_arena arena(maxThreads,1,priorities[buildPriority]);
+#else
+        tbb::task_arena arena(maxThreads,1);
+#endif
+        arena.execute([&]{
+            group->run([&]{
+                tbb::parallel_for (size_t(0), size_t(1), size_t(1), [&] (size_t) { commit_task(); }, ctx);
+              });
+            group->wait();
+          });
+      }
       else
 #endif
       {
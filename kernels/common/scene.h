@@ -33,6 +33,8 @@
 
 #include "acceln.h"
 #include "geometry.h"
+#include "epoch.h"
+#include "../../common/sys/segmented_vector.h"
 
 namespace embree
 {
@@ -55,6 +57,7 @@ namespace embree
       {
         Geometry* geom = scene->geometries[i].ptr;
         if (geom == nullptr) return nullptr;
+        if (scene->isGeometryHidden(i)) return nullptr;
         if (!all && !geom->isEnabled()) return nullptr;
         const size_t mask = geom->getTypeMask() & Ty::geom_type; 
         if (!(mask)) return nullptr;
@@ -124,6 +127,7 @@ namespace embree
       {
         Geometry* geom = scene->geometries[i].ptr;
         if (geom == nullptr) return nullptr;
+        if (scene->isGeometryHidden(i)) return nullptr;
         if (!geom->isEnabled()) return nullptr;
         if (!(geom->getTypeMask() & typemask)) return nullptr;
         if ((geom->numTimeSteps != 1) != mblur) return nullptr;
@@ -189,11 +193,51 @@ namespace embree
     
     void setSceneFlags(RTCSceneFlags scene_flags);
     RTCSceneFlags getSceneFlags() const;
+
+    void setBuildArguments(const RTCBuildArguments& arguments);
+
+    void setBuildThreads(size_t maxThreads);
+    void setBuildPriority(RTCBuildPriority priority);
     
     void commit (bool join);
     void commit_task ();
     void build () {}
 
+    /*! commits the scene in a background thread, rays keep traversing the previously committed acceleration structures */
+    void commitAsync ();
+
+    /*! waits for a background commit to finish and reports its errors */
+    void waitCommitAsync ();
+
+    /*! accumulates statistics of some acceleration structure build of the current commit */
+    void addBuildStatistics (const RTCSceneBuildStatistics& stat);
+
+    /*! returns statistics of the last commit */
+    RTCSceneBuildStatistics getBuildStatistics ();
+
+    /*! sets how many single rays of each thread get traced per sampled ray, zero disables sampling */
+    void setTraversalStatisticsRate (unsigned int rate);
+
+    /*! returns true if the traversal steps of the next ray traced with this context should get counted */
+    __forceinline bool sampleTraversal (const RTCIntersectContext* context)
+    {
+      if (likely(traversalStatisticsRate.load(std::memory_order_relaxed) == 0 && !(context->flags & RTC_INTERSECT_CONTEXT_FLAG_TRAVERSAL_STATISTICS)))
+        return false;
+      return sampleTraversalRate(context);
+    }
+
+    /*! accumulates the counters of a sampled ray */
+    void addTraversalCounters (const TraversalCounters& counters);
+
+    /*! sums the counters of all threads */
+    RTCTraversalStatistics getTraversalStatistics ();
+
+    /*! clears the counters of all threads */
+    void resetTraversalStatistics ();
+
+    /*! searches the build arguments with the lowest trace cost and commits the scene with them */
+    void autotune(const RTCAutotuneArguments& args);
+
     void updateInterface();
 
     /* return number of geometries */
@@ -214,6 +258,7 @@ namespace embree
     {
       Ref<Geometry>& g = geometries[geomID];
       if (!g) return false;
+      if (isGeometryHidden(geomID)) return false;
       if (!g->isEnabled()) return false;
       return g->getModCounter() > geometryModCounters_[geomID];
     }
@@ -256,14 +301,15 @@ namespace embree
     __forceinline Mesh* getSafe(size_t i) {
       assert(i < geometries.size());
       if (geometries[i] == null) return nullptr;
+      if (isGeometryHidden(i)) return nullptr;
       if (!(geometries[i]->getTypeMask() & Mesh::geom_type)) return nullptr;
       else return (Mesh*) geometries[i].ptr;
     }
 
-    __forceinline Ref<Geometry> get_locked(size_t i)  {
-      Lock<SpinLock> lock(geometriesMutex);
-      assert(i < geometries.size()); 
-      return geometries[i]; 
+    /* geometries that builds have to skip, as they get attached or detached right now */
+    __forceinline bool isGeometryHidden(size_t i) const {
+      const char slot = geometrySlots_[i];
+      return slot != SLOT_VISIBLE && slot != SLOT_DETACHED;
     }
 
     /* flag decoding */
@@ -272,6 +318,7 @@ namespace embree
     __forceinline bool isRobustAccel()  const { return scene_flags & RTC_SCENE_FLAG_ROBUST; }
     __forceinline bool isStaticAccel()  const { return !(scene_flags & RTC_SCENE_FLAG_DYNAMIC); }
     __forceinline bool isDynamicAccel() const { return scene_flags & RTC_SCENE_FLAG_DYNAMIC; }
+    __forceinline bool isAsyncCommit()  const { return scene_flags & RTC_SCENE_FLAG_ASYNC_COMMIT; }
     
     __forceinline bool hasContextFilterFunction() const {
       return scene_flags & RTC_SCENE_FLAG_CONTEXT_FILTER_FUNCTION;
@@ -289,10 +336,23 @@ namespace embree
     __forceinline bool isBuild() const { return is_build; }
 
   public:
-    IDPool<unsigned,0xFFFFFFFE> id_pool;
-    vector<Ref<Geometry>> geometries; //!< list of all user geometries
-    vector<unsigned int> geometryModCounters_;
-    vector<float*> vertices;
+    /* the geometry tables never move their items, thus geometries can get attached and detached while other threads read the tables */
+    segmented_vector<Ref<Geometry>> geometries; //!< list of all user geometries
+    segmented_vector<unsigned int> geometryModCounters_;
+    segmented_vector<float*> vertices;
+
+    /* state of a geometry slot, only asynchronous commit scenes use the attached, detached and removed states */
+    enum GeometrySlot : char
+    {
+      SLOT_FREE     = 0, //!< no geometry uses the slot
+      SLOT_BINDING  = 1, //!< claimed by a geometry that gets attached right now
+      SLOT_VISIBLE  = 2, //!< geometry is part of builds
+      SLOT_ATTACHED = 3, //!< attached while the previous build may run, becomes visible to the next build
+      SLOT_DETACHED = 4, //!< detached while the previous build may run, gets removed by the next build
+      SLOT_REMOVED  = 5  //!< removed from builds, the slot is released once no ray can reach the geometry anymore
+    };
+    segmented_vector<std::atomic<char>> geometrySlots_;
+    std::atomic<unsigned int> firstFreeGeometrySlot; //!< all slots below are in use
     
   public:
     Device* device;
@@ -303,12 +363,78 @@ namespace embree
     
     RTCSceneFlags scene_flags;
     RTCBuildQuality quality_flags;
-    RTCBuildArguments buildArguments;
+    RTCBuildArguments buildArguments; //!< per scene builder overrides, a byteSize of zero keeps the builder defaults
+    std::atomic<size_t> buildThreads;      //!< maximal number of threads used by commits, zero uses all threads
+    std::atomic<RTCBuildPriority> buildPriority; //!< priority of commits when sharing threads with other commits
+    RTCSceneBuildStatistics buildStatistics; //!< statistics of the last commit if enabled through the device
+    SpinLock buildStatisticsMutex;
+    std::atomic<unsigned int> traversalStatisticsRate; //!< every n-th single ray of a thread gets counted, zero disables sampling
     MutexSys buildMutex;
-    SpinLock geometriesMutex;
     bool is_build;
   
-    bool modified;                   //!< true if scene got modified    
+    std::atomic<bool> modified;      //!< true if scene got modified    
+
+  private:
+    /*! acceleration structures of asynchronous commit scenes and the geometry state they got built for */
+    struct AsyncAccel : public AccelN
+    {
+      std::vector<Ref<Geometry>> geometries;  //!< referenced, thus no other geometry can reuse their address
+      std::vector<unsigned int> modCounters;
+      unsigned int enabledGeometryTypes;
+    };
+
+    /*! makes freshly built acceleration structures visible to ray queries */
+    void publishAsync (AsyncAccel* accel);
+
+    /*! continues building on retired structures, only geometries modified since their build get rebuilt */
+    void reuseAsync (AsyncAccel* accel);
+    static void commitAsyncThread (void* ptr);
+
+    /*! grows all geometry tables to at least N slots */
+    void growGeometryTables (size_t N);
+
+    /*! claims the first free geometry slot */
+    unsigned int allocateGeometrySlot ();
+
+    /*! releases the slot of a detached geometry */
+    void releaseGeometrySlot (size_t geomID);
+
+    static void intersectAsync (Accel::Intersectors* This, RTCRayHit& ray, IntersectContext* context);
+    static void intersectAsync4 (const void* valid, Accel::Intersectors* This, RTCRayHit4& ray, IntersectContext* context);
+    static void intersectAsync8 (const void* valid, Accel::Intersectors* This, RTCRayHit8& ray, IntersectContext* context);
+    static void intersectAsync16 (const void* valid, Accel::Intersectors* This, RTCRayHit16& ray, IntersectContext* context);
+    static void intersectAsyncN (Accel::Intersectors* This, RTCRayHitN** ray, const size_t N, IntersectContext* context);
+    static void occludedAsync (Accel::Intersectors* This, RTCRay& ray, IntersectContext* context);
+    static void occludedAsync4 (const void* valid, Accel::Intersectors* This, RTCRay4& ray, IntersectContext* context);
+    static void occludedAsync8 (const void* valid, Accel::Intersectors* This, RTCRay8& ray, IntersectContext* context);
+    static void occludedAsync16 (const void* valid, Accel::Intersectors* This, RTCRay16& ray, IntersectContext* context);
+    static void occludedAsyncN (Accel::Intersectors* This, RTCRayN** ray, const size_t N, IntersectContext* context);
+    static bool pointQueryAsync (Accel::Intersectors* This, PointQuery* query, PointQueryContext* context);
+    static size_t pointQueryPacketAsync (Accel::Intersectors* This, size_t valid, PointQuery** query, PointQueryContext** context);
+    static void knnQueryAsync (Accel::Intersectors* This, PointQuery* query, KNNHeap* heap);
+
+    bool sampleTraversalRate (const RTCIntersectContext* context);
+
+    /*! traversal counters of the threads hashing to the same slot, padded to avoid false sharing */
+    struct __aligned(64) TraversalStatisticsSlot
+    {
+      std::atomic<size_t> rays;
+      std::atomic<size_t> nodes;
+      std::atomic<size_t> leaves;
+      std::atomic<size_t> prims;
+      std::atomic<size_t> filters;
+    };
+    static const size_t NUM_TRAVERSAL_STATISTICS_SLOTS = 64;
+    std::atomic<TraversalStatisticsSlot*> traversalStatisticsSlots; //!< allocated by the first sampled ray
+
+    /* double buffered acceleration structures of RTC_SCENE_FLAG_ASYNC_COMMIT scenes */
+    std::atomic<AsyncAccel*> asyncFront; //!< acceleration structures traversed by ray queries
+    std::atomic<AsyncAccel*> asyncSpare; //!< retired front structures no ray query accesses anymore, the next commit builds into them
+    Epochs epochs;                   //!< releases structures and tables once no ray query can access them anymore
+    std::vector<size_t> asyncRemoved; //!< geometries removed from the running build
+    MutexSys asyncMutex;
+    thread_t asyncThread;            //!< background commit thread
+    std::exception_ptr asyncError;   //!< error of the last background commit
   public:
     
     /*! global lock step task scheduler */
@@ -23,6 +23,8 @@
 #include "../subdiv/catmullrom_curve.h"
 #include "../subdiv/linear_bezier_patch.h"
 
+#include "../../common/algorithms/parallel_reduce.h"
+
 namespace embree
 {
 #if defined(EMBREE_LOWEST_ISA)
@@ -43,7 +45,7 @@ namespace embree
   }
 
   CurveGeometry::CurveGeometry (Device* device, GType gtype)
-    : Geometry(device,gtype,0,1), tessellationRate(4)
+    : Geometry(device,gtype,0,1), tessellationRate(4), userTessellationRate(4)
   {
     resizeBuffers(numTimeSteps);
   }
@@ -264,7 +266,47 @@ namespace embree
 
   void CurveGeometry::setTessellationRate(float N)
   {
-    tessellationRate = clamp((int)N,1,16);
+    userTessellationRate = tessellationRate = clamp((int)N,1,16);
+  }
+
+  void CurveGeometry::setTessellationCamera(const RTCTessellationCamera* camera)
+  {
+    this->camera = camera ? TessellationCamera(*camera) : TessellationCamera();
+  }
+
+  int CurveGeometry::calculateCameraTessellationRate() const
+  {
+    /* hermite curves are measured along their end points, all other bases along the control polygon */
+    const bool hermite = getCurveBasis() == GTY_BASIS_HERMITE;
+    const unsigned int numControlPoints = hermite ? 2 : 4;
+    const vfloat4 behind(neg_inf);
+
+    const float level = parallel_reduce(size_t(0), size(), size_t(1024), 0.0f, [&] (const range<size_t>& r) -> float
+    {
+      float maxLevel = 0.0f;
+      for (size_t i=r.begin(); i<r.end(); i++)
+      {
+        const unsigned int index = curve(i);
+        if (size_t(index)+numControlPoints > numVertices()) continue;
+
+        Vec3vf4 p0(zero), p1(zero);
+        for (unsigned int k=0; k<numControlPoints-1; k++)
+        {
+          const Vec3fa q0 = vertex(index+k+0);
+          const Vec3fa q1 = vertex(index+k+1);
+          p0.x[k] = q0.x; p0.y[k] = q0.y; p0.z[k] = q0.z;
+          p1.x[k] = q1.x; p1.y[k] = q1.y; p1.z[k] = q1.z;
+        }
+
+        /* curves that cross the camera plane keep the rate specified by the user */
+        const vfloat4 levels = select(vint4(step) < vint4(numControlPoints-1),camera.edgeLevel(p0,p1,behind),vfloat4(zero));
+        const float l = reduce_add(levels);
+        maxLevel = max(maxLevel, l >= 0.0f ? l : float(userTessellationRate));
+      }
+      return maxLevel;
+    }, [](const float a, const float b) { return max(a,b); });
+
+    return clamp((int)ceilf(level),1,16);
   }
 
   void CurveGeometry::addElementsToCount (GeometryCounts & counts) const 
@@ -383,6 +425,8 @@ namespace embree
     if (getCurveBasis() == GTY_BASIS_HERMITE)
       tangents0 = tangents[0];
 
+    tessellationRate = camera.isEnabled() ? calculateCameraTessellationRate() : userTessellationRate;
+
     Geometry::commit();
   }
 
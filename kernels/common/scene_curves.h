@@ -19,6 +19,7 @@
 #include "default.h"
 #include "geometry.h"
 #include "buffer.h"
+#include "tessellation_camera.h"
 
 namespace embree
 {
@@ -43,6 +44,7 @@ namespace embree
     void commit();
     bool verify();
     void setTessellationRate(float N);
+    void setTessellationCamera(const RTCTessellationCamera* camera);
     void addElementsToCount (GeometryCounts & counts) const;
 
   public:
@@ -333,6 +335,7 @@ namespace embree
 
   private:
     void resizeBuffers(unsigned int numSteps);
+    int calculateCameraTessellationRate() const;
 
   public:
     BufferView<unsigned int> curves;        //!< array of curve indices
@@ -347,6 +350,8 @@ namespace embree
     BufferView<char> flags;                 //!< start, end flag per segment
     vector<BufferView<char>> vertexAttribs; //!< user buffers
     int tessellationRate;                   //!< tessellation rate for bezier curve
+    int userTessellationRate;               //!< tessellation rate set through rtcSetGeometryTessellationRate
+    TessellationCamera camera;              //!< camera for view dependent tessellation rate
   };
   
   DECLARE_ISA_FUNCTION(CurveGeometry*, createCurves, Device* COMMA Geometry::GType);
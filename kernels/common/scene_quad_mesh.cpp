@@ -147,6 +147,21 @@ namespace embree
     Geometry::update();
   }
 
+  void QuadMesh::updateBufferRange(RTCBufferType type, unsigned int slot, size_t itemOffset, size_t itemCount)
+  {
+    /* modified indices change the topology, thus only vertex ranges are tracked */
+    if (type != RTC_BUFFER_TYPE_VERTEX) {
+      updateBuffer(type,slot);
+      return;
+    }
+
+    if (slot >= vertices.size())
+      throw_RTCError(RTC_ERROR_INVALID_ARGUMENT, "invalid buffer slot");
+    vertices[slot].setModified(itemOffset,itemOffset+itemCount);
+
+    Geometry::update();
+  }
+
   void QuadMesh::commit() 
   {
     /* verify that stride of all time steps are identical */
@@ -38,6 +38,7 @@ namespace embree
       faceStartEdge(device,0),
       halfEdgeFace(device,0),
       invalid_face(device,0),
+      cameraLevels(device,0),
       commitCounter(0)
   {
     
@@ -372,6 +373,12 @@ namespace embree
     levels.setModified();
   }
 
+  void SubdivMesh::setTessellationCamera(const RTCTessellationCamera* camera)
+  {
+    this->camera = camera ? TessellationCamera(*camera) : TessellationCamera();
+    levels.setModified();
+  }
+
   __forceinline uint64_t pair64(unsigned int x, unsigned int y) 
   {
     if (x<y) std::swap(x,y);
@@ -684,6 +691,40 @@ namespace embree
               << std::endl;
   }
 
+  void SubdivMesh::calculateCameraLevels ()
+  {
+    cameraLevels.resize(numHalfEdges);
+
+    const BufferView<unsigned int>& indices = topology[0].vertexIndices;
+    const vfloat4 defaultLevel = clamp(tessellationRate,1.0f,4096.0f);
+
+    /* edges are processed in blocks of 4, edges that reference invalid vertices get the default level */
+    parallel_for( size_t(0), numHalfEdges, size_t(4096), [&](const range<size_t>& r) 
+    {
+      for (size_t i=r.begin(); i<r.end(); i+=4)
+      {
+        const size_t N = min(r.end()-i,size_t(4));
+        Vec3vf4 p0(zero), p1(zero);
+        vint4 valid(zero);
+        for (size_t k=0; k<N; k++)
+        {
+          const size_t e = i+k;
+          const size_t f = halfEdgeFace[e];
+          const size_t e1 = faceStartEdge[f] + (e-faceStartEdge[f]+1)%faceVertices[f];
+          const unsigned int v0 = indices[e], v1 = indices[e1];
+          if (v0 >= numVertices() || v1 >= numVertices()) continue;
+          const Vec3fa q0 = vertices[0][v0], q1 = vertices[0][v1];
+          p0.x[k] = q0.x; p0.y[k] = q0.y; p0.z[k] = q0.z;
+          p1.x[k] = q1.x; p1.y[k] = q1.y; p1.z[k] = q1.z;
+          valid[k] = 1;
+        }
+        const vfloat4 level = select(valid != vint4(zero),clamp(camera.edgeLevel(p0,p1,defaultLevel),vfloat4(1.0f),vfloat4(4096.0f)),defaultLevel);
+        for (size_t k=0; k<N; k++)
+          cameraLevels[i+k] = level[k];
+      }
+    });
+  }
+
   void SubdivMesh::initializeHalfEdgeStructures ()
   {
     double t0 = getSeconds();
@@ -716,6 +757,15 @@ namespace embree
     if (holes.isLocalModified())
       holeSet.init(holes);
 
+    /* view dependent edge levels change with the vertices */
+    if (camera.isEnabled())
+    {
+      if (vertices[0].isLocalModified() || faceVertices.isLocalModified() || topology[0].vertexIndices.isLocalModified())
+        levels.setModified();
+      if (levels.isLocalModified())
+        calculateCameraLevels();
+    }
+
     /* create topology */
     for (auto& t: topology)
       t.initializeHalfEdgeStructures();
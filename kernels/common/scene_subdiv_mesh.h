@@ -18,6 +18,7 @@
 
 #include "geometry.h"
 #include "buffer.h"
+#include "tessellation_camera.h"
 #include "../subdiv/half_edge.h"
 #include "../subdiv/tessellation_cache.h"
 #include "../subdiv/catmullclark_coefficients.h"
@@ -74,6 +75,7 @@ namespace embree
     void* getBuffer(RTCBufferType type, unsigned int slot);
     void updateBuffer(RTCBufferType type, unsigned int slot);
     void setTessellationRate(float N);
+    void setTessellationCamera(const RTCTessellationCamera* camera);
     bool verify();
     void commit();
     void addElementsToCount (GeometryCounts & counts) const;
@@ -121,6 +123,9 @@ namespace embree
 
     /*! initializes the half edge data structure */
     void initializeHalfEdgeStructures ();
+
+    /*! calculates the edge levels of all half edges from the tessellation camera */
+    void calculateCameraLevels ();
  
   public:
 
@@ -132,10 +137,16 @@ namespace embree
     /* returns tessellation level of edge */
     __forceinline float getEdgeLevel(const size_t i) const
     {
+      if (camera.isEnabled()) return cameraLevels[i];
       if (levels) return clamp(levels[i],1.0f,4096.0f); // FIXME: do we want to limit edge level?
       else return clamp(tessellationRate,1.0f,4096.0f); // FIXME: do we want to limit edge level?
     }
 
+    /*! returns the number of geometry commits, used as epoch of tessellation cache entries */
+    __forceinline size_t getCommitCounter() const {
+      return commitCounter;
+    }
+
   public:
     RTCDisplacementFunctionN displFunc;    //!< displacement function
 
@@ -269,6 +280,9 @@ namespace embree
     BufferView<float> levels;
     float tessellationRate;  // constant rate that is used when levels is not set
 
+    /*! camera for view dependent tessellation, overrides levels and tessellationRate when enabled */
+    TessellationCamera camera;
+
     /*! buffer that marks specific faces as holes */
     BufferView<unsigned> holes;
 
@@ -290,6 +304,9 @@ namespace embree
     /*! fast lookup table to detect invalid faces */
     mvector<char> invalid_face;
 
+    /*! edge levels calculated from the tessellation camera */
+    mvector<float> cameraLevels;
+
     /*! test if face i is invalid in timestep j */
     __forceinline       char& invalidFace(size_t i, size_t j = 0)       { return invalid_face[i*numTimeSteps+j]; }
     __forceinline const char& invalidFace(size_t i, size_t j = 0) const { return invalid_face[i*numTimeSteps+j]; }
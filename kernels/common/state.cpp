@@ -98,6 +98,7 @@ namespace embree
     useSpatialPreSplits = false;
 
     tessellation_cache_size = 128*1024*1024;
+    bvh_cache = "";
 
     subdiv_accel = "default";
     subdiv_accel_mb = "default";
@@ -119,6 +120,9 @@ namespace embree
     scene_flags = -1;
     verbose = 0;
     benchmark = 0;
+    build_statistics = false;
+    stream_sort = STREAM_SORT_OCTANT;
+    stream_sort_batch_size = 0;
 
     numThreads = 0;
     numUserThreads = 0;
@@ -144,6 +148,7 @@ namespace embree
     alloc_num_main_slots = 0;
     alloc_thread_block_size = 0;
     alloc_single_thread_alloc = -1;
+    numa = false;
 
     error_function = nullptr;
     error_function_userptr = nullptr;
@@ -292,6 +297,9 @@ namespace embree
       else if (tok == Token::Id("hugepages") && cin->trySymbol("=")) {
         hugepages = cin->get().Int();
       }
+      else if (tok == Token::Id("numa") && cin->trySymbol("=")) {
+        numa = cin->get().Int() != 0;
+      }
 
       else if (tok == Token::Id("ignore_config_files") && cin->trySymbol("="))
         ignore_config_files = cin->get().Int();
@@ -401,6 +409,8 @@ namespace embree
         verbose = cin->get().Int();
       else if (tok == Token::Id("benchmark") && cin->trySymbol("="))
         benchmark = cin->get().Int();
+      else if (tok == Token::Id("build_statistics") && cin->trySymbol("="))
+        build_statistics = cin->get().Int() != 0;
       
       else if (tok == Token::Id("quality")) {
         if (cin->trySymbol("=")) {
@@ -433,6 +443,17 @@ namespace embree
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
       else if (tok == Token::Id("cache_size") && cin->trySymbol("="))
         tessellation_cache_size = size_t(cin->get().Float()*1024.0f*1024.0f);
+      else if (tok == Token::Id("bvh_cache") && cin->trySymbol("="))
+        bvh_cache = cin->get().String();
+
+      else if (tok == Token::Id("stream_sort") && cin->trySymbol("=")) {
+        std::string mode = cin->get().Identifier();
+        if      (mode == "octant")    stream_sort = STREAM_SORT_OCTANT;
+        else if (mode == "morton")    stream_sort = STREAM_SORT_MORTON;
+        else if (mode == "direction") stream_sort = STREAM_SORT_DIRECTION;
+      }
+      else if (tok == Token::Id("stream_sort_batch_size") && cin->trySymbol("="))
+        stream_sort_batch_size = cin->get().Int();
 
       else if (tok == Token::Id("alloc_main_block_size") && cin->trySymbol("="))
         alloc_main_block_size = cin->get().Int();
@@ -470,10 +491,21 @@ namespace embree
     if (!hugepages) std::cout << "disabled" << std::endl;
     else if (hugepages_success) std::cout << "enabled" << std::endl;
     else std::cout << "failed" << std::endl;
+    std::cout << "  numa               = " << numa << std::endl;
 
     std::cout << "  verbosity          = " << verbose << std::endl;
+    std::cout << "  build_statistics   = " << build_statistics << std::endl;
     std::cout << "  cache_size         = " << float(tessellation_cache_size)*1E-6 << " MB" << std::endl;
     std::cout << "  max_spatial_split_replications = " << max_spatial_split_replications << std::endl;
+    std::cout << "  bvh_cache          = " << (bvh_cache == "" ? "disabled" : bvh_cache) << std::endl;
+    std::cout << "  stream_sort        = ";
+    switch (stream_sort) {
+    case STREAM_SORT_OCTANT   : std::cout << "octant" << std::endl; break;
+    case STREAM_SORT_MORTON   : std::cout << "morton" << std::endl; break;
+    case STREAM_SORT_DIRECTION: std::cout << "direction" << std::endl; break;
+    default: std::cout << "error" << std::endl; break;
+    }
+    std::cout << "  stream_sort_batch_size = " << stream_sort_batch_size << std::endl;
     
     std::cout << "triangles:" << std::endl;
     std::cout << "  accel              = " << tri_accel << std::endl;
@@ -119,6 +119,15 @@ namespace embree
     float max_spatial_split_replications;  //!< maximally replications*N many primitives in accel for spatial splits
     bool useSpatialPreSplits;              //!< use spatial pre-splits instead of the full spatial split builder
     size_t tessellation_cache_size;        //!< size of the shared tessellation cache 
+    std::string bvh_cache;                 //!< directory of the persistent BVH cache, empty disables the cache
+
+  public:
+    enum STREAM_SORT {
+      STREAM_SORT_OCTANT,
+      STREAM_SORT_MORTON,
+      STREAM_SORT_DIRECTION
+    } stream_sort;                         //!< reordering of incoherent ray streams (default is OCTANT)
+    size_t stream_sort_batch_size;         //!< number of stream rays reordered together, 0 reorders the whole stream
 
   public:
     size_t instancing_open_min;            //!< instancing opens tree to minimally that number of subtrees
@@ -134,6 +143,7 @@ namespace embree
     int scene_flags;
     size_t verbose;                        //!< verbosity of output
     size_t benchmark;                      //!< true
+    bool build_statistics;                 //!< gathers timings and sizes of each scene commit
     
   public:
     size_t numThreads;                     //!< number of threads to use in builders
@@ -156,6 +166,7 @@ namespace embree
     int alloc_num_main_slots;              //!< number of such shared blocks to be used to allocate
     size_t alloc_thread_block_size;        //!< size of thread local allocator block size
     int alloc_single_thread_alloc;         //!< in single mode nodes and leaves use same thread local allocator
+    bool numa;                             //!< allocates BVH blocks on the NUMA node of the building thread and replicates BVH top levels per node
 
   public:
 
@@ -0,0 +1,72 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "default.h"
+
+namespace embree
+{
+  /*! Calculates view dependent tessellation levels from the projected
+   *  length of edges, see rtcSetGeometryTessellationCamera. */
+  struct TessellationCamera
+  {
+    __forceinline TessellationCamera () 
+      : enabled(false) {}
+
+    __forceinline TessellationCamera (const RTCTessellationCamera& camera)
+      : enabled(true)
+    {
+      /* scale the x and y rows such that projected lengths are measured in target edge lengths */
+      const float* m = camera.viewProjection;
+      const float sx = 0.5f*float(camera.width)/camera.edgeLength;
+      const float sy = 0.5f*float(camera.height)/camera.edgeLength;
+      row_x = Vec4f(m[0],m[4],m[8],m[12])*sx;
+      row_y = Vec4f(m[1],m[5],m[9],m[13])*sy;
+      row_w = Vec4f(m[3],m[7],m[11],m[15]);
+    }
+
+    __forceinline bool isEnabled() const {
+      return enabled;
+    }
+
+    template<typename vfloat>
+    static __forceinline vfloat dot(const Vec4f& row, const Vec3<vfloat>& p) {
+      return madd(vfloat(row.x),p.x,madd(vfloat(row.y),p.y,madd(vfloat(row.z),p.z,vfloat(row.w))));
+    }
+
+    /*! returns the projected length of the edges p0-p1 in target edge
+     *  lengths, edges not fully in front of the camera get the default level */
+    template<typename vfloat>
+    __forceinline vfloat edgeLevel(const Vec3<vfloat>& p0, const Vec3<vfloat>& p1, const vfloat& defaultLevel) const
+    {
+      const vfloat w0 = dot(row_w,p0);
+      const vfloat w1 = dot(row_w,p1);
+      const auto valid = (w0 > vfloat(zero)) & (w1 > vfloat(zero));
+      const vfloat rcp_w0 = vfloat(one)/select(valid,w0,vfloat(one));
+      const vfloat rcp_w1 = vfloat(one)/select(valid,w1,vfloat(one));
+      const vfloat dx = dot(row_x,p1)*rcp_w1 - dot(row_x,p0)*rcp_w0;
+      const vfloat dy = dot(row_y,p1)*rcp_w1 - dot(row_y,p0)*rcp_w0;
+      return select(valid,sqrt(dx*dx+dy*dy),defaultLevel);
+    }
+
+  private:
+    bool enabled;
+    Vec4f row_x;
+    Vec4f row_y;
+    Vec4f row_w;
+  };
+}
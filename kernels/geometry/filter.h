@@ -30,6 +30,7 @@ namespace embree
       if (geometry->intersectionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        if (unlikely(context->counters)) context->counters->filters++;
         geometry->intersectionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -38,6 +39,7 @@ namespace embree
             
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        if (unlikely(context->counters)) context->counters->filters++;
         context->user->filter(args);
 
         if (args->valid[0] == 0)
@@ -86,6 +88,7 @@ namespace embree
       if (geometry->occlusionFilterN)
       {
         assert(context->scene->hasGeometryFilterFunction());
+        if (unlikely(context->counters)) context->counters->filters++;
         geometry->occlusionFilterN(args);
 
         if (args->valid[0] == 0)
@@ -94,6 +97,7 @@ namespace embree
       
       if (context->user->filter) {
         assert(context->scene->hasContextFilterFunction());
+        if (unlikely(context->counters)) context->counters->filters++;
         context->user->filter(args);
 
         if (args->valid[0] == 0)
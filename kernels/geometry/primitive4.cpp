@@ -23,6 +23,7 @@
 #include "trianglev.h"
 #include "trianglev_mb.h"
 #include "trianglei.h"
+#include "trianglec.h"
 #include "quadv.h"
 #include "quadi.h"
 #include "subdivpatch1.h"
@@ -222,6 +223,28 @@ namespace embree
     return sizeof(Triangle4i);
   }
 
+  /********************** Triangle4c **************************/
+
+  template<>
+  const char* Triangle4c::Type::name () const {
+    return "triangle4c";
+  }
+
+  template<>
+  size_t Triangle4c::Type::sizeActive(const char* This) const {
+    return ((Triangle4c*)This)->size();
+  }
+
+  template<>
+  size_t Triangle4c::Type::sizeTotal(const char* This) const {
+    return 4;
+  }
+
+  template<>
+  size_t Triangle4c::Type::getBytes(const char* This) const {
+    return sizeof(Triangle4c);
+  }
+
   /********************** Triangle4vMB **************************/
 
   template<>
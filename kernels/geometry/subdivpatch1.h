@@ -48,4 +48,17 @@ namespace embree
                         const int simd_width) 
       : SubdivPatch1Base(gID,pID,subPatch,mesh,time,uv,edge_level,subdiv,simd_width) {}
   };
+
+  /*! Subgrid of a subdivision patch that gets tessellated on first
+   *  hit into the shared lazy tessellation cache. */
+  struct SubdivPatch1Lazy
+  {
+    __forceinline SubdivPatch1Lazy (const SubdivPatch1* patch, unsigned x0, unsigned x1, unsigned y0, unsigned y1)
+      : patch(patch), x0((unsigned short)x0), x1((unsigned short)x1), y0((unsigned short)y0), y1((unsigned short)y1) {}
+
+  public:
+    SharedLazyTessellationCache::CacheEntry entry; //!< cache entry of the tessellated grid
+    const SubdivPatch1* patch;                     //!< patch this subgrid belongs to
+    unsigned short x0,x1,y0,y1;                    //!< grid range of this subgrid
+  };
 }
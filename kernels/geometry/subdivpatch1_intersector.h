@@ -42,6 +42,44 @@ namespace embree
         : T(valid,ray) {}
     };
 
+    template<typename T>
+      class SubdivPatch1LazyPrecalculations : public T
+    { 
+    public:
+      __forceinline SubdivPatch1LazyPrecalculations (const Ray& ray, const void* ptr)
+        : T(ray,ptr) {}
+
+      /* the last visited grid stays locked in the tessellation cache until traversal is done */
+      __forceinline ~SubdivPatch1LazyPrecalculations() {
+        if (this->grid) SharedLazyTessellationCache::unlock();
+      }
+    };
+
+    template<int K, typename T>
+      class SubdivPatch1LazyPrecalculationsK : public T
+    { 
+    public:
+      __forceinline SubdivPatch1LazyPrecalculationsK (const vbool<K>& valid, RayK<K>& ray)
+        : T(valid,ray) {}
+
+      __forceinline ~SubdivPatch1LazyPrecalculationsK() {
+        if (this->grid) SharedLazyTessellationCache::unlock();
+      }
+    };
+
+    /*! Returns the grid of a lazy subgrid from the tessellation cache,
+     *  tessellates the subgrid on a cache miss. The calling thread
+     *  holds a lock of the cache until the grid is released. */
+    static __forceinline GridSOA* lookupLazyGrid(const Accel::Intersectors* This, const SubdivPatch1Lazy* prim)
+    {
+      const Scene* scene = ((BVH4*)This->ptr)->scene;
+      const SubdivMesh* mesh = scene->get<SubdivMesh>(prim->patch->geomID());
+      return SharedLazyTessellationCache::lookup(((SubdivPatch1Lazy*)prim)->entry,mesh->getCommitCounter(),[&] () {
+          auto alloc = [] (size_t bytes) { return SharedLazyTessellationCache::malloc(bytes); };
+          return GridSOA::create(prim->patch,1,prim->x0,prim->x1,prim->y0,prim->y1,scene,alloc);
+        });
+    }
+
     class SubdivPatch1Intersector1
     {
     public:
@@ -95,6 +133,60 @@ namespace embree
       }
     };
 
+    class SubdivPatch1LazyIntersector1
+    {
+    public:
+      typedef SubdivPatch1Lazy Primitive;
+      typedef SubdivPatch1LazyPrecalculations<GridSOAIntersector1::Precalculations> Precalculations;
+
+      static __forceinline bool processLazyNode(const Accel::Intersectors* This, Precalculations& pre, const Primitive* prim, size_t& lazy_node)
+      {
+        if (pre.grid) SharedLazyTessellationCache::unlock();
+        pre.grid = lookupLazyGrid(This,prim);
+        lazy_node = pre.grid->root(0);
+        return false;
+      }
+
+      /*! Intersect a ray with the primitive. */
+      template<int N, int Nx, bool robust>
+        static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHit& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,Nx,robust> &tray, size_t& lazy_node) 
+      {
+        if (likely(ty == 0)) GridSOAIntersector1::intersect(pre,ray,context,prim,lazy_node);
+        else                 processLazyNode(This,pre,prim,lazy_node);
+      }
+
+      template<int N, int Nx, bool robust>
+      static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHit& ray, IntersectContext* context, size_t ty0, const Primitive* prim, size_t ty, const TravRay<N,Nx,robust> &tray, size_t& lazy_node) {
+        intersect(This,pre,ray,context,prim,ty,tray,lazy_node);
+      }
+      
+      /*! Test if the ray is occluded by the primitive */
+      template<int N, int Nx, bool robust>
+      static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, Ray& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,Nx,robust> &tray, size_t& lazy_node)
+      {
+        if (likely(ty == 0)) return GridSOAIntersector1::occluded(pre,ray,context,prim,lazy_node);
+        else                 return processLazyNode(This,pre,prim,lazy_node);
+      }
+
+      template<int N, int Nx, bool robust>
+      static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, Ray& ray, IntersectContext* context, size_t ty0, const Primitive* prim, size_t ty, const TravRay<N,Nx,robust> &tray, size_t& lazy_node) {
+        return occluded(This,pre,ray,context,prim,ty,tray,lazy_node);
+      }
+      
+      template<int N>
+        static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context, const Primitive* prim, size_t ty, const TravPointQuery<N> &tquery, size_t& lazy_node) 
+      {
+          // TODO: PointQuery implement
+          assert(false && "not implemented");
+          return false;
+      }
+
+      template<int N>
+      static __forceinline bool pointQuery(const Accel::Intersectors* This, PointQuery* query, PointQueryContext* context, size_t ty0, const Primitive* prim, size_t ty, const TravPointQuery<N> &tquery, size_t& lazy_node) {
+        return pointQuery(This,query,context,prim,ty,tquery,lazy_node);
+      }
+    };
+
     class SubdivPatch1MBIntersector1
     {
     public:
@@ -198,6 +290,53 @@ namespace embree
     typedef SubdivPatch1IntersectorK<8>  SubdivPatch1Intersector8;
     typedef SubdivPatch1IntersectorK<16> SubdivPatch1Intersector16;
 
+    template <int K>
+      struct SubdivPatch1LazyIntersectorK
+    {
+      typedef SubdivPatch1Lazy Primitive;
+      typedef SubdivPatch1LazyPrecalculationsK<K,typename GridSOAIntersectorK<K>::Precalculations> Precalculations;
+      
+      static __forceinline bool processLazyNode(const Accel::Intersectors* This, Precalculations& pre, const Primitive* prim, size_t& lazy_node)
+      {
+        if (pre.grid) SharedLazyTessellationCache::unlock();
+        pre.grid = lookupLazyGrid(This,prim);
+        lazy_node = pre.grid->root(0);
+        return false;
+      }
+      
+      template<bool robust>        
+      static __forceinline void intersect(const vbool<K>& valid, const Accel::Intersectors* This, Precalculations& pre, RayHitK<K>& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRayK<K, robust> &tray, size_t& lazy_node)
+      {
+        if (likely(ty == 0)) GridSOAIntersectorK<K>::intersect(valid,pre,ray,context,prim,lazy_node);
+        else                 processLazyNode(This,pre,prim,lazy_node);
+      }
+      
+      template<bool robust>        
+      static __forceinline vbool<K> occluded(const vbool<K>& valid, const Accel::Intersectors* This, Precalculations& pre, RayK<K>& ray, IntersectContext* context, const Primitive* prim, size_t ty, const TravRayK<K, robust> &tray, size_t& lazy_node)
+      {
+        if (likely(ty == 0)) return GridSOAIntersectorK<K>::occluded(valid,pre,ray,context,prim,lazy_node);
+        else                 return processLazyNode(This,pre,prim,lazy_node);
+      }
+      
+      template<int N, int Nx, bool robust>              
+        static __forceinline void intersect(const Accel::Intersectors* This, Precalculations& pre, RayHitK<K>& ray, size_t k, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,Nx,robust> &tray, size_t& lazy_node)
+      {
+        if (likely(ty == 0)) GridSOAIntersectorK<K>::intersect(pre,ray,k,context,prim,lazy_node);
+        else                 processLazyNode(This,pre,prim,lazy_node);
+      }
+      
+      template<int N, int Nx, bool robust>              
+      static __forceinline bool occluded(const Accel::Intersectors* This, Precalculations& pre, RayK<K>& ray, size_t k, IntersectContext* context, const Primitive* prim, size_t ty, const TravRay<N,Nx,robust> &tray, size_t& lazy_node)
+      {
+        if (likely(ty == 0)) return GridSOAIntersectorK<K>::occluded(pre,ray,k,context,prim,lazy_node);
+        else                 return processLazyNode(This,pre,prim,lazy_node);
+      }
+    };
+
+    typedef SubdivPatch1LazyIntersectorK<4>  SubdivPatch1LazyIntersector4;
+    typedef SubdivPatch1LazyIntersectorK<8>  SubdivPatch1LazyIntersector8;
+    typedef SubdivPatch1LazyIntersectorK<16> SubdivPatch1LazyIntersector16;
+
     template <int K>
       struct SubdivPatch1MBIntersectorK
     {
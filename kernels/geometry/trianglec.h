@@ -0,0 +1,282 @@
+// ======================================================================== //
+// Copyright 2009-2020 Intel Corporation                                    //
+//                                                                          //
+// Licensed under the Apache License, Version 2.0 (the "License");          //
+// you may not use this file except in compliance with the License.         //
+// You may obtain a copy of the License at                                  //
+//                                                                          //
+//     http://www.apache.org/licenses/LICENSE-2.0                           //
+//                                                                          //
+// Unless required by applicable law or agreed to in writing, software      //
+// distributed under the License is distributed on an "AS IS" BASIS,        //
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. //
+// See the License for the specific language governing permissions and      //
+// limitations under the License.                                           //
+// ======================================================================== //
+
+#pragma once
+
+#include "primitive.h"
+#include "../common/scene.h"
+
+namespace embree
+{
+  /* Stores up to M triangles of one indexed face set in compressed
+   * form. The geometry ID and a base primitive ID are stored once, the
+   * vertices referenced by the triangles are stored once in a small
+   * vertex cache of 16 bit deltas to a base vertex, and each triangle
+   * references its vertices through 4 bit indices into that cache. If
+   * the vertices of the triangles are too far apart, up to 4 full 32
+   * bit vertex offsets are stored instead. A block stores less than M
+   * triangles if the next triangle does not fit, thus the number of
+   * blocks of a leaf is only known after encoding. */
+  template <int M>
+  struct TriangleMc
+  {
+    /* Virtual interface to query information about the triangle type */
+    struct Type : public PrimitiveType
+    {
+      const char* name() const;
+      size_t sizeActive(const char* This) const;
+      size_t sizeTotal(const char* This) const;
+      size_t getBytes(const char* This) const;
+    };
+    static Type type;
+
+    static const size_t numVertexSlots = 2*M;          //!< vertices of the vertex cache in compact mode
+    static const size_t numWideVertexSlots = M;        //!< vertices of the vertex cache in wide mode
+    static const unsigned int maxPrimIDDelta = 254;    //!< largest primitive ID delta, 255 marks invalid triangles
+    static const unsigned int maxVertexDelta = 65535;  //!< largest vertex delta in compact mode
+    static const unsigned int maxStride = 255;         //!< largest vertex stride in floats in compact mode
+    enum { FLAG_WIDE = 1 };
+
+  public:
+
+    /* primitive supports multiple time segments */
+    static const bool singleTimeSegment = false;
+
+    /* Returns maximum number of stored triangles */
+    static __forceinline size_t max_size() { return M; }
+
+    /* Returns an estimate of the required number of primitive blocks for N primitives */
+    static __forceinline size_t blocks(size_t N) { return (N+max_size()-1)/max_size(); }
+
+    /* Returns the exact number of primitive blocks the primitives get encoded into */
+    template<typename PrimRefT>
+    static __forceinline size_t blocks(const PrimRefT* prims, size_t begin, size_t end, Scene* scene)
+    {
+      size_t num = 0;
+      TriangleMc block;
+      while (begin < end) {
+        begin += block.encode(prims,begin,end,scene);
+        num++;
+      }
+      return num;
+    }
+
+  public:
+
+    /* Default constructor */
+    __forceinline TriangleMc() {}
+
+    /* Returns if the specified triangle is valid */
+    __forceinline bool valid(const size_t i) const { assert(i<M); return primIDDeltas[i] != 0xFF; }
+
+    /* Returns a mask that tells which triangles are valid */
+    __forceinline vbool<M> valid() const { return primID() != vuint<M>(-1); }
+
+    /* Returns the number of stored triangles */
+    __forceinline size_t size() const
+    {
+      size_t n = 0;
+      while (n<M && valid(n)) n++;
+      return n;
+    }
+
+    /* Returns the geometry IDs */
+    __forceinline vuint<M> geomID() const { return vuint<M>(geomID_); }
+    __forceinline unsigned int geomID(const size_t i) const { assert(i<M); return geomID_; }
+
+    /* Returns the primitive IDs */
+    __forceinline vuint<M> primID() const
+    {
+      vuint<M> primIDs;
+      for (size_t i=0; i<M; i++) primIDs[i] = primID(i);
+      return primIDs;
+    }
+    __forceinline unsigned int primID(const size_t i) const {
+      assert(i<M); return valid(i) ? primIDBase + primIDDeltas[i] : (unsigned int)-1;
+    }
+
+    /* Returns the float offset of the k'th vertex of the i'th triangle */
+    __forceinline unsigned int vertexOffset(const size_t i, const size_t k) const
+    {
+      const size_t n = 3*i+k;
+      const unsigned int slot = (vertexIndices[n>>1] >> (4*(n&1))) & 0xF;
+      if (flags & FLAG_WIDE) return cache.offsets[slot];
+      return vertexBase + (unsigned int) cache.deltas[slot] * stride;
+    }
+
+    /* loads the k'th vertex of the i'th triangle */
+    __forceinline const Vec3f& getVertex(const size_t i, const size_t k, const Scene *const scene) const
+    {
+      const float* vertices = scene->vertices[geomID_];
+      return (const Vec3f&) vertices[vertexOffset(i,k)];
+    }
+
+    /* Gather the triangles */
+    __forceinline void gather(Vec3vf<M>& p0, Vec3vf<M>& p1, Vec3vf<M>& p2, const Scene* const scene) const;
+
+    /* Calculate the bounds of the triangles */
+    __forceinline BBox3fa bounds(const Scene *const scene, const size_t itime=0) const
+    {
+      BBox3fa bounds = empty;
+      const float* vertices = (const float*) scene->get<TriangleMesh>(geomID_)->vertexPtr(0,itime);
+      for (size_t i=0; i<M && valid(i); i++)
+        for (size_t k=0; k<3; k++)
+          bounds.extend(Vec3fa::loadu(vertices+vertexOffset(i,k)));
+      return bounds;
+    }
+
+    /* Encodes as many triangles starting at begin as fit into this block and returns their number */
+    template<typename PrimRefT>
+    __forceinline size_t encode(const PrimRefT* prims, size_t begin, size_t end, Scene* scene)
+    {
+      assert(begin < end);
+      const unsigned int geomID = prims[begin].geomID();
+      const TriangleMesh* mesh = scene->get<TriangleMesh>(geomID);
+      const unsigned int int_stride = (unsigned int) mesh->vertices0.getStride()/4;
+
+      unsigned int primIDs[M];
+      unsigned int slots[3*M];
+      unsigned int vertices[3*M];
+      size_t numVertices = 0;
+      unsigned int minPrimID = prims[begin].primID(), maxPrimID = minPrimID;
+
+      size_t num = 0;
+      for (; num<M && begin+num<end; num++)
+      {
+        const PrimRefT& prim = prims[begin+num];
+        if (prim.geomID() != geomID) break;
+        const TriangleMesh::Triangle& tri = mesh->triangle(prim.primID());
+
+        /* add the vertices of the triangle to a copy of the vertex cache */
+        unsigned int tmpVertices[3*M];
+        unsigned int tmpSlots[3];
+        size_t tmpNumVertices = numVertices;
+        for (size_t j=0; j<numVertices; j++) tmpVertices[j] = vertices[j];
+        for (size_t k=0; k<3; k++)
+        {
+          size_t j = 0;
+          while (j<tmpNumVertices && tmpVertices[j] != tri.v[k]) j++;
+          if (j == tmpNumVertices) tmpVertices[tmpNumVertices++] = tri.v[k];
+          tmpSlots[k] = (unsigned int) j;
+        }
+
+        /* stop if the triangle does not fit anymore */
+        const unsigned int tmpMinPrimID = min(minPrimID,prim.primID());
+        const unsigned int tmpMaxPrimID = max(maxPrimID,prim.primID());
+        if (tmpMaxPrimID-tmpMinPrimID > maxPrimIDDelta) break;
+        if (!isCompact(tmpVertices,tmpNumVertices,int_stride) && tmpNumVertices > numWideVertexSlots) break;
+
+        for (size_t j=numVertices; j<tmpNumVertices; j++) vertices[j] = tmpVertices[j];
+        numVertices = tmpNumVertices;
+        for (size_t k=0; k<3; k++) slots[3*num+k] = tmpSlots[k];
+        primIDs[num] = prim.primID();
+        minPrimID = tmpMinPrimID;
+        maxPrimID = tmpMaxPrimID;
+      }
+      assert(num > 0);
+
+      geomID_ = geomID;
+      primIDBase = minPrimID;
+      for (size_t i=0; i<M; i++)
+        primIDDeltas[i] = i<num ? (unsigned char)(primIDs[i]-minPrimID) : 0xFF;
+
+      /* invalid triangles are degenerated to the first vertex */
+      for (size_t i=0; i<3*M/2; i++) vertexIndices[i] = 0;
+      for (size_t n=0; n<3*num; n++) vertexIndices[n>>1] |= (unsigned char)(slots[n] << (4*(n&1)));
+
+      for (size_t j=0; j<numVertexSlots; j++) cache.deltas[j] = 0;
+      if (isCompact(vertices,numVertices,int_stride))
+      {
+        unsigned int minVertex = vertices[0];
+        for (size_t j=1; j<numVertices; j++) minVertex = min(minVertex,vertices[j]);
+        flags = 0;
+        stride = (unsigned char) int_stride;
+        vertexBase = minVertex * int_stride;
+        for (size_t j=0; j<numVertices; j++) cache.deltas[j] = (unsigned short)(vertices[j]-minVertex);
+      }
+      else
+      {
+        flags = FLAG_WIDE;
+        stride = 0;
+        vertexBase = 0;
+        for (size_t j=0; j<numVertices; j++) cache.offsets[j] = vertices[j] * int_stride;
+      }
+      return num;
+    }
+
+    /* Fill triangle from triangle list */
+    template<typename PrimRefT>
+    __forceinline void fill(const PrimRefT* prims, size_t& begin, size_t end, Scene* scene) {
+      begin += encode(prims,begin,end,scene);
+    }
+
+  private:
+
+    /* checks if vertices fit into the compact vertex cache */
+    static __forceinline bool isCompact(const unsigned int* vertices, size_t numVertices, unsigned int int_stride)
+    {
+      if (numVertices > numVertexSlots || int_stride > maxStride) return false;
+      unsigned int lower = vertices[0], upper = vertices[0];
+      for (size_t j=1; j<numVertices; j++) {
+        lower = min(lower,vertices[j]);
+        upper = max(upper,vertices[j]);
+      }
+      return upper-lower <= maxVertexDelta;
+    }
+
+  private:
+    unsigned int geomID_;                     // geometry ID of mesh
+    unsigned int primIDBase;                  // smallest primitive ID of all triangles
+    unsigned int vertexBase;                  // float offset of the base vertex in compact mode
+    unsigned char primIDDeltas[M];            // primitive ID deltas to primIDBase, 0xFF for invalid triangles
+    union {
+      unsigned short deltas[numVertexSlots];  // vertex deltas to the base vertex in compact mode
+      unsigned int offsets[numWideVertexSlots]; // float offsets of the vertices in wide mode
+    } cache;
+    unsigned char vertexIndices[3*M/2];       // 4 bit vertex cache index of each triangle vertex
+    unsigned char stride;                     // vertex stride in floats in compact mode
+    unsigned char flags;
+  };
+
+  template<>
+  __forceinline void TriangleMc<4>::gather(Vec3vf4& p0,
+                                           Vec3vf4& p1,
+                                           Vec3vf4& p2,
+                                           const Scene* const scene) const
+  {
+    const float* vertices = scene->vertices[geomID_];
+    const vfloat4 a0 = vfloat4::loadu(vertices + vertexOffset(0,0));
+    const vfloat4 a1 = vfloat4::loadu(vertices + vertexOffset(1,0));
+    const vfloat4 a2 = vfloat4::loadu(vertices + vertexOffset(2,0));
+    const vfloat4 a3 = vfloat4::loadu(vertices + vertexOffset(3,0));
+    const vfloat4 b0 = vfloat4::loadu(vertices + vertexOffset(0,1));
+    const vfloat4 b1 = vfloat4::loadu(vertices + vertexOffset(1,1));
+    const vfloat4 b2 = vfloat4::loadu(vertices + vertexOffset(2,1));
+    const vfloat4 b3 = vfloat4::loadu(vertices + vertexOffset(3,1));
+    const vfloat4 c0 = vfloat4::loadu(vertices + vertexOffset(0,2));
+    const vfloat4 c1 = vfloat4::loadu(vertices + vertexOffset(1,2));
+    const vfloat4 c2 = vfloat4::loadu(vertices + vertexOffset(2,2));
+    const vfloat4 c3 = vfloat4::loadu(vertices + vertexOffset(3,2));
+    transpose(a0,a1,a2,a3,p0.x,p0.y,p0.z);
+    transpose(b0,b1,b2,b3,p1.x,p1.y,p1.z);
+    transpose(c0,c1,c2,c3,p2.x,p2.y,p2.z);
+  }
+
+  template<int M>
+  typename TriangleMc<M>::Type TriangleMc<M>::type;
+
+  typedef TriangleMc<4> Triangle4c;
+}
@@ -1794,6 +1794,354 @@ namespace embree
     }
   };
 
+  struct AsyncCommitTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    AsyncCommitTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      VerifyScene scene(device,SceneFlags(RTCSceneFlags(sflags.sflags | RTC_SCENE_FLAG_ASYNC_COMMIT),sflags.qflags));
+      AssertNoError(device);
+      size_t numPhi = 10;
+      size_t numVertices = 2*numPhi*(numPhi+1);
+      Vec3fa pos[4] = { Vec3fa(-10,0,-10), Vec3fa(-10,0,+10), Vec3fa(+10,0,-10), Vec3fa(+10,0,+10) };
+      unsigned geomID[4];
+      geomID[0] = scene.addSphere      (sampler,quality,pos[0],1.0f,numPhi).first;
+      geomID[1] = scene.addQuadSphere  (sampler,quality,pos[1],1.0f,numPhi).first;
+      geomID[2] = scene.addSubdivSphere(sampler,quality,pos[2],1.0f,numPhi,4).first;
+      geomID[3] = scene.addSphereHair  (sampler,quality,pos[3],1.0f).first;
+      AssertNoError(device);
+
+      rtcCommitSceneAsync(scene);
+      rtcWaitCommitScene(scene);
+      AssertNoError(device);
+
+      /* each commit moves a different subset of the meshes, thus later commits build into structures older than the traversed ones */
+      for (size_t i=1; i<16; i++)
+      {
+        bool moved[4];
+        for (size_t j=0; j<4; j++)
+        {
+          moved[j] = i & (1 << j);
+          if (!moved[j]) continue;
+          Vec3fa ds(2,0.1f,2,0.0f);
+          UpdateTest::move_mesh(rtcGetGeometry(scene,geomID[j]),j == 3 ? 4 : numVertices,ds);
+          pos[j] += ds;
+        }
+        rtcCommitSceneAsync(scene);
+        AssertNoError(device);
+
+        /* rays traverse the previous structures until the commit finishes, thus moved meshes may get missed meanwhile */
+        for (size_t j=0; j<4; j++)
+        {
+          RTCRayHit ray = makeRay(pos[j]+Vec3fa(0,10,0),Vec3fa(0,-1,0));
+          rtcIntersect1(scene,&context,&ray);
+          if (ray.hit.geomID != geomID[j] && (!moved[j] || ray.hit.geomID != RTC_INVALID_GEOMETRY_ID))
+            return VerifyApplication::FAILED;
+        }
+
+        rtcWaitCommitScene(scene);
+        AssertNoError(device);
+
+        for (size_t j=0; j<4; j++)
+        {
+          RTCRayHit ray = makeRay(pos[j]+Vec3fa(0,10,0),Vec3fa(0,-1,0));
+          rtcIntersect1(scene,&context,&ray);
+          if (ray.hit.geomID != geomID[j])
+            return VerifyApplication::FAILED;
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct AsyncAttachDetachTest : public VerifyApplication::Test
+  {
+    SceneFlags sflags;
+    RTCBuildQuality quality;
+
+    AsyncAttachDetachTest (std::string name, int isa, SceneFlags sflags, RTCBuildQuality quality)
+      : VerifyApplication::Test(name,isa,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags), quality(quality) {}
+
+    struct AttachDetachTask
+    {
+      RTCDevice device;
+      RTCScene scene;
+      Ref<SceneGraph::TriangleMeshNode> mesh;
+      std::atomic<bool> stop;
+      std::atomic<size_t> errorCounter;
+    };
+
+    /* attaches and detaches some mesh outside of the traced area until stopped */
+    static void attachDetachLoop(void* ptr)
+    {
+      AttachDetachTask* task = (AttachDetachTask*) ptr;
+      while (!task->stop)
+      {
+        RTCGeometry geom = rtcNewGeometry(task->device,RTC_GEOMETRY_TYPE_TRIANGLE);
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_INDEX,0,RTC_FORMAT_UINT3,task->mesh->triangles.data(),0,sizeof(SceneGraph::TriangleMeshNode::Triangle),task->mesh->triangles.size());
+        rtcSetSharedGeometryBuffer(geom,RTC_BUFFER_TYPE_VERTEX,0,RTC_FORMAT_FLOAT3,task->mesh->positions[0].data(),0,sizeof(SceneGraph::TriangleMeshNode::Vertex),task->mesh->positions[0].size());
+        rtcCommitGeometry(geom);
+        unsigned int geomID = rtcAttachGeometry(task->scene,geom);
+        rtcReleaseGeometry(geom);
+        if (geomID == RTC_INVALID_GEOMETRY_ID) { task->errorCounter++; continue; }
+        rtcDetachGeometry(task->scene,geomID);
+      }
+    }
+
+    static unsigned int trace(RTCScene scene, const Vec3fa& pos)
+    {
+      RTCIntersectContext context;
+      rtcInitIntersectContext(&context);
+      RTCRayHit ray = makeRay(pos+Vec3fa(0,10,0),Vec3fa(0,-1,0));
+      rtcIntersect1(scene,&context,&ray);
+      return ray.hit.geomID;
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa);
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+
+      AttachDetachTask task;
+      task.mesh = SceneGraph::createTriangleSphere(Vec3fa(0,100,0),1.0f,10).dynamicCast<SceneGraph::TriangleMeshNode>();
+      task.stop = false;
+      task.errorCounter = 0;
+
+      VerifyScene scene(device,SceneFlags(RTCSceneFlags(sflags.sflags | RTC_SCENE_FLAG_ASYNC_COMMIT),sflags.qflags));
+      AssertNoError(device);
+      const size_t N = 8;
+      Vec3fa pos[N], pos2[N];
+      unsigned int geomID[N], geomID2[N];
+      for (size_t i=0; i<N; i++) {
+        pos [i] = Vec3fa(4.0f*i,0,-10);
+        pos2[i] = Vec3fa(4.0f*i,0,+10);
+        geomID[i] = scene.addSphere(sampler,quality,pos[i],1.0f,10).first;
+      }
+      rtcCommitSceneAsync(scene);
+      rtcWaitCommitScene(scene);
+      AssertNoError(device);
+
+      task.device = device;
+      task.scene = scene;
+      thread_t thread = createThread(attachDetachLoop,&task);
+
+      /* detached meshes have to become unreachable immediately, also while a commit is running */
+      bool failed = false;
+      for (size_t i=0; i<N && !failed; i++)
+      {
+        rtcCommitSceneAsync(scene);
+        rtcDetachGeometry(scene,geomID[i]);
+        geomID2[i] = scene.addSphere(sampler,quality,pos2[i],1.0f,10).first;
+
+        for (size_t j=0; j<N; j++)
+          failed |= trace(scene,pos[j]) != (j <= i ? RTC_INVALID_GEOMETRY_ID : geomID[j]);
+
+        rtcWaitCommitScene(scene);
+        rtcCommitSceneAsync(scene);
+        rtcWaitCommitScene(scene);
+
+        for (size_t j=0; j<N; j++)
+          failed |= trace(scene,pos[j]) != (j <= i ? RTC_INVALID_GEOMETRY_ID : geomID[j]);
+        for (size_t j=0; j<=i; j++)
+          failed |= trace(scene,pos2[j]) != geomID2[j];
+      }
+
+      task.stop = true;
+      join(thread);
+      AssertNoError(device);
+      if (failed || task.errorCounter)
+        return VerifyApplication::FAILED;
+
+      /* the BVH of a single mesh is traversed directly */
+      for (size_t i=0; i+1<N; i++)
+        rtcDetachGeometry(scene,geomID2[i]);
+      rtcCommitSceneAsync(scene);
+      rtcWaitCommitScene(scene);
+      if (trace(scene,pos2[N-1]) != geomID2[N-1])
+        return VerifyApplication::FAILED;
+      rtcDetachGeometry(scene,geomID2[N-1]);
+      if (trace(scene,pos2[N-1]) != RTC_INVALID_GEOMETRY_ID)
+        return VerifyApplication::FAILED;
+
+      /* all IDs get released once no ray query can reach their geometries anymore */
+      for (size_t i=0; i<3; i++) {
+        rtcCommitSceneAsync(scene);
+        rtcWaitCommitScene(scene);
+      }
+      if (scene.addSphere(sampler,quality,pos[0],1.0f,10).first != 0)
+        return VerifyApplication::FAILED;
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
+  struct ToplevelRefitTest : public VerifyApplication::IntersectTest
+  {
+    SceneFlags sflags;
+
+    ToplevelRefitTest (std::string name, int isa, SceneFlags sflags, IntersectMode imode, IntersectVariant ivariant)
+      : VerifyApplication::IntersectTest(name,isa,imode,ivariant,VerifyApplication::TEST_SHOULD_PASS), sflags(sflags) {}
+
+    /* axis aligned squares parallel to the xy plane */
+    struct Square { float x, y, z, size; };
+
+    static bool intersectSquare(const Square& sq, const Vec3fa& org, const Vec3fa& dir, float tnear, float tfar, float& t)
+    {
+      t = (sq.z-org.z)/dir.z;
+      if (!(t >= tnear && t <= tfar)) return false;
+      const float x = org.x+t*dir.x, y = org.y+t*dir.y;
+      return x >= sq.x && x <= sq.x+sq.size && y >= sq.y && y <= sq.y+sq.size;
+    }
+
+    static void boundsFunc(const RTCBoundsFunctionArguments* args)
+    {
+      const Square& sq = ((Square*)args->geometryUserPtr)[args->primID];
+      args->bounds_o->lower_x = sq.x;         args->bounds_o->lower_y = sq.y;         args->bounds_o->lower_z = sq.z;
+      args->bounds_o->upper_x = sq.x+sq.size; args->bounds_o->upper_y = sq.y+sq.size; args->bounds_o->upper_z = sq.z;
+    }
+
+    static void intersectFuncN(const RTCIntersectFunctionNArguments* args)
+    {
+      const Square& sq = ((Square*)args->geometryUserPtr)[args->primID];
+      RTCRayN* rays = RTCRayHitN_RayN(args->rayhit,args->N);
+      RTCHitN* hits = RTCRayHitN_HitN(args->rayhit,args->N);
+      for (unsigned int i=0; i<args->N; i++)
+      {
+        if (args->valid[i] != -1) continue;
+        const Vec3fa org(RTCRayN_org_x(rays,args->N,i),RTCRayN_org_y(rays,args->N,i),RTCRayN_org_z(rays,args->N,i));
+        const Vec3fa dir(RTCRayN_dir_x(rays,args->N,i),RTCRayN_dir_y(rays,args->N,i),RTCRayN_dir_z(rays,args->N,i));
+        float t; if (!intersectSquare(sq,org,dir,RTCRayN_tnear(rays,args->N,i),RTCRayN_tfar(rays,args->N,i),t)) continue;
+        RTCRayN_tfar(rays,args->N,i) = t;
+        RTCHitN_Ng_x(hits,args->N,i) = 0.0f;
+        RTCHitN_Ng_y(hits,args->N,i) = 0.0f;
+        RTCHitN_Ng_z(hits,args->N,i) = 1.0f;
+        RTCHitN_u(hits,args->N,i) = 0.0f;
+        RTCHitN_v(hits,args->N,i) = 0.0f;
+        RTCHitN_primID(hits,args->N,i) = args->primID;
+        RTCHitN_geomID(hits,args->N,i) = args->geomID;
+        RTCHitN_instID(hits,args->N,i,0) = args->context->instID[0];
+      }
+    }
+
+    static void occludedFuncN(const RTCOccludedFunctionNArguments* args)
+    {
+      const Square& sq = ((Square*)args->geometryUserPtr)[args->primID];
+      for (unsigned int i=0; i<args->N; i++)
+      {
+        if (args->valid[i] != -1) continue;
+        const Vec3fa org(RTCRayN_org_x(args->ray,args->N,i),RTCRayN_org_y(args->ray,args->N,i),RTCRayN_org_z(args->ray,args->N,i));
+        const Vec3fa dir(RTCRayN_dir_x(args->ray,args->N,i),RTCRayN_dir_y(args->ray,args->N,i),RTCRayN_dir_z(args->ray,args->N,i));
+        float t; if (!intersectSquare(sq,org,dir,RTCRayN_tnear(args->ray,args->N,i),RTCRayN_tfar(args->ray,args->N,i),t)) continue;
+        RTCRayN_tfar(args->ray,args->N,i) = neg_inf;
+      }
+    }
+
+    static void placeSquares(std::vector<Square>& squares, unsigned int geomID, float x, float y)
+    {
+      for (size_t i=0; i<squares.size(); i++) {
+        squares[i].x = x+0.5f*(i%16);
+        squares[i].y = y+0.5f*(i/16);
+        squares[i].z = 0.1f*geomID+0.013f*((7*i+geomID)%5);
+        squares[i].size = 0.45f;
+      }
+    }
+
+    VerifyApplication::TestReturnValue run(VerifyApplication* state, bool silent)
+    {
+      /* the two-level builder refits the toplevel BVH when only some objects changed */
+      std::string cfg = state->rtcore + ",isa="+stringOfISA(isa)+",object_builder=dynamic";
+      RTCDeviceRef device = rtcNewDevice(cfg.c_str());
+      errorHandler(nullptr,rtcGetDeviceError(device));
+      if (!supportsIntersectMode(device,imode))
+        return VerifyApplication::SKIPPED;
+
+      /* overlapping objects get opened into many toplevel leaves */
+      const unsigned int numObjects = 6;
+      std::vector<std::vector<Square>> squares(numObjects,std::vector<Square>(256));
+      std::vector<Vec3fa> pos(numObjects);
+      std::vector<RTCGeometry> geoms(numObjects);
+      VerifyScene scene(device,sflags);
+      for (unsigned int i=0; i<numObjects; i++)
+      {
+        pos[i] = Vec3fa(0.23f*(i%2),0.31f*(i%3),0.0f);
+        placeSquares(squares[i],i,pos[i].x,pos[i].y);
+        RTCGeometry geom = rtcNewGeometry(device,RTC_GEOMETRY_TYPE_USER);
+        rtcSetGeometryUserPrimitiveCount(geom,(unsigned int)squares[i].size());
+        rtcSetGeometryBuildQuality(geom,sflags.qflags);
+        rtcSetGeometryUserData(geom,squares[i].data());
+        rtcSetGeometryBoundsFunction(geom,boundsFunc,nullptr);
+        rtcSetGeometryIntersectFunction(geom,intersectFuncN);
+        rtcSetGeometryOccludedFunction(geom,occludedFuncN);
+        rtcCommitGeometry(geom);
+        rtcAttachGeometryByID(scene,geom,i);
+        rtcReleaseGeometry(geom);
+        geoms[i] = geom;
+      }
+      AssertNoError(device);
+
+      const unsigned int numRays = 256;
+      RTCRayHit rays[numRays];
+      for (size_t frame=0; frame<16; frame++)
+      {
+        /* the first frame traces the fully built BVH, later frames a refitted toplevel BVH */
+        if (frame > 0) {
+          const unsigned int i = random_int()%numObjects;
+          pos[i] += Vec3fa(0.1f*random_float()-0.05f,0.1f*random_float()-0.05f,0.0f);
+          placeSquares(squares[i],i,pos[i].x,pos[i].y);
+          rtcCommitGeometry(geoms[i]);
+        }
+        rtcCommitScene(scene);
+        AssertNoError(device);
+
+        for (size_t j=0; j<4; j++)
+        {
+          /* packets of nearby rays to exercise the packet traversal */
+          const Vec3fa org0(8.5f*random_float(),8.5f*random_float(),-10.0f);
+          for (size_t i=0; i<numRays; i++)
+            rays[i] = makeRay(org0+Vec3fa(0.0013f*i,0.0007f*(i%16),0.0f),Vec3fa(0.001f,0.0f,1.0f));
+          IntersectWithMode(imode,ivariant,scene,rays,numRays);
+
+          for (size_t i=0; i<numRays; i++)
+          {
+            const Vec3fa org = org0+Vec3fa(0.0013f*i,0.0007f*(i%16),0.0f);
+            float tfar = inf; unsigned int geomID = RTC_INVALID_GEOMETRY_ID, primID = RTC_INVALID_GEOMETRY_ID;
+            for (unsigned int g=0; g<numObjects; g++)
+              for (unsigned int p=0; p<squares[g].size(); p++) {
+                float t; if (!intersectSquare(squares[g][p],org,Vec3fa(0.001f,0.0f,1.0f),0.0f,tfar,t)) continue;
+                tfar = t; geomID = g; primID = p;
+              }
+
+            if (ivariant & VARIANT_INTERSECT) {
+              if (rays[i].hit.geomID != geomID || rays[i].hit.primID != primID) return VerifyApplication::FAILED;
+              if (geomID != RTC_INVALID_GEOMETRY_ID && fabs(rays[i].ray.tfar-tfar) > 1E-4f) return VerifyApplication::FAILED;
+            }
+            else if ((rays[i].ray.tfar == float(neg_inf)) != (geomID != RTC_INVALID_GEOMETRY_ID))
+              return VerifyApplication::FAILED;
+          }
+        }
+      }
+      AssertNoError(device);
+
+      return VerifyApplication::PASSED;
+    }
+  };
+
   struct GarbageGeometryTest : public VerifyApplication::Test
   {
     GarbageGeometryTest (std::string name, int isa)
@@ -5326,6 +5674,33 @@ namespace embree
       }
       groups.pop();
 
+      push(new TestGroup("async_commit",true,true));
+      for (auto sflags : sceneFlagsDynamic) {
+        groups.top()->add(new AsyncCommitTest("deformable."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_REFIT));
+        groups.top()->add(new AsyncCommitTest("dynamic."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_LOW));
+      }
+      groups.top()->add(new AsyncCommitTest("static",isa,SceneFlags(RTC_SCENE_FLAG_NONE,RTC_BUILD_QUALITY_MEDIUM),RTC_BUILD_QUALITY_MEDIUM));
+      groups.pop();
+
+      push(new TestGroup("async_attach_detach",true,true));
+      for (auto sflags : sceneFlagsDynamic) {
+        if (sflags.qflags != RTC_BUILD_QUALITY_LOW) continue; // only the two-level BVH of low quality scenes hides meshes in place
+        groups.top()->add(new AsyncAttachDetachTest("deformable."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_REFIT));
+        groups.top()->add(new AsyncAttachDetachTest("dynamic."+to_string(sflags),isa,sflags,RTC_BUILD_QUALITY_LOW));
+      }
+      groups.pop();
+
+      push(new TestGroup("toplevel_refit",true,true));
+      for (auto imode : intersectModes) {
+        for (auto ivariant : intersectVariants) {
+          if (has_variant(imode,ivariant)) {
+            SceneFlags sflags(RTC_SCENE_FLAG_DYNAMIC,RTC_BUILD_QUALITY_LOW);
+            groups.top()->add(new ToplevelRefitTest(to_string(sflags,imode,ivariant),isa,sflags,imode,ivariant));
+          }
+        }
+      }
+      groups.pop();
+
 #if !defined(TASKING_PPL) // FIXME: PPL has some issues here!
       groups.top()->add(new GarbageGeometryTest("build_garbage_geom",isa));
 #endif